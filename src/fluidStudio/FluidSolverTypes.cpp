@@ -1,10 +1,16 @@
 #include "FluidSolverTypes.hpp"
 
 #include "fluidSolver/kernel/CubicSplineKernel.hpp"
+#include "fluidSolver/kernel/Kernel.hpp"
+#include "fluidSolver/kernel/TabulatedCubicSplineKernel3D.hpp"
+#include "fluidSolver/neighborhoodSearch/CompactGridNeighborhoodSearch.hpp"
 #include "fluidSolver/neighborhoodSearch/CompressedNeighbors.hpp"
+#include "fluidSolver/neighborhoodSearch/CsrNeighborhoodSearch3D.hpp"
 #include "fluidSolver/neighborhoodSearch/HashedNeighborhoodSearch.hpp"
 #include "fluidSolver/neighborhoodSearch/HashedNeighborhoodSearch3D.hpp"
+#include "fluidSolver/neighborhoodSearch/VerletNeighborhoodSearch.hpp"
 #include "fluidSolver/neighborhoodSearch/QuadraticNeighborhoodSearchDynamicAllocated.hpp"
+#include "fluidSolver/solver/DFSPHFluidSolver3D.hpp"
 #include "fluidSolver/solver/IISPHFluidSolver.hpp"
 #include "fluidSolver/solver/IISPHFluidSolver3D.hpp"
 #include "fluidSolver/solver/SESPHFluidSolver.hpp"
@@ -52,6 +58,19 @@ void FluidStudio::FluidSolverTypes::add_types()
                          ->settings;
          }});
 
+    types.push_back(
+        {"SESPH", "CompactGridNeighborhoodSearch", "CubicSplineKernel",
+         []() { return std::make_shared<SESPHFluidSolver<CubicSplineKernel, CompactGridNeighborhoodSearch>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const SESPHFluidSolver<CubicSplineKernel, CompactGridNeighborhoodSearch>>(b) != nullptr;
+         },
+         SolverSettingsTypeSESPH,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<SESPHFluidSolver<CubicSplineKernel, CompactGridNeighborhoodSearch>>(b)
+                         ->settings;
+         }});
+
     types.push_back(
         {"IISPH", "QuadraticNeighborhoodSearchDynamicAllocated", "CubicSplineKernel",
          []() {
@@ -83,6 +102,19 @@ void FluidStudio::FluidSolverTypes::add_types()
                          ->settings;
          }});
 
+    types.push_back(
+        {"IISPH", "CompactGridNeighborhoodSearch", "CubicSplineKernel",
+         []() { return std::make_shared<IISPHFluidSolver<CubicSplineKernel, CompactGridNeighborhoodSearch>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const IISPHFluidSolver<CubicSplineKernel, CompactGridNeighborhoodSearch>>(b) != nullptr;
+         },
+         SolverSettingsTypeIISPH,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<IISPHFluidSolver<CubicSplineKernel, CompactGridNeighborhoodSearch>>(b)
+                         ->settings;
+         }});
+
     types.push_back(
         {"SESPH-3D", "QuadraticNeighborhoodSearch3D", "CubicSplineKernel3D",
          []() { return std::make_shared<SESPHFluidSolver3D<CubicSplineKernel3D, QuadraticNeighborhoodSearch3D>>(); },
@@ -123,6 +155,37 @@ void FluidStudio::FluidSolverTypes::add_types()
                          ->settings;
          }});
 
+    types.push_back(
+        {"SESPH-3D", "CsrNeighborhoodSearch3D", "CubicSplineKernel3D",
+         []() { return std::make_shared<SESPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const SESPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeSESPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<SESPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"SESPH-3D", "VerletHashedNeighborhoodSearch3D", "CubicSplineKernel3D",
+         []() { return std::make_shared<SESPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const SESPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(b) != nullptr;
+         },
+         SolverSettingsTypeSESPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<SESPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(
+                         b)
+                         ->settings;
+         },
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<SESPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(b)
+                         ->neighborhood_search.skin_factor;
+         }});
+
     types.push_back(
         {"IISPH-3D", "QuadraticNeighborhoodSearch3D", "CubicSplineKernel3D",
          []() { return std::make_shared<IISPHFluidSolver3D<CubicSplineKernel3D, QuadraticNeighborhoodSearch3D>>(); },
@@ -162,6 +225,225 @@ void FluidStudio::FluidSolverTypes::add_types()
              return &std::dynamic_pointer_cast<IISPHFluidSolver3D<CubicSplineKernel3D, CompressedNeighborhoodSearch>>(b)
                          ->settings;
          }});
+
+    types.push_back(
+        {"IISPH-3D", "CsrNeighborhoodSearch3D", "CubicSplineKernel3D",
+         []() { return std::make_shared<IISPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const IISPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeIISPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<IISPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"IISPH-3D", "VerletHashedNeighborhoodSearch3D", "CubicSplineKernel3D",
+         []() { return std::make_shared<IISPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const IISPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(b) != nullptr;
+         },
+         SolverSettingsTypeIISPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<IISPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(
+                         b)
+                         ->settings;
+         },
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<IISPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(b)
+                         ->neighborhood_search.skin_factor;
+         }});
+
+    types.push_back(
+        {"DFSPH-3D", "QuadraticNeighborhoodSearch3D", "CubicSplineKernel3D",
+         []() { return std::make_shared<DFSPHFluidSolver3D<CubicSplineKernel3D, QuadraticNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const DFSPHFluidSolver3D<CubicSplineKernel3D, QuadraticNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeDFSPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, QuadraticNeighborhoodSearch3D>>(
+                         b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"DFSPH-3D", "HashedNeighborhoodSearch3D", "CubicSplineKernel3D",
+         []() { return std::make_shared<DFSPHFluidSolver3D<CubicSplineKernel3D, HashedNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const DFSPHFluidSolver3D<CubicSplineKernel3D, HashedNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeDFSPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, HashedNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"DFSPH-3D", "CompressedNeighborhoodSearch", "CubicSplineKernel3D",
+         []() { return std::make_shared<DFSPHFluidSolver3D<CubicSplineKernel3D, CompressedNeighborhoodSearch>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const DFSPHFluidSolver3D<CubicSplineKernel3D, CompressedNeighborhoodSearch>>(b) != nullptr;
+         },
+         SolverSettingsTypeDFSPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, CompressedNeighborhoodSearch>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"DFSPH-3D", "CsrNeighborhoodSearch3D", "CubicSplineKernel3D",
+         []() { return std::make_shared<DFSPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const DFSPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeDFSPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"DFSPH-3D", "VerletHashedNeighborhoodSearch3D", "CubicSplineKernel3D",
+         []() { return std::make_shared<DFSPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const DFSPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(b) != nullptr;
+         },
+         SolverSettingsTypeDFSPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(
+                         b)
+                         ->settings;
+         },
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(b)
+                         ->neighborhood_search.skin_factor;
+         }});
+
+    types.push_back(
+        {"SESPH-3D", "HashedNeighborhoodSearch3D", "TabulatedCubicSplineKernel3D",
+         []() { return std::make_shared<SESPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const SESPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeSESPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<SESPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"IISPH-3D", "HashedNeighborhoodSearch3D", "TabulatedCubicSplineKernel3D",
+         []() { return std::make_shared<IISPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const IISPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeIISPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<IISPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"DFSPH-3D", "HashedNeighborhoodSearch3D", "TabulatedCubicSplineKernel3D",
+         []() { return std::make_shared<DFSPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const DFSPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeDFSPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<DFSPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"SESPH-3D", "HashedNeighborhoodSearch3D", "WendlandC2Kernel3D",
+         []() { return std::make_shared<SESPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const SESPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeSESPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<SESPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"IISPH-3D", "HashedNeighborhoodSearch3D", "WendlandC2Kernel3D",
+         []() { return std::make_shared<IISPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const IISPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeIISPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<IISPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"DFSPH-3D", "HashedNeighborhoodSearch3D", "WendlandC2Kernel3D",
+         []() { return std::make_shared<DFSPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const DFSPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeDFSPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<DFSPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"SESPH-3D", "HashedNeighborhoodSearch3D", "WendlandC4Kernel3D",
+         []() { return std::make_shared<SESPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const SESPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeSESPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<SESPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"IISPH-3D", "HashedNeighborhoodSearch3D", "WendlandC4Kernel3D",
+         []() { return std::make_shared<IISPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const IISPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeIISPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<IISPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
+
+    types.push_back(
+        {"DFSPH-3D", "HashedNeighborhoodSearch3D", "WendlandC4Kernel3D",
+         []() { return std::make_shared<DFSPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(); },
+         [](const std::shared_ptr<IFluidSolverBase>& b) {
+             return std::dynamic_pointer_cast<
+                        const DFSPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(b) != nullptr;
+         },
+         SolverSettingsTypeDFSPH3D,
+         [](std::shared_ptr<IFluidSolverBase> b) {
+             return &std::dynamic_pointer_cast<DFSPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(b)
+                         ->settings;
+         }});
 }
 
 const FluidStudio::FluidSolverTypes::FluidSolverType* FluidStudio::FluidSolverTypes::query_type(
@@ -14,7 +14,8 @@ namespace FluidStudio {
             SolverSettingsTypeIISPH,
             SolverSettingsTypeSESPH,
             SolverSettingsTypeSESPH3D,
-            SolverSettingsTypeIISPH3D
+            SolverSettingsTypeIISPH3D,
+            SolverSettingsTypeDFSPH3D
         };
 
         struct FluidSolverType {
@@ -28,6 +29,9 @@ namespace FluidStudio {
 
             SolverSettingsType settings_type;
             std::function<void*(std::shared_ptr<LibFluid::IFluidSolverBase>)> get_settings;
+
+            // only set for the types using a verlet neighborhood search
+            std::function<float*(std::shared_ptr<LibFluid::IFluidSolverBase>)> get_skin_factor;
         };
 
         struct FluidSolverTypeQuery {
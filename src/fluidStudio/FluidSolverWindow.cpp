@@ -168,10 +168,8 @@ namespace FluidStudio {
         simulator_visualizer_bundle.simulator = std::make_shared<LibFluid::Simulator>();
 
         simulator_visualizer_bundle.simulator->data.collection = std::make_shared<LibFluid::ParticleCollection>();
-        simulator_visualizer_bundle.simulator->data.collection->add_type<LibFluid::MovementData>();
-        simulator_visualizer_bundle.simulator->data.collection->add_type<LibFluid::ParticleData>();
-        simulator_visualizer_bundle.simulator->data.collection->add_type<LibFluid::ParticleInfo>();
-        simulator_visualizer_bundle.simulator->data.collection->add_type<LibFluid::ExternalForces>();
+        simulator_visualizer_bundle.simulator->data.collection
+                ->add_types<LibFluid::MovementData, LibFluid::ParticleData, LibFluid::ParticleInfo, LibFluid::ExternalForces>();
         simulator_visualizer_bundle.simulator->parameters.rest_density = rest_density;
         simulator_visualizer_bundle.simulator->parameters.particle_size = particle_size;
         simulator_visualizer_bundle.simulator->parameters.gravity = 9.81f;
@@ -195,10 +193,8 @@ namespace FluidStudio {
         simulator_visualizer_bundle.simulator = std::make_shared<LibFluid::Simulator>();
 
         simulator_visualizer_bundle.simulator->data.collection = std::make_shared<LibFluid::ParticleCollection>();
-        simulator_visualizer_bundle.simulator->data.collection->add_type<LibFluid::MovementData3D>();
-        simulator_visualizer_bundle.simulator->data.collection->add_type<LibFluid::ParticleData>();
-        simulator_visualizer_bundle.simulator->data.collection->add_type<LibFluid::ParticleInfo>();
-        simulator_visualizer_bundle.simulator->data.collection->add_type<LibFluid::ExternalForces3D>();
+        simulator_visualizer_bundle.simulator->data.collection
+                ->add_types<LibFluid::MovementData3D, LibFluid::ParticleData, LibFluid::ParticleInfo, LibFluid::ExternalForces3D>();
         simulator_visualizer_bundle.simulator->parameters.rest_density = rest_density;
         simulator_visualizer_bundle.simulator->parameters.particle_size = particle_size;
         simulator_visualizer_bundle.simulator->parameters.gravity = 9.81f;
@@ -1,6 +1,7 @@
 #include "StyledImGuiElements.hpp"
 
 #include "ImguiHelper.hpp"
+#include "userInterface/helpers/TypeInformationProvider.hpp"
 
 namespace FluidStudio::StyledImGuiElements {
 
@@ -19,5 +20,20 @@ namespace FluidStudio::StyledImGuiElements {
         return open;
     }
 
+    bool kernel_type_combo(const char* label, LibFluid::KernelType& type) {
+        bool changed = false;
+        if (ImGui::BeginCombo(label, TypeInformationProvider::kernel_type_to_string(type))) {
+            for (auto option : {LibFluid::KernelType::CubicSpline, LibFluid::KernelType::WendlandC2,
+                         LibFluid::KernelType::WendlandC4}) {
+                if (ImGui::Selectable(TypeInformationProvider::kernel_type_to_string(option), type == option)) {
+                    changed = type != option;
+                    type = option;
+                }
+            }
+            ImGui::EndCombo();
+        }
+        return changed;
+    }
+
 
 } // namespace FluidStudio::StyledImGuiElements
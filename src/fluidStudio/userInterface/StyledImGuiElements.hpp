@@ -1,7 +1,11 @@
 #pragma once
 
+#include "fluidSolver/kernel/Kernel.hpp"
+
 namespace FluidStudio::StyledImGuiElements {
 
     bool slim_tree_node(const char* name, void* ptr_id = nullptr);
 
+    bool kernel_type_combo(const char* label, LibFluid::KernelType& type);
+
 }
@@ -64,6 +64,8 @@ namespace FluidStudio {
         FLUID_ASSERT(ent != nullptr);
 
         if (StyledImGuiElements::slim_tree_node("Parameters")) {
+            StyledImGuiElements::kernel_type_combo("Kernel", ent->kernel.type);
+
             ImGui::TreePop();
         }
     }
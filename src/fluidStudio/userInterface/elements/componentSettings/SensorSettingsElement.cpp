@@ -103,6 +103,8 @@ namespace FluidStudio {
                 }
             }
 
+            StyledImGuiElements::kernel_type_combo("Kernel", sen->settings.kernel_type);
+
             ImGui::TreePop();
         }
 
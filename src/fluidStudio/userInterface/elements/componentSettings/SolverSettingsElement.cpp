@@ -1,6 +1,7 @@
 #include "SolverSettingsElement.hpp"
 
 #include "ImguiHelper.hpp"
+#include "fluidSolver/solver/DFSPHFluidSolver3D.hpp"
 #include "fluidSolver/solver/IISPHFluidSolver.hpp"
 #include "fluidSolver/solver/IISPHFluidSolver3D.hpp"
 #include "fluidSolver/solver/SESPHFluidSolver.hpp"
@@ -74,6 +75,18 @@ namespace FluidStudio {
                 ImGui::EndCombo();
             }
 
+            if (ui_data.window().current_type->get_skin_factor) {
+                auto& solver = ui_data.window().simulator_visualizer_bundle.simulator->data.fluid_solver;
+                float* skin_factor = ui_data.window().current_type->get_skin_factor(solver);
+
+                // the neighborhood search has to be initialized again with the new skin
+                float value = *skin_factor;
+                if (ImGui::InputFloat("Skin Factor", &value) && can_change) {
+                    *skin_factor = value;
+                    solver->parameters.notify_that_data_changed();
+                }
+            }
+
             if (!can_change) {
                 ImGui::TextColored(ImColor(0.8f, 0.1f, 0.1f), "Config change not possible");
                 ImGui::TextWrapped("Since you are running the simulation in asynchronous mode, you cannot change the "
@@ -157,6 +170,13 @@ namespace FluidStudio {
                         v->notify_that_data_changed();
                     }
                 }
+                ImGui::Separator();
+                if (ImGui::Checkbox("Pairwise Forces", &v->pairwise_force_computation)) {
+                    v->notify_that_data_changed();
+                }
+                if (ImGui::Checkbox("Vectorized Density", &v->vectorized_density_computation)) {
+                    v->notify_that_data_changed();
+                }
                 ImGui::TreePop();
             }
         }
@@ -199,6 +219,63 @@ namespace FluidStudio {
                     }
                     // TODO: eventually gamma should be in here
                 }
+
+                ImGui::Separator();
+                if (ImGui::Checkbox("Warm Start Pressure", &v->warm_start_pressure)) {
+                    v->notify_that_data_changed();
+                }
+
+                if (v->warm_start_pressure) {
+                    if (ImGui::InputFloat("Pressure Factor", &v->warm_start_pressure_factor)) {
+                        v->notify_that_data_changed();
+                    }
+                }
+
+                ImGui::Separator();
+                if (ImGui::Checkbox("Vectorized Density", &v->vectorized_density_computation)) {
+                    v->notify_that_data_changed();
+                }
+                ImGui::TreePop();
+            }
+        }
+
+        if (ui_data.window().current_type->settings_type == FluidSolverTypes::SolverSettingsTypeDFSPH3D) {
+            if (StyledImGuiElements::slim_tree_node("3D DFSPH")) {
+                update_solver_parameters();
+                ImGui::Separator();
+
+                auto v = (LibFluid::DFSPHSettings3D*)ui_data.window().current_type->get_settings(
+                        ui_data.window().simulator_visualizer_bundle.simulator->data.fluid_solver);
+
+                if (ImGui::InputFloat("Viscosity", &v->viscosity)) {
+                    v->notify_that_data_changed();
+                }
+                if (ImGui::InputFloat("Max. Density Err.", &v->max_density_error_allowed)) {
+                    v->notify_that_data_changed();
+                }
+                if (ImGui::InputInt("Min. Iterations", (int*)&v->min_number_of_iterations)) {
+                    v->notify_that_data_changed();
+                }
+                if (ImGui::InputInt("Max. Iterations", (int*)&v->max_number_of_iterations)) {
+                    v->notify_that_data_changed();
+                }
+
+                ImGui::Separator();
+                if (ImGui::Checkbox("Divergence Solve", &v->divergence_solve)) {
+                    v->notify_that_data_changed();
+                }
+
+                if (v->divergence_solve) {
+                    if (ImGui::InputFloat("Max. Divergence Err.", &v->max_divergence_error_allowed)) {
+                        v->notify_that_data_changed();
+                    }
+                    if (ImGui::InputInt("Min. Div. Iterations", (int*)&v->min_number_of_divergence_iterations)) {
+                        v->notify_that_data_changed();
+                    }
+                    if (ImGui::InputInt("Max. Div. Iterations", (int*)&v->max_number_of_divergence_iterations)) {
+                        v->notify_that_data_changed();
+                    }
+                }
                 ImGui::TreePop();
             }
         }
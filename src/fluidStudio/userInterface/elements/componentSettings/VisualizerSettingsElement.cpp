@@ -349,6 +349,7 @@ namespace FluidStudio {
 
         if (StyledImGuiElements::slim_tree_node("Surface Properties")) {
             ImGui::InputFloat("Fraction of Rest Density", &rt->accelerator.surface_density_as_fraction_of_rest_density);
+            StyledImGuiElements::kernel_type_combo("Kernel", rt->accelerator.kernel_type);
 
             ImGui::TreePop();
         }
@@ -457,6 +458,7 @@ namespace FluidStudio {
 
         if (StyledImGuiElements::slim_tree_node("Surface Properties")) {
             ImGui::InputFloat("Fraction of Rest Density", &rt->accelerator.surface_density_as_fraction_of_rest_density);
+            StyledImGuiElements::kernel_type_combo("Kernel", rt->accelerator.kernel_type);
 
             ImGui::TreePop();
         }
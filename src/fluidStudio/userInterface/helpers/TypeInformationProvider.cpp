@@ -70,4 +70,17 @@ namespace FluidStudio::TypeInformationProvider {
                 return "Unknown";
         }
     }
+
+    const char* kernel_type_to_string(LibFluid::KernelType type) {
+        switch (type) {
+            case LibFluid::KernelType::CubicSpline:
+                return "Cubic Spline";
+            case LibFluid::KernelType::WendlandC2:
+                return "Wendland C2";
+            case LibFluid::KernelType::WendlandC4:
+                return "Wendland C4";
+            default:
+                return "Unknown";
+        }
+    }
 } // namespace FluidStudio::TypeInformationProvider
\ No newline at end of file
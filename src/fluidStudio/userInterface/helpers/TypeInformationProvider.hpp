@@ -1,6 +1,7 @@
 #pragma once
 
 #include "entities/SimulationEntity.hpp"
+#include "fluidSolver/kernel/Kernel.hpp"
 #include "sensors/Sensor.hpp"
 
 namespace FluidStudio::TypeInformationProvider {
@@ -13,5 +14,7 @@ namespace FluidStudio::TypeInformationProvider {
 
     const char* particle_type_to_string(LibFluid::ParticleType type);
 
+    const char* kernel_type_to_string(LibFluid::KernelType type);
+
 
 } // namespace FluidStudio::TypeInformationProvider
\ No newline at end of file
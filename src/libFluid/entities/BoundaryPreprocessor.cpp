@@ -19,6 +19,10 @@ namespace LibFluid {
         FLUID_ASSERT(collection->is_type_present<ParticleInfo>());
         FLUID_ASSERT(collection->is_type_present<ParticleData>());
 
+        if (!boundary_change_detector.update(*collection)) {
+            return; // the masses of the boundary particles are still up to date
+        }
+
         for (size_t i = 0; i < collection->size(); i++) {
             const auto& info = collection->get<ParticleInfo>(i);
             if (info.type != ParticleType::ParticleTypeBoundary) {
@@ -29,18 +33,17 @@ namespace LibFluid {
             const auto& mv = collection->get<MovementData3D>(i);
             float volume_reciprocal = 0.0f;
 
-            auto neighbors = interface->get_neighbors(i);
-            for (const auto& neighbor : neighbors) {
+            interface->for_each_neighbor(i, [&](size_t neighbor) {
                 const auto& neighbor_info = collection->get<ParticleInfo>(neighbor);
                 if (neighbor_info.type != ParticleType::ParticleTypeBoundary) {
-                    continue;
+                    return;
                 }
 
                 const auto& neighbor_data = collection->get<ParticleData>(neighbor);
                 const auto& neighbor_mv = collection->get<MovementData3D>(neighbor);
 
                 volume_reciprocal += kernel.GetKernelValue(neighbor_mv.position, mv.position);
-            }
+            });
 
             float corrected_mass = simulation_data.rest_density * gamma_1 / volume_reciprocal;
             data.mass = Math::min(max_allowed_mass, corrected_mass);
@@ -51,15 +54,18 @@ namespace LibFluid {
         if (settings.has_data_changed()) {
             settings.acknowledge_data_change();
         }
-        if (simulation_data.has_data_changed()) {
+        if (simulation_data.has_data_changed() || kernel.type != calculated_with_kernel_type) {
             simulation_data.acknowledge_data_change();
 
             kernel.kernel_support = simulation_data.particle_size * Math::kernel_support_factor;
             kernel.initialize();
+            calculated_with_kernel_type = kernel.type;
 
             ideal_volume_reciprocal = calculate_ideal_volume_reciprocal();
             gamma_1 = calculate_gamma_1_from_ideal_volume_reciprocal();
             max_allowed_mass = calculate_max_allowed_mass();
+
+            boundary_change_detector.invalidate();
         }
     }
 
@@ -1,7 +1,8 @@
 #pragma once
 
 #include "SimulationEntity.hpp"
-#include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
+#include "fluidSolver/BoundaryChangeDetector.hpp"
+#include "fluidSolver/kernel/SelectableKernel3D.hpp"
 
 namespace LibFluid {
     class BoundaryPreprocessor final : public SimulationEntity {
@@ -10,7 +11,7 @@ namespace LibFluid {
 
 
 
-        CubicSplineKernel3D kernel;
+        SelectableKernel3D kernel;
 
         void execute_simulation_step(const Timepoint& timepoint, bool before_solver) override;
         void initialize() override;
@@ -21,6 +22,12 @@ namespace LibFluid {
         float gamma_1 = 0.0f;
         float max_allowed_mass = 0.0f;
 
+        // kernel type the values above were calculated with
+        KernelType calculated_with_kernel_type = KernelType::CubicSpline;
+
+        // the masses only depend on the boundary particles, hence they are only recomputed if those changed
+        BoundaryChangeDetector boundary_change_detector;
+
         float calculate_ideal_volume_reciprocal() const;
         float calculate_gamma_1_from_ideal_volume_reciprocal() const;
         float calculate_max_allowed_mass() const;
@@ -96,17 +96,17 @@ namespace LibFluid {
 
         float min_distance_squared = (simulation_data.particle_size * epsilon) * (simulation_data.particle_size * epsilon);
 
-        auto neighbors = simulation_data.neighborhood_interface->get_neighbors(position);
-        for (auto& neighbor : neighbors) {
+        // stop at the first particle that is too close
+        bool position_free = true;
+        simulation_data.neighborhood_interface->for_each_neighbor(position, [&](size_t neighbor) {
             auto& neighbor_pos = simulation_data.collection->get<MovementData>(neighbor).position;
             glm::vec2 diff = neighbor_pos - position;
             float distance_squared = glm::dot(diff, diff);
-            if (distance_squared < min_distance_squared) {
-                return false;
-            }
-        }
+            position_free = distance_squared >= min_distance_squared;
+            return position_free;
+        });
 
-        return true;
+        return position_free;
     }
     void ParticleSpawner::initialize() {
         if (simulation_data.has_data_changed()) {
@@ -0,0 +1,37 @@
+#include "BoundaryChangeDetector.hpp"
+
+#include "LibFluidAssert.hpp"
+
+namespace LibFluid {
+
+    bool BoundaryChangeDetector::update(const ParticleCollection& collection) {
+        FLUID_ASSERT(collection.is_type_present<ParticleInfo>());
+        FLUID_ASSERT(collection.is_type_present<MovementData3D>());
+
+        bool changed = !valid || is_boundary.size() != collection.size();
+        is_boundary.resize(collection.size());
+        positions.resize(collection.size());
+
+        const ParticleInfo* infos = collection.column<ParticleInfo>();
+        const MovementData3D* movement = collection.column<MovementData3D>();
+        for (size_t i = 0; i < collection.size(); i++) {
+            bool boundary = infos[i].type == ParticleTypeBoundary;
+            if (boundary != (is_boundary[i] != 0) || (boundary && movement[i].position != positions[i])) {
+                changed = true;
+            }
+
+            is_boundary[i] = boundary;
+            if (boundary) {
+                positions[i] = movement[i].position;
+            }
+        }
+
+        valid = true;
+        return changed;
+    }
+
+    void BoundaryChangeDetector::invalidate() {
+        valid = false;
+    }
+
+} // namespace LibFluid
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ParticleCollection.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace LibFluid {
+
+    /**
+     * @brief Detects whether the boundary particles of a 3D collection changed between two calls.
+     *
+     * Boundary particles usually do not move, hence data that only depends on them can be kept until a boundary
+     * particle is added, removed or moved, or until it changes its index because the collection was sorted.
+     */
+    class BoundaryChangeDetector {
+      public:
+        /**
+         * @brief Returns true if the boundary particles differ from the ones of the last call.
+         *
+         * The first call and the first call after invalidate always report a change. The current boundary
+         * particles are stored for the next call.
+         */
+        bool update(const ParticleCollection& collection);
+
+        void invalidate();
+
+      private:
+        bool valid = false;
+
+        // state of each particle at the last call, the positions are only stored for boundary particles
+        std::vector<uint8_t> is_boundary;
+        std::vector<glm::vec3> positions;
+    };
+
+} // namespace LibFluid
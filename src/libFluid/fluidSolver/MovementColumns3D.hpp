@@ -0,0 +1,139 @@
+#pragma once
+
+#include "ParticleCollection.hpp"
+#include "fluidSolver/kernel/BatchedCubicSplineKernel3D.hpp"
+
+#include <glm/glm.hpp>
+
+namespace LibFluid {
+
+    /**
+     * @brief Reads positions and velocities directly from the MovementData3D components.
+     */
+    class MovementDataAccessor3D {
+      public:
+        explicit MovementDataAccessor3D(ParticleCollection* collection)
+            : collection(collection) {
+        }
+
+        glm::vec3 position(size_t i) const {
+            return collection->get<MovementData3D>(i).position;
+        }
+
+        glm::vec3 velocity(size_t i) const {
+            return collection->get<MovementData3D>(i).velocity;
+        }
+
+        /**
+         * @brief Returns the positions for the batched kernel, the coordinates of consecutive particles are
+         * sizeof(MovementData3D) bytes apart. The collection must not be empty.
+         */
+        BatchedCubicSplineKernel3D::Positions batched_positions() const {
+            static_assert(sizeof(MovementData3D) % sizeof(float) == 0, "MovementData3D has to consist of floats!");
+            const MovementData3D* movement_column = collection->column<MovementData3D>();
+            return {&movement_column->position.x, &movement_column->position.y, &movement_column->position.z,
+                    sizeof(MovementData3D) / sizeof(float)};
+        }
+
+      private:
+        ParticleCollection* collection;
+    };
+
+    /**
+     * @brief Reads positions and velocities from the PositionColumn3D and VelocityColumn3D structure of arrays
+     * columns.
+     *
+     * Loops that only require positions or velocities only stream the coordinates they need instead of the
+     * whole MovementData3D structs. The columns are opt-in: they are used by the solvers if they were added to the
+     * collection with add_columns and are updated from the MovementData3D components with update.
+     */
+    class MovementColumns3D {
+      public:
+        static void add_columns(ParticleCollection& collection) {
+            collection.add_types<PositionColumn3D<0>, PositionColumn3D<1>, PositionColumn3D<2>, VelocityColumn3D<0>,
+                    VelocityColumn3D<1>, VelocityColumn3D<2>>();
+        }
+
+        static bool are_columns_present(const ParticleCollection& collection) {
+            return collection.is_type_present<PositionColumn3D<0>>() && collection.is_type_present<PositionColumn3D<1>>() &&
+                    collection.is_type_present<PositionColumn3D<2>>() && collection.is_type_present<VelocityColumn3D<0>>() &&
+                    collection.is_type_present<VelocityColumn3D<1>>() && collection.is_type_present<VelocityColumn3D<2>>();
+        }
+
+        /**
+         * @brief Copies the positions and velocities of the MovementData3D components into the columns and returns
+         * an accessor to them.
+         */
+        template<typename parallel>
+        static MovementColumns3D update(ParticleCollection& collection) {
+            FLUID_ASSERT(collection.is_type_present<MovementData3D>());
+            FLUID_ASSERT(are_columns_present(collection));
+
+            MovementColumns3D columns(collection);
+            const MovementData3D* movement_data = collection.column<MovementData3D>();
+            float* px = columns.position_x;
+            float* py = columns.position_y;
+            float* pz = columns.position_z;
+            float* vx = columns.velocity_x;
+            float* vy = columns.velocity_y;
+            float* vz = columns.velocity_z;
+
+            parallel::loop_for_range(0, collection.size(), [=](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    px[i] = movement_data[i].position.x;
+                    py[i] = movement_data[i].position.y;
+                    pz[i] = movement_data[i].position.z;
+                    vx[i] = movement_data[i].velocity.x;
+                    vy[i] = movement_data[i].velocity.y;
+                    vz[i] = movement_data[i].velocity.z;
+                }
+            });
+
+            return columns;
+        }
+
+        /**
+         * @brief Calls fn with the updated columns if they are present in the collection, otherwise with an accessor
+         * to the MovementData3D components.
+         *
+         * The accessor is only valid until the positions or velocities of the MovementData3D components change.
+         */
+        template<typename parallel, typename Fn>
+        static void visit(ParticleCollection& collection, Fn&& fn) {
+            if (are_columns_present(collection)) {
+                fn(update<parallel>(collection));
+            } else {
+                fn(MovementDataAccessor3D(&collection));
+            }
+        }
+
+        explicit MovementColumns3D(ParticleCollection& collection)
+            : position_x(reinterpret_cast<float*>(collection.column<PositionColumn3D<0>>())),
+              position_y(reinterpret_cast<float*>(collection.column<PositionColumn3D<1>>())),
+              position_z(reinterpret_cast<float*>(collection.column<PositionColumn3D<2>>())),
+              velocity_x(reinterpret_cast<float*>(collection.column<VelocityColumn3D<0>>())),
+              velocity_y(reinterpret_cast<float*>(collection.column<VelocityColumn3D<1>>())),
+              velocity_z(reinterpret_cast<float*>(collection.column<VelocityColumn3D<2>>())) {
+        }
+
+        glm::vec3 position(size_t i) const {
+            return glm::vec3(position_x[i], position_y[i], position_z[i]);
+        }
+
+        glm::vec3 velocity(size_t i) const {
+            return glm::vec3(velocity_x[i], velocity_y[i], velocity_z[i]);
+        }
+
+        BatchedCubicSplineKernel3D::Positions batched_positions() const {
+            return {position_x, position_y, position_z, 1};
+        }
+
+        float* position_x;
+        float* position_y;
+        float* position_z;
+        float* velocity_x;
+        float* velocity_y;
+        float* velocity_z;
+    };
+
+} // namespace LibFluid
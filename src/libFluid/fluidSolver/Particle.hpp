@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 
+#include <cstddef>
+
 namespace LibFluid {
 
     enum ParticleType
@@ -49,4 +51,16 @@ namespace LibFluid {
         glm::vec3 non_pressure_acceleration;
     };
 
+    // Single coordinates of MovementData3D, stored as separate columns of the ParticleCollection (structure of arrays).
+    // Axis 0, 1 and 2 correspond to x, y and z.
+    template <size_t Axis> struct PositionColumn3D
+    {
+        float value;
+    };
+
+    template <size_t Axis> struct VelocityColumn3D
+    {
+        float value;
+    };
+
 } // namespace FluidSolver
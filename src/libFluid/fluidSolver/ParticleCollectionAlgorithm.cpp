@@ -2,9 +2,48 @@
 
 #include "LibFluidAssert.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace LibFluid {
     namespace ParticleCollectionAlgorithm
     {
+        namespace
+        {
+            /**
+             * Stable insertion sort of the keys that applies the same moves to the permutation. Gives up and returns
+             * false as soon as more than max_moves elements had to be moved, the keys and permutation are still
+             * consistent and stable in that case.
+             */
+            bool insertion_sort_with_limit(std::vector<uint64_t>& keys, std::vector<uint32_t>& permutation,
+                                           size_t max_moves)
+            {
+                size_t moves = 0;
+                for (size_t i = 1; i < keys.size(); i++)
+                {
+                    uint64_t key = keys[i];
+                    if (keys[i - 1] <= key)
+                        continue;
+
+                    uint32_t index = permutation[i];
+                    size_t j = i;
+                    while (j > 0 && keys[j - 1] > key)
+                    {
+                        keys[j] = keys[j - 1];
+                        permutation[j] = permutation[j - 1];
+                        j--;
+                    }
+                    keys[j] = key;
+                    permutation[j] = index;
+
+                    moves += i - j;
+                    if (moves > max_moves)
+                        return false;
+                }
+                return true;
+            }
+        } // namespace
+
         void Sort::adapt_collection(std::shared_ptr<ParticleCollection> collection)
         {
             if (!collection->is_type_present<SortInfo>())
@@ -88,6 +127,119 @@ namespace LibFluid {
         }
 
 
+        void Sort::radix_sort(std::shared_ptr<ParticleCollection> collection, const key_function_t& key)
+        {
+            using parallel = StdParallelForEach;
+
+            std::vector<uint64_t> keys(collection->size());
+            parallel::loop_for(0, keys.size(), [&](size_t i) { keys[i] = key(collection, i); });
+
+            auto permutation = radix_sort_permutation(keys);
+
+            size_t moved_particles = parallel::reduce(
+                0, permutation.size(), size_t(0), [&](size_t i) -> size_t { return permutation[i] != i ? 1 : 0; },
+                [](size_t a, size_t b) { return a + b; });
+            if (moved_particles > 0)
+            {
+                collection->reorder(permutation);
+            }
+        }
+
+        std::vector<uint32_t> Sort::radix_sort_permutation(const std::vector<uint64_t>& keys)
+        {
+            using parallel = StdParallelForEach;
+
+            constexpr size_t digit_bits = 8;
+            constexpr size_t bucket_count = size_t(1) << digit_bits;
+            constexpr uint64_t digit_mask = bucket_count - 1;
+
+            FLUID_ASSERT(keys.size() <= std::numeric_limits<uint32_t>::max());
+            const size_t size = keys.size();
+
+            std::vector<uint32_t> permutation(size);
+            parallel::loop_for(0, size, [&](size_t i) { permutation[i] = i; });
+            if (size <= 1)
+                return permutation;
+
+            // keys of particles that moved little since the last sort are nearly sorted, detect this by counting
+            // the positions where the order is violated
+            size_t descents = parallel::reduce(
+                1, size, size_t(0), [&](size_t i) -> size_t { return keys[i] < keys[i - 1] ? 1 : 0; },
+                [](size_t a, size_t b) { return a + b; });
+            if (descents == 0)
+                return permutation;
+
+            std::vector<uint64_t> sorted_keys(keys);
+
+            // nearly sorted keys are fixed up by an insertion sort, which is aborted if the keys turn out to be
+            // further away from their sorted position than expected
+            constexpr size_t nearly_sorted_descent_ratio = 64;
+            if (descents <= size / nearly_sorted_descent_ratio &&
+                insertion_sort_with_limit(sorted_keys, permutation, size))
+            {
+                return permutation;
+            }
+
+            // digits that are equal for all keys do not change the order, their passes are skipped
+            uint64_t varying_bits = parallel::reduce(
+                0, size, uint64_t(0), [&](size_t i) { return keys[i] ^ keys[0]; },
+                [](uint64_t a, uint64_t b) { return a | b; });
+
+            std::vector<uint64_t> key_buffer(size);
+            std::vector<uint32_t> permutation_buffer(size);
+
+            // loop_for_range splits the indices into ranges of grain_size, each range counts and scatters its
+            // elements on its own
+            const size_t grain = parallel::grain_size(size);
+            const size_t range_count = (size + grain - 1) / grain;
+            std::vector<size_t> offsets(range_count * bucket_count);
+
+            for (size_t shift = 0; shift < 64; shift += digit_bits)
+            {
+                if (((varying_bits >> shift) & digit_mask) == 0)
+                    continue;
+
+                // count the occurrences of each digit per range
+                parallel::loop_for_range(0, size, [&](size_t begin, size_t end) {
+                    size_t* counts = &offsets[(begin / grain) * bucket_count];
+                    std::fill(counts, counts + bucket_count, 0);
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        counts[(sorted_keys[i] >> shift) & digit_mask]++;
+                    }
+                });
+
+                // exclusive prefix sum over all digits and ranges, ranges of the same digit are kept in order to
+                // obtain a stable sort
+                size_t sum = 0;
+                for (size_t digit = 0; digit < bucket_count; digit++)
+                {
+                    for (size_t range = 0; range < range_count; range++)
+                    {
+                        size_t count = offsets[range * bucket_count + digit];
+                        offsets[range * bucket_count + digit] = sum;
+                        sum += count;
+                    }
+                }
+
+                // move the elements to their position according to the current digit
+                parallel::loop_for_range(0, size, [&](size_t begin, size_t end) {
+                    size_t* range_offsets = &offsets[(begin / grain) * bucket_count];
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        size_t target = range_offsets[(sorted_keys[i] >> shift) & digit_mask]++;
+                        key_buffer[target] = sorted_keys[i];
+                        permutation_buffer[target] = permutation[i];
+                    }
+                });
+
+                std::swap(sorted_keys, key_buffer);
+                std::swap(permutation, permutation_buffer);
+            }
+
+            return permutation;
+        }
+
         void Sort::precalculate_keys(std::shared_ptr<ParticleCollection> collection, const Sort::key_function_t& key)
         {
             FLUID_ASSERT(collection->is_type_present<SortInfo>());
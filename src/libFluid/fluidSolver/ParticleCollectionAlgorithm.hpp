@@ -6,6 +6,7 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <vector>
 
 namespace LibFluid::ParticleCollectionAlgorithm
 {
@@ -25,6 +26,24 @@ namespace LibFluid::ParticleCollectionAlgorithm
 
         void insertion_sort(std::shared_ptr<ParticleCollection>, const key_function_t& key);
 
+        /**
+         * @brief Sorts the collection stable by the keys with a parallel radix sort and afterwards moves all
+         * particles to their sorted position in a single reorder of the collection.
+         *
+         * In contrast to the other sorting algorithms, the collection is not required to contain SortInfo.
+         */
+        void radix_sort(std::shared_ptr<ParticleCollection> collection, const key_function_t& key);
+
+        /**
+         * @brief Calculates the permutation that sorts the keys stable in ascending order, meaning that
+         * keys[permutation[i]] is the i-th smallest key.
+         *
+         * Uses a parallel least significant digit radix sort, that skips the bytes which are equal for all keys.
+         * Nearly sorted keys, as they occur when re-sorting particles that moved little, are sorted by an insertion
+         * sort instead.
+         */
+        static std::vector<uint32_t> radix_sort_permutation(const std::vector<uint64_t>& keys);
+
         template <bool should_precalculate_keys = true, bool calculate_parallellized = true>
         void quick_sort(std::shared_ptr<ParticleCollection> collection, const key_function_t& key)
         {
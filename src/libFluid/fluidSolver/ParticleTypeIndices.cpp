@@ -0,0 +1,30 @@
+#include "ParticleTypeIndices.hpp"
+
+#include "LibFluidAssert.hpp"
+
+namespace LibFluid {
+
+    void ParticleTypeIndices::update(const ParticleCollection& collection) {
+        FLUID_ASSERT(collection.is_type_present<ParticleInfo>());
+
+        fluid_indices.clear();
+        boundary_indices.clear();
+        inactive_indices.clear();
+
+        const ParticleInfo* infos = collection.column<ParticleInfo>();
+        for (size_t i = 0; i < collection.size(); i++) {
+            switch (infos[i].type) {
+                case ParticleTypeNormal:
+                    fluid_indices.push_back((uint32_t)i);
+                    break;
+                case ParticleTypeBoundary:
+                    boundary_indices.push_back((uint32_t)i);
+                    break;
+                default:
+                    inactive_indices.push_back((uint32_t)i);
+                    break;
+            }
+        }
+    }
+
+} // namespace LibFluid
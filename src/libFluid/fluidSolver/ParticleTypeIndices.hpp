@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ParticleCollection.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace LibFluid {
+
+    /**
+     * @brief Indices of the particles of a collection grouped by their type.
+     *
+     * Loops that only process fluid particles can iterate over the fluid indices instead of the whole collection.
+     * Hence they neither load the ParticleInfo of boundary and inactive particles nor branch on it, and the work is
+     * split evenly among the threads. The indices are stored in ascending order to keep the order in which the
+     * neighborhood searches sort the collection for cache efficiency.
+     *
+     * The indices have to be updated whenever particles are added, removed, reordered or change their type.
+     */
+    class ParticleTypeIndices {
+      public:
+        void update(const ParticleCollection& collection);
+
+        const std::vector<uint32_t>& fluid() const {
+            return fluid_indices;
+        }
+
+        const std::vector<uint32_t>& boundary() const {
+            return boundary_indices;
+        }
+
+        const std::vector<uint32_t>& inactive() const {
+            return inactive_indices;
+        }
+
+      private:
+        std::vector<uint32_t> fluid_indices;
+        std::vector<uint32_t> boundary_indices;
+        std::vector<uint32_t> inactive_indices;
+    };
+
+} // namespace LibFluid
@@ -0,0 +1,225 @@
+#include "BatchedCubicSplineKernel3D.hpp"
+
+#include "LibFluidAssert.hpp"
+#include "LibFluidMath.hpp"
+
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define FLUID_BATCHED_KERNEL_X86
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// msvc allows intrinsics of any instruction set without enabling them for the whole translation unit
+#define FLUID_TARGET_AVX2
+#define FLUID_TARGET_AVX512
+#else
+#define FLUID_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define FLUID_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#endif
+#endif
+
+namespace LibFluid {
+
+    namespace {
+
+        // All implementations evaluate the cubic spline of CubicSplineKernel3D without branches as
+        // alpha * (max(2 - q, 0)^3 - 4 * max(1 - q, 0)^3) with q = r / h. The factor alpha is applied by the caller.
+
+        float sum_scalar(const glm::vec3& position, const uint32_t* neighbors, size_t count,
+                const BatchedCubicSplineKernel3D::Positions& positions, const float* weights, float inverse_h) {
+            float sum = 0.0f;
+            for (size_t n = 0; n < count; n++) {
+                size_t j = neighbors[n];
+                float dx = position.x - positions.x[j * positions.stride];
+                float dy = position.y - positions.y[j * positions.stride];
+                float dz = position.z - positions.z[j * positions.stride];
+
+                float q = std::sqrt(dx * dx + dy * dy + dz * dz) * inverse_h;
+                float a = std::fmax(2.0f - q, 0.0f);
+                float b = std::fmax(1.0f - q, 0.0f);
+                sum += weights[j] * (a * a * a - 4.0f * b * b * b);
+            }
+            return sum;
+        }
+
+#ifdef FLUID_BATCHED_KERNEL_X86
+
+        FLUID_TARGET_AVX2 float sum_avx2(const glm::vec3& position, const uint32_t* neighbors, size_t count,
+                const BatchedCubicSplineKernel3D::Positions& positions, const float* weights, float inverse_h) {
+            const __m256 px = _mm256_set1_ps(position.x);
+            const __m256 py = _mm256_set1_ps(position.y);
+            const __m256 pz = _mm256_set1_ps(position.z);
+            const __m256 ih = _mm256_set1_ps(inverse_h);
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 two = _mm256_set1_ps(2.0f);
+            const __m256 four = _mm256_set1_ps(4.0f);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256i stride = _mm256_set1_epi32((int)positions.stride);
+            const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+            __m256 sum = zero;
+            for (size_t n = 0; n < count; n += 8) {
+                // the lanes beyond the last neighbor are masked out, their weight is gathered as zero
+                __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(count - n)), lanes);
+                __m256 mask_ps = _mm256_castsi256_ps(mask);
+
+                __m256i index = _mm256_maskload_epi32(reinterpret_cast<const int*>(neighbors + n), mask);
+                __m256i position_index = _mm256_mullo_epi32(index, stride);
+
+                __m256 dx = _mm256_sub_ps(px, _mm256_mask_i32gather_ps(zero, positions.x, position_index, mask_ps, 4));
+                __m256 dy = _mm256_sub_ps(py, _mm256_mask_i32gather_ps(zero, positions.y, position_index, mask_ps, 4));
+                __m256 dz = _mm256_sub_ps(pz, _mm256_mask_i32gather_ps(zero, positions.z, position_index, mask_ps, 4));
+                __m256 weight = _mm256_mask_i32gather_ps(zero, weights, index, mask_ps, 4);
+
+                __m256 r2 = _mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx)));
+                __m256 q = _mm256_mul_ps(_mm256_sqrt_ps(r2), ih);
+                __m256 a = _mm256_max_ps(_mm256_sub_ps(two, q), zero);
+                __m256 b = _mm256_max_ps(_mm256_sub_ps(one, q), zero);
+                __m256 a3 = _mm256_mul_ps(_mm256_mul_ps(a, a), a);
+                __m256 b3 = _mm256_mul_ps(_mm256_mul_ps(b, b), b);
+
+                sum = _mm256_fmadd_ps(weight, _mm256_fnmadd_ps(four, b3, a3), sum);
+            }
+
+            // horizontal reduction of the eight lanes
+            __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+            half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+            half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 0x1));
+            return _mm_cvtss_f32(half);
+        }
+
+        FLUID_TARGET_AVX512 float sum_avx512(const glm::vec3& position, const uint32_t* neighbors, size_t count,
+                const BatchedCubicSplineKernel3D::Positions& positions, const float* weights, float inverse_h) {
+            const __m512 px = _mm512_set1_ps(position.x);
+            const __m512 py = _mm512_set1_ps(position.y);
+            const __m512 pz = _mm512_set1_ps(position.z);
+            const __m512 ih = _mm512_set1_ps(inverse_h);
+            const __m512 one = _mm512_set1_ps(1.0f);
+            const __m512 two = _mm512_set1_ps(2.0f);
+            const __m512 four = _mm512_set1_ps(4.0f);
+            const __m512 zero = _mm512_setzero_ps();
+            const __m512i stride = _mm512_set1_epi32((int)positions.stride);
+
+            __m512 sum = zero;
+            for (size_t n = 0; n < count; n += 16) {
+                // the lanes beyond the last neighbor are masked out, their weight is gathered as zero
+                size_t remaining = count - n;
+                __mmask16 mask = remaining >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << remaining) - 1u);
+
+                __m512i index = _mm512_maskz_loadu_epi32(mask, neighbors + n);
+                __m512i position_index = _mm512_mullo_epi32(index, stride);
+
+                __m512 dx = _mm512_sub_ps(px, _mm512_mask_i32gather_ps(zero, mask, position_index, positions.x, 4));
+                __m512 dy = _mm512_sub_ps(py, _mm512_mask_i32gather_ps(zero, mask, position_index, positions.y, 4));
+                __m512 dz = _mm512_sub_ps(pz, _mm512_mask_i32gather_ps(zero, mask, position_index, positions.z, 4));
+                __m512 weight = _mm512_mask_i32gather_ps(zero, mask, index, weights, 4);
+
+                __m512 r2 = _mm512_fmadd_ps(dz, dz, _mm512_fmadd_ps(dy, dy, _mm512_mul_ps(dx, dx)));
+                __m512 q = _mm512_mul_ps(_mm512_sqrt_ps(r2), ih);
+                __m512 a = _mm512_max_ps(_mm512_sub_ps(two, q), zero);
+                __m512 b = _mm512_max_ps(_mm512_sub_ps(one, q), zero);
+                __m512 a3 = _mm512_mul_ps(_mm512_mul_ps(a, a), a);
+                __m512 b3 = _mm512_mul_ps(_mm512_mul_ps(b, b), b);
+
+                sum = _mm512_fmadd_ps(weight, _mm512_fnmadd_ps(four, b3, a3), sum);
+            }
+
+            return _mm512_reduce_add_ps(sum);
+        }
+
+#endif
+
+    } // namespace
+
+    float BatchedCubicSplineKernel3D::sum_weighted_values(const glm::vec3& position, const uint32_t* neighbors,
+            size_t count, const Positions& positions, const float* weights) const {
+        FLUID_ASSERT(alpha != 0.0f);
+
+        float sum;
+        switch (instruction_set) {
+#ifdef FLUID_BATCHED_KERNEL_X86
+            case InstructionSet::Avx512:
+                sum = sum_avx512(position, neighbors, count, positions, weights, inverse_h);
+                break;
+            case InstructionSet::Avx2:
+                sum = sum_avx2(position, neighbors, count, positions, weights, inverse_h);
+                break;
+#endif
+            default:
+                sum = sum_scalar(position, neighbors, count, positions, weights, inverse_h);
+                break;
+        }
+        return alpha * sum;
+    }
+
+    BatchedCubicSplineKernel3D::InstructionSet BatchedCubicSplineKernel3D::get_instruction_set() const {
+        return instruction_set;
+    }
+
+    BatchedCubicSplineKernel3D::InstructionSet BatchedCubicSplineKernel3D::detect_instruction_set() {
+#if defined(FLUID_BATCHED_KERNEL_X86) && defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        int max_leaf = info[0];
+
+        __cpuid(info, 1);
+        bool os_saves_registers = (info[2] & (1 << 27)) != 0;
+        bool fma = (info[2] & (1 << 12)) != 0;
+        if (max_leaf < 7 || !os_saves_registers) {
+            return InstructionSet::Scalar;
+        }
+
+        // the operating system has to save the ymm (and zmm) registers on context switches
+        unsigned long long enabled_registers = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        bool avx2 = (info[1] & (1 << 5)) != 0;
+        bool avx512f = (info[1] & (1 << 16)) != 0;
+
+        if (avx512f && avx2 && fma && (enabled_registers & 0xE6) == 0xE6) {
+            return InstructionSet::Avx512;
+        }
+        if (avx2 && fma && (enabled_registers & 0x6) == 0x6) {
+            return InstructionSet::Avx2;
+        }
+        return InstructionSet::Scalar;
+#elif defined(FLUID_BATCHED_KERNEL_X86)
+        // the builtins also check whether the operating system supports the registers
+        __builtin_cpu_init();
+        bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        if (avx2 && __builtin_cpu_supports("avx512f")) {
+            return InstructionSet::Avx512;
+        }
+        if (avx2) {
+            return InstructionSet::Avx2;
+        }
+        return InstructionSet::Scalar;
+#else
+        return InstructionSet::Scalar;
+#endif
+    }
+
+    void BatchedCubicSplineKernel3D::initialize() {
+        FLUID_ASSERT(kernel_support > 0.0f);
+
+        // same definition as in CubicSplineKernel3D
+        float h = kernel_support / 2.0f;
+        inverse_h = 1.0f / h;
+        alpha = 1.0f / (4.0f * Math::PI * Math::pow3(h));
+
+        instruction_set = detect_instruction_set();
+        if ((int)maximum_instruction_set < (int)instruction_set) {
+            instruction_set = maximum_instruction_set;
+        }
+    }
+
+    void BatchedCubicSplineKernel3D::create_compatibility_report(CompatibilityReport& report) {
+        report.begin_scope(FLUID_NAMEOF(BatchedCubicSplineKernel3D));
+        if (kernel_support <= 0.0f) {
+            report.add_issue("Kernel support radius is smaller or equal to zero!");
+        }
+        report.end_scope();
+    }
+
+} // namespace LibFluid
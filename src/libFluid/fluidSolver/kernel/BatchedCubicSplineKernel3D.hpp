@@ -0,0 +1,117 @@
+#pragma once
+
+#include "helpers/CompatibilityReport.hpp"
+#include "helpers/Initializable.hpp"
+#include "helpers/Reportable.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace LibFluid {
+
+    /**
+     * @brief Evaluates the kernel values of CubicSplineKernel3D for whole neighborhoods at once.
+     *
+     * The neighbors are processed 16 (AVX-512) or 8 (AVX2) at a time: their positions and weights are gathered by
+     * index, the kernel is evaluated without branches using masks and the weighted values are reduced horizontally.
+     * The instruction set is chosen at runtime based on the features of the CPU, hence the same binary runs on CPUs
+     * without AVX2 or AVX-512 by falling back to a scalar implementation.
+     */
+    class BatchedCubicSplineKernel3D : public Initializable, public Reportable {
+      public:
+        enum class InstructionSet {
+            Scalar,
+            Avx2,
+            Avx512
+        };
+
+        /**
+         * @brief Per particle positions, the position of particle i is (x[i * stride], y[i * stride], z[i * stride]).
+         *
+         * The product of any particle index with the stride has to fit into a 32 bit signed integer.
+         */
+        struct Positions
+        {
+            const float* x;
+            const float* y;
+            const float* z;
+            size_t stride;
+        };
+
+        float kernel_support;
+
+        // the best instruction set that is allowed to be used, the CPU may support less
+        InstructionSet maximum_instruction_set = InstructionSet::Avx512;
+
+        /**
+         * @brief Returns the sum of weights[j] * W(position - position of j) over the count neighbors j.
+         */
+        float sum_weighted_values(const glm::vec3& position, const uint32_t* neighbors, size_t count,
+                const Positions& positions, const float* weights) const;
+
+        /**
+         * @brief Returns the sum of weights[j] * W(position - position of j) over all neighbors j of the range.
+         *
+         * Ranges that can write all their indices at once with decode_into(uint32_t*) into a buffer of max_size
+         * indices, like the compressed neighbor lists, are decoded in one go instead of being iterated.
+         */
+        template<typename NeighborRange>
+        float sum_weighted_values(const glm::vec3& position, const NeighborRange& neighbors,
+                const Positions& positions, const float* weights) const;
+
+        /**
+         * @brief Returns the instruction set that is used for the evaluation after initialize was called.
+         */
+        InstructionSet get_instruction_set() const;
+
+        static InstructionSet detect_instruction_set();
+
+        void initialize() override;
+
+        void create_compatibility_report(CompatibilityReport& report) override;
+
+        // number of neighbors that are collected from a neighbor range before they are evaluated
+        static constexpr size_t neighbor_buffer_size = 64;
+
+        template<typename NeighborRange, typename = void>
+        struct is_decodable : std::false_type {};
+
+        template<typename NeighborRange>
+        struct is_decodable<NeighborRange,
+                std::void_t<decltype(std::declval<const NeighborRange&>().decode_into(std::declval<uint32_t*>())),
+                        decltype(NeighborRange::max_size)>> : std::true_type {};
+
+      private:
+        float inverse_h = 0.0f;
+        float alpha = 0.0f;
+        InstructionSet instruction_set = InstructionSet::Scalar;
+    };
+
+    template<typename NeighborRange>
+    float BatchedCubicSplineKernel3D::sum_weighted_values(const glm::vec3& position, const NeighborRange& neighbors,
+            const Positions& positions, const float* weights) const {
+        if constexpr (is_decodable<NeighborRange>::value) {
+            uint32_t decoded[NeighborRange::max_size];
+            size_t count = neighbors.decode_into(decoded);
+            return sum_weighted_values(position, decoded, count, positions, weights);
+        } else {
+            uint32_t buffer[neighbor_buffer_size];
+            size_t count = 0;
+
+            float sum = 0.0f;
+            for (uint32_t neighbor : neighbors) {
+                buffer[count++] = neighbor;
+                if (count == neighbor_buffer_size) {
+                    sum += sum_weighted_values(position, buffer, count, positions, weights);
+                    count = 0;
+                }
+            }
+            return sum + sum_weighted_values(position, buffer, count, positions, weights);
+        }
+    }
+
+} // namespace LibFluid
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "LibFluidAssert.hpp"
+#include "LibFluidMath.hpp"
+#include "helpers/CompatibilityReport.hpp"
+#include "helpers/Initializable.hpp"
+#include "helpers/Reportable.hpp"
+
+#include <glm/glm.hpp>
+
+#include <limits>
+
+namespace LibFluid {
+
+    enum class KernelType {
+        CubicSpline,
+        WendlandC2,
+        WendlandC4
+    };
+
+    template<size_t Dimension>
+    struct KernelVector;
+
+    template<>
+    struct KernelVector<2> {
+        using type = glm::vec2;
+    };
+
+    template<>
+    struct KernelVector<3> {
+        using type = glm::vec3;
+    };
+
+    /**
+     * @brief SPH kernel of the given type and dimension, which can be used as the kernel of the solvers.
+     *
+     * All kernels are written as normalization / kernel_support^Dimension * shape(q) with q = r / kernel_support. The
+     * normalization constants and shape functions are resolved at compile time.
+     *
+     * The derivatives are scaled like the ones of CubicSplineKernel and CubicSplineKernel3D, which are the gradient
+     * of the kernel multiplied by (kernel_support / 2)^2. Hence the kernels can be exchanged without retuning the
+     * solver settings, and Kernel<3, KernelType::CubicSpline> yields the same values as CubicSplineKernel3D.
+     */
+    template<size_t Dimension, KernelType Type>
+    class Kernel : public Initializable, public Reportable {
+        static_assert(Dimension == 2 || Dimension == 3, "Only 2D and 3D kernels are supported!");
+
+      public:
+        using vec = typename KernelVector<Dimension>::type;
+
+        float kernel_support;
+
+        float GetKernelValue(const vec& position) const {
+            FLUID_ASSERT(inverse_support != 0.0f);
+
+            float q = glm::length(position) * inverse_support;
+            return value_factor * shape(q);
+        }
+
+        vec GetKernelDerivativeValue(const vec& position) const {
+            FLUID_ASSERT(inverse_support != 0.0f);
+
+            float length = glm::length(position);
+            if (length <= std::numeric_limits<float>::epsilon())
+                return vec(0.0f);
+
+            float q = length * inverse_support;
+
+            // the derivative of the kernel with respect to the position is reversed, like in CubicSplineKernel3D
+            return -derivative_factor * shape_derivative(q) / length * position;
+        }
+
+        float GetKernelValue(const vec& neighborPosition, const vec& position) const {
+            return GetKernelValue(position - neighborPosition);
+        }
+
+        vec GetKernelDerivativeValue(const vec& neighborPosition, const vec& position) const {
+            return GetKernelDerivativeValue(position - neighborPosition);
+        }
+
+        vec GetKernelDerivativeReversedValue(const vec& neighborPosition, const vec& position) const {
+            return GetKernelDerivativeValue(neighborPosition, position) * -1.0f;
+        }
+
+        void initialize() override {
+            FLUID_ASSERT(kernel_support > 0.0f);
+            inverse_support = 1.0f / kernel_support;
+
+            value_factor = normalization();
+            for (size_t i = 0; i < Dimension; i++) {
+                value_factor *= inverse_support;
+            }
+
+            // d/dr of the kernel is value_factor * shape'(q) / kernel_support, scaled by (kernel_support / 2)^2
+            derivative_factor = value_factor * kernel_support / 4.0f;
+        }
+
+        void create_compatibility_report(CompatibilityReport& report) override {
+            report.begin_scope(FLUID_NAMEOF(Kernel));
+            if (kernel_support <= 0.0f) {
+                report.add_issue("Kernel support radius is smaller or equal to zero!");
+            }
+            report.end_scope();
+        }
+
+        /**
+         * @brief Normalization constant of the kernel for a kernel support of one.
+         */
+        static constexpr float normalization() {
+            if constexpr (Type == KernelType::CubicSpline) {
+                return Dimension == 2 ? 10.0f / (7.0f * Math::PI) : 2.0f / Math::PI;
+            } else if constexpr (Type == KernelType::WendlandC2) {
+                return Dimension == 2 ? 7.0f / Math::PI : 21.0f / (2.0f * Math::PI);
+            } else {
+                return Dimension == 2 ? 9.0f / Math::PI : 495.0f / (32.0f * Math::PI);
+            }
+        }
+
+        static constexpr float shape(float q) {
+            if (q >= 1.0f)
+                return 0.0f;
+
+            if constexpr (Type == KernelType::CubicSpline) {
+                float a = 2.0f - 2.0f * q;
+                float b = 1.0f - 2.0f * q;
+                return q < 0.5f ? a * a * a - 4.0f * b * b * b : a * a * a;
+            } else if constexpr (Type == KernelType::WendlandC2) {
+                float a = 1.0f - q;
+                return a * a * a * a * (1.0f + 4.0f * q);
+            } else {
+                float a = 1.0f - q;
+                return a * a * a * a * a * a * (1.0f + 6.0f * q + 35.0f / 3.0f * q * q);
+            }
+        }
+
+        static constexpr float shape_derivative(float q) {
+            if (q >= 1.0f)
+                return 0.0f;
+
+            if constexpr (Type == KernelType::CubicSpline) {
+                float a = 2.0f - 2.0f * q;
+                float b = 1.0f - 2.0f * q;
+                return q < 0.5f ? -6.0f * a * a + 24.0f * b * b : -6.0f * a * a;
+            } else if constexpr (Type == KernelType::WendlandC2) {
+                float a = 1.0f - q;
+                return -20.0f * q * a * a * a;
+            } else {
+                float a = 1.0f - q;
+                return -56.0f / 3.0f * q * a * a * a * a * a * (1.0f + 5.0f * q);
+            }
+        }
+
+      private:
+        float inverse_support = 0.0f;
+        float value_factor = 0.0f;
+        float derivative_factor = 0.0f;
+    };
+
+    using WendlandC2Kernel3D = Kernel<3, KernelType::WendlandC2>;
+    using WendlandC4Kernel3D = Kernel<3, KernelType::WendlandC4>;
+
+} // namespace LibFluid
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "fluidSolver/kernel/Kernel.hpp"
+
+namespace LibFluid {
+
+    /**
+     * @brief 3D kernel whose type is chosen at runtime, for components that are configured by settings instead of
+     * template parameters.
+     *
+     * All kernel types are initialized at once, hence the type can be changed without initializing the kernel again.
+     */
+    class SelectableKernel3D : public Initializable, public Reportable {
+      public:
+        KernelType type = KernelType::CubicSpline;
+
+        float kernel_support;
+
+        float GetKernelValue(const glm::vec3& position) const {
+            switch (type) {
+                case KernelType::WendlandC2:
+                    return wendland_c2.GetKernelValue(position);
+                case KernelType::WendlandC4:
+                    return wendland_c4.GetKernelValue(position);
+                default:
+                    return cubic_spline.GetKernelValue(position);
+            }
+        }
+
+        glm::vec3 GetKernelDerivativeValue(const glm::vec3& position) const {
+            switch (type) {
+                case KernelType::WendlandC2:
+                    return wendland_c2.GetKernelDerivativeValue(position);
+                case KernelType::WendlandC4:
+                    return wendland_c4.GetKernelDerivativeValue(position);
+                default:
+                    return cubic_spline.GetKernelDerivativeValue(position);
+            }
+        }
+
+        float GetKernelValue(const glm::vec3& neighborPosition, const glm::vec3& position) const {
+            return GetKernelValue(position - neighborPosition);
+        }
+
+        glm::vec3 GetKernelDerivativeValue(const glm::vec3& neighborPosition, const glm::vec3& position) const {
+            return GetKernelDerivativeValue(position - neighborPosition);
+        }
+
+        glm::vec3 GetKernelDerivativeReversedValue(const glm::vec3& neighborPosition, const glm::vec3& position) const {
+            return GetKernelDerivativeValue(neighborPosition, position) * -1.0f;
+        }
+
+        void initialize() override {
+            cubic_spline.kernel_support = kernel_support;
+            cubic_spline.initialize();
+            wendland_c2.kernel_support = kernel_support;
+            wendland_c2.initialize();
+            wendland_c4.kernel_support = kernel_support;
+            wendland_c4.initialize();
+        }
+
+        void create_compatibility_report(CompatibilityReport& report) override {
+            report.begin_scope(FLUID_NAMEOF(SelectableKernel3D));
+            if (kernel_support <= 0.0f) {
+                report.add_issue("Kernel support radius is smaller or equal to zero!");
+            }
+            report.end_scope();
+        }
+
+      private:
+        Kernel<3, KernelType::CubicSpline> cubic_spline;
+        Kernel<3, KernelType::WendlandC2> wendland_c2;
+        Kernel<3, KernelType::WendlandC4> wendland_c4;
+    };
+
+} // namespace LibFluid
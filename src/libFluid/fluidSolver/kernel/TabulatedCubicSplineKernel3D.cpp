@@ -0,0 +1,60 @@
+#include "TabulatedCubicSplineKernel3D.hpp"
+
+#include "LibFluidAssert.hpp"
+#include "LibFluidMath.hpp"
+
+#include <cmath>
+
+namespace LibFluid {
+
+    void TabulatedCubicSplineKernel3D::initialize() {
+        FLUID_ASSERT(kernel_support > 0.0f);
+
+        // same definition as in CubicSplineKernel3D
+        float h = kernel_support / 2.0f;
+        float alpha = 1.0f / (4.0f * Math::PI * Math::pow3(h));
+
+        float squared_distance_step = Math::pow2(kernel_support) / (float)table_resolution;
+        inverse_squared_distance_step = 1.0f / squared_distance_step;
+
+        table.resize(table_resolution + 1);
+        for (size_t i = 0; i < table_resolution; i++) {
+            // the samples are computed in double precision to keep the interpolation error dominant
+            double r = std::sqrt((double)i * (double)squared_distance_step);
+            double q = r / h;
+
+            double a = 2.0 - q;
+            double b = 1.0 - q;
+
+            double value = 0.0;
+            double derivative = 0.0; // derivative of the kernel function with respect to q
+            if (q < 1.0) {
+                value = a * a * a - 4.0 * b * b * b;
+                derivative = -3.0 * a * a + 12.0 * b * b;
+            } else if (q < 2.0) {
+                value = a * a * a;
+                derivative = -3.0 * a * a;
+            }
+
+            // CubicSplineKernel3D yields -alpha * h * derivative / r * position, derivative / r approaches -12 / h
+            double gradient_factor = 12.0 * alpha;
+            if (r > 0.0) {
+                gradient_factor = -alpha * h * derivative / r;
+            }
+
+            table[i] = {(float)(alpha * value), (float)gradient_factor};
+        }
+
+        // the kernel vanishes at the border of its support
+        table[table_resolution] = {0.0f, 0.0f};
+    }
+
+    void TabulatedCubicSplineKernel3D::create_compatibility_report(CompatibilityReport& report) {
+        report.begin_scope(FLUID_NAMEOF(TabulatedCubicSplineKernel3D));
+        if (kernel_support <= 0.0f) {
+            report.add_issue("Kernel support radius is smaller or equal to zero!");
+        }
+        report.end_scope();
+    }
+
+} // namespace LibFluid
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "helpers/CompatibilityReport.hpp"
+#include "helpers/Initializable.hpp"
+#include "helpers/Reportable.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace LibFluid {
+
+    /**
+     * @brief Cubic spline kernel that is evaluated by a lookup table over the squared distance.
+     *
+     * This yields the same values as CubicSplineKernel3D up to the interpolation error of the table, but does not
+     * require a square root, a division or any branching on the piecewise definition of the kernel. It can be used
+     * as a replacement of CubicSplineKernel3D in the solvers.
+     */
+    class TabulatedCubicSplineKernel3D : public Initializable, public Reportable {
+      public:
+        struct ValueAndGradient
+        {
+            float value;
+
+            // equal to GetKernelDerivativeReversedValue
+            glm::vec3 gradient;
+        };
+
+        float kernel_support;
+
+        float GetKernelValue(const glm::vec3& position) const;
+
+        glm::vec3 GetKernelDerivativeValue(const glm::vec3& position) const;
+
+        float GetKernelValue(const glm::vec3& neighborPosition, const glm::vec3& position) const;
+
+        glm::vec3 GetKernelDerivativeValue(const glm::vec3& neighborPosition, const glm::vec3& position) const;
+
+        glm::vec3 GetKernelDerivativeReversedValue(const glm::vec3& neighborPosition, const glm::vec3& position) const;
+
+        /**
+         * @brief Returns the kernel value and the reversed kernel derivative with a single table lookup.
+         */
+        ValueAndGradient value_and_gradient(const glm::vec3& neighborPosition, const glm::vec3& position) const;
+
+        void initialize() override;
+
+        void create_compatibility_report(CompatibilityReport& report) override;
+
+      private:
+        struct TableEntry
+        {
+            float value;
+
+            // the kernel derivative at a position is gradient_factor * position
+            float gradient_factor;
+        };
+
+        static constexpr size_t table_resolution = 2048;
+
+        // table_resolution equidistant samples over the squared distance from zero up to the squared kernel support,
+        // followed by a zero entry
+        std::vector<TableEntry> table;
+        float inverse_squared_distance_step = 0.0f;
+
+        TableEntry lookup(float squared_distance) const;
+    };
+
+    inline TabulatedCubicSplineKernel3D::TableEntry TabulatedCubicSplineKernel3D::lookup(float squared_distance) const {
+        float x = squared_distance * inverse_squared_distance_step;
+        if (!(x < (float)table_resolution))
+            return {0.0f, 0.0f};
+
+        size_t index = (size_t)x;
+        float t = x - (float)index;
+
+        const TableEntry& a = table[index];
+        const TableEntry& b = table[index + 1];
+        return {a.value + t * (b.value - a.value), a.gradient_factor + t * (b.gradient_factor - a.gradient_factor)};
+    }
+
+    inline float TabulatedCubicSplineKernel3D::GetKernelValue(const glm::vec3& position) const {
+        return lookup(glm::dot(position, position)).value;
+    }
+
+    inline glm::vec3 TabulatedCubicSplineKernel3D::GetKernelDerivativeValue(const glm::vec3& position) const {
+        return lookup(glm::dot(position, position)).gradient_factor * position;
+    }
+
+    inline float TabulatedCubicSplineKernel3D::GetKernelValue(const glm::vec3& neighborPosition,
+            const glm::vec3& position) const {
+        return GetKernelValue(position - neighborPosition);
+    }
+
+    inline glm::vec3 TabulatedCubicSplineKernel3D::GetKernelDerivativeValue(const glm::vec3& neighborPosition,
+            const glm::vec3& position) const {
+        return GetKernelDerivativeValue(position - neighborPosition);
+    }
+
+    inline glm::vec3 TabulatedCubicSplineKernel3D::GetKernelDerivativeReversedValue(const glm::vec3& neighborPosition,
+            const glm::vec3& position) const {
+        // the derivative is odd, hence reversing it is the same as swapping the positions
+        return GetKernelDerivativeValue(neighborPosition - position);
+    }
+
+    inline TabulatedCubicSplineKernel3D::ValueAndGradient TabulatedCubicSplineKernel3D::value_and_gradient(
+            const glm::vec3& neighborPosition, const glm::vec3& position) const {
+        glm::vec3 difference = neighborPosition - position;
+        TableEntry entry = lookup(glm::dot(difference, difference));
+        return {entry.value, entry.gradient_factor * difference};
+    }
+
+} // namespace LibFluid
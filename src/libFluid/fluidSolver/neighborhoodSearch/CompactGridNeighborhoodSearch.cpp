@@ -0,0 +1,440 @@
+#include "CompactGridNeighborhoodSearch.hpp"
+
+#include "parallelization/StdParallelForEach.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace LibFluid {
+
+    using parallel = StdParallelForEach;
+
+    static size_t hardware_thread_count() {
+        static const size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        return thread_count;
+    }
+
+    void CompactGridNeighborhoodSearch::initialize() {
+        FLUID_ASSERT(collection != nullptr);
+    }
+
+    void CompactGridNeighborhoodSearch::create_compatibility_report(CompatibilityReport& report) {
+        report.begin_scope(FLUID_NAMEOF(CompactGridNeighborhoodSearch));
+        if (collection == nullptr) {
+            report.add_issue("ParticleCollection is null.");
+        } else {
+            if (!collection->is_type_present<MovementData>()) {
+                report.add_issue("Particles are missing the MovementData attribute.");
+            }
+            if (!collection->is_type_present<ParticleInfo>()) {
+                report.add_issue("Particles are missing the ParticleInfo attribute.");
+            }
+            if (collection->size() >= std::numeric_limits<uint32_t>::max()) {
+                report.add_issue("Too many particles, the particle indices have to fit into 32 bits.");
+            }
+        }
+
+        if (search_radius <= 0.0f) {
+            report.add_issue("Search radius is smaller or equal to zero.");
+        }
+
+        report.end_scope();
+    }
+
+    int32_t CompactGridNeighborhoodSearch::calculate_cell_coordinate(float position, float origin,
+            int32_t cell_count) const {
+        // positions outside of the grid are moved onto the cells right next to it, positions that are not finite
+        // end up there as well
+        float coordinate = std::floor((position - origin) / cell_size);
+        if (!(coordinate >= -1.0f))
+            return -1;
+        if (coordinate > (float)cell_count)
+            return cell_count;
+        return (int32_t)coordinate;
+    }
+
+    void CompactGridNeighborhoodSearch::rebuild_grid() {
+        FLUID_ASSERT(collection != nullptr);
+        FLUID_ASSERT(collection->is_type_present<MovementData>());
+        FLUID_ASSERT(collection->is_type_present<ParticleInfo>());
+        FLUID_ASSERT(search_radius > 0.0f);
+
+        // the grid spans the bounding box of the active particles, particles with a position that is not finite
+        // (e.g. after the simulation diverged) are ignored, otherwise the extent of the grid would not be finite
+        struct BoundingBox
+        {
+            glm::vec2 minimum;
+            glm::vec2 maximum;
+            size_t active_particles;
+        };
+        BoundingBox bounding_box = parallel::reduce(
+                0, collection->size(),
+                BoundingBox{glm::vec2(std::numeric_limits<float>::max()), glm::vec2(std::numeric_limits<float>::lowest()), 0},
+                [&](size_t i) {
+                    if (collection->get<ParticleInfo>(i).type == ParticleTypeInactive)
+                        return BoundingBox{glm::vec2(std::numeric_limits<float>::max()),
+                                glm::vec2(std::numeric_limits<float>::lowest()), 0};
+                    const glm::vec2& position = collection->get<MovementData>(i).position;
+                    if (!std::isfinite(position.x) || !std::isfinite(position.y))
+                        return BoundingBox{glm::vec2(std::numeric_limits<float>::max()),
+                                glm::vec2(std::numeric_limits<float>::lowest()), 1};
+                    return BoundingBox{position, position, 1};
+                },
+                [](const BoundingBox& a, const BoundingBox& b) {
+                    return BoundingBox{glm::vec2(std::min(a.minimum.x, b.minimum.x), std::min(a.minimum.y, b.minimum.y)),
+                            glm::vec2(std::max(a.maximum.x, b.maximum.x), std::max(a.maximum.y, b.maximum.y)),
+                            a.active_particles + b.active_particles};
+                });
+        size_t active_particles = bounding_box.active_particles;
+
+        if (active_particles == 0) {
+            grid_origin = glm::vec2(0.0f);
+            cell_size = search_radius;
+            cell_count_x = 0;
+            cell_count_y = 0;
+            cell_starts.assign(1, 0);
+            sorted_particles.clear();
+            sorted_positions.clear();
+            return;
+        }
+
+        if (bounding_box.minimum.x > bounding_box.maximum.x || bounding_box.minimum.y > bounding_box.maximum.y) {
+            // none of the active particles has a finite position
+            bounding_box.minimum = glm::vec2(0.0f);
+            bounding_box.maximum = glm::vec2(0.0f);
+        }
+
+        // a few particles far away from all others would create a huge number of empty cells, in that case the cells
+        // are enlarged until their number is proportional to the number of particles. If the extent is too large even
+        // for the maximum amount of doublings, all particles are put into a single cell.
+        const int64_t maximum_cell_count = 4 * (int64_t)active_particles + 64;
+        grid_origin = bounding_box.minimum;
+        cell_size = search_radius;
+        cell_count_x = 1;
+        cell_count_y = 1;
+        for (size_t doublings = 0; doublings < maximum_cell_size_doublings; doublings++) {
+            glm::vec2 extent = (bounding_box.maximum - bounding_box.minimum) / cell_size;
+            if (extent.x < (float)maximum_cell_count && extent.y < (float)maximum_cell_count &&
+                    ((int64_t)extent.x + 1) * ((int64_t)extent.y + 1) <= maximum_cell_count) {
+                cell_count_x = (int32_t)extent.x + 1;
+                cell_count_y = (int32_t)extent.y + 1;
+                break;
+            }
+            cell_size *= 2.0f;
+        }
+        size_t cell_count = (size_t)cell_count_x * cell_count_y;
+
+        particle_cells.resize(collection->size());
+        parallel::loop_for(0, collection->size(), [&](size_t i) {
+            if (collection->get<ParticleInfo>(i).type == ParticleTypeInactive)
+                return;
+            const glm::vec2& position = collection->get<MovementData>(i).position;
+            int32_t x = std::clamp(calculate_cell_coordinate(position.x, grid_origin.x, cell_count_x), 0, cell_count_x - 1);
+            int32_t y = std::clamp(calculate_cell_coordinate(position.y, grid_origin.y, cell_count_y), 0, cell_count_y - 1);
+            particle_cells[i] = (uint32_t)y * cell_count_x + x;
+        });
+
+        // counting sort of the active particles by their cell: each chunk of particles counts its particles per cell
+        // in its own histogram. There are at most as many chunks as particles per cell, such that the histograms
+        // together take about as much memory as particle_cells.
+        size_t chunk_count = std::clamp(collection->size() / cell_count, (size_t)1, hardware_thread_count());
+        size_t chunk_size = (collection->size() + chunk_count - 1) / chunk_count;
+
+        // histogram of chunk c is stored interleaved at chunk_histograms[cell * chunk_count + c]. Each chunk is a task
+        // of its own, the default grain size would process all chunks on the calling thread.
+        chunk_histograms.assign(cell_count * chunk_count, 0);
+        auto count_chunk = [&](size_t c) {
+            size_t end = std::min((c + 1) * chunk_size, collection->size());
+            for (size_t i = c * chunk_size; i < end; i++) {
+                if (collection->get<ParticleInfo>(i).type != ParticleTypeInactive) {
+                    chunk_histograms[particle_cells[i] * chunk_count + c]++;
+                }
+            }
+        };
+        parallel::loop_for_range(0, chunk_count, 1, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; c++) {
+                count_chunk(c);
+            }
+        });
+
+        // the particles of a cell are sorted by their chunk, hence the prefix sum over the interleaved histograms
+        // yields the position of the first particle of each chunk in each cell. The cells keep the particles in
+        // ascending order like a serial counting sort.
+        cell_starts.resize(cell_count + 1);
+        parallel::loop_for(0, cell_count, [&](size_t cell) {
+            uint32_t count = 0;
+            for (size_t c = 0; c < chunk_count; c++) {
+                uint32_t chunk_particles = chunk_histograms[cell * chunk_count + c];
+                chunk_histograms[cell * chunk_count + c] = count;
+                count += chunk_particles;
+            }
+            cell_starts[cell + 1] = count;
+        });
+        cell_starts[0] = 0;
+        for (size_t cell = 0; cell < cell_count; cell++) {
+            cell_starts[cell + 1] += cell_starts[cell];
+        }
+
+        sorted_particles.resize(active_particles);
+        auto scatter_chunk = [&](size_t c) {
+            size_t end = std::min((c + 1) * chunk_size, collection->size());
+            for (size_t i = c * chunk_size; i < end; i++) {
+                if (collection->get<ParticleInfo>(i).type != ParticleTypeInactive) {
+                    uint32_t cell = particle_cells[i];
+                    uint32_t& insert_position = chunk_histograms[cell * chunk_count + c];
+                    sorted_particles[cell_starts[cell] + insert_position++] = (uint32_t)i;
+                }
+            }
+        };
+        parallel::loop_for_range(0, chunk_count, 1, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; c++) {
+                scatter_chunk(c);
+            }
+        });
+
+        sorted_positions.resize(sorted_particles.size());
+        parallel::loop_for(0, sorted_particles.size(),
+                [&](size_t i) { sorted_positions[i] = collection->get<MovementData>(sorted_particles[i]).position; });
+    }
+
+    void CompactGridNeighborhoodSearch::find_neighbors_of_row(int32_t y, bool write_neighbors) {
+        float search_radius_squared = search_radius * search_radius;
+
+        int32_t first_row = std::max(y - 1, 0);
+        int32_t last_row = std::min(y + 1, cell_count_y - 1);
+
+        for (int32_t x = 0; x < cell_count_x; x++) {
+            // the cells of a row are stored consecutively, hence each row of the 3x3 surrounding cells is one range
+            int32_t first_column = std::max(x - 1, 0);
+            int32_t last_column = std::min(x + 1, cell_count_x - 1);
+
+            uint32_t cell = (uint32_t)y * cell_count_x + x;
+            for (uint32_t i = cell_starts[cell]; i < cell_starts[cell + 1]; i++) {
+                const glm::vec2& position = sorted_positions[i];
+                uint32_t particle = sorted_particles[i];
+
+                uint32_t count = 0;
+                uint32_t* target = write_neighbors ? &neighbor_indices[neighbor_offsets[particle]] : nullptr;
+
+                for (int32_t row = first_row; row <= last_row; row++) {
+                    uint32_t begin = cell_starts[(uint32_t)row * cell_count_x + first_column];
+                    uint32_t end = cell_starts[(uint32_t)row * cell_count_x + last_column + 1];
+                    for (uint32_t j = begin; j < end; j++) {
+                        glm::vec2 difference = position - sorted_positions[j];
+                        if (glm::dot(difference, difference) <= search_radius_squared) {
+                            if (write_neighbors) {
+                                target[count] = sorted_particles[j];
+                            }
+                            count++;
+                        }
+                    }
+                }
+
+                if (!write_neighbors) {
+                    neighbor_offsets[particle + 1] = count;
+                }
+            }
+        }
+    }
+
+    void CompactGridNeighborhoodSearch::find_neighbors() {
+        FLUID_ASSERT(collection != nullptr);
+        FLUID_ASSERT(collection->size() < std::numeric_limits<uint32_t>::max());
+
+        rebuild_grid();
+
+        // a row of cells contains many particles, hence the rows are split into ranges per thread regardless of
+        // the minimum grain size of the parallel loops
+        size_t rows = (size_t)cell_count_y;
+        size_t row_grain = std::max(rows / (hardware_thread_count() * parallel::ranges_per_thread), (size_t)1);
+        auto find_neighbors_of_rows = [&](bool write_neighbors) {
+            parallel::loop_for_range(0, rows, row_grain, [&](size_t begin, size_t end) {
+                for (size_t y = begin; y < end; y++) {
+                    find_neighbors_of_row((int32_t)y, write_neighbors);
+                }
+            });
+        };
+
+        // count the neighbors of each particle, inactive particles keep zero neighbors
+        neighbor_offsets.assign(collection->size() + 1, 0);
+        find_neighbors_of_rows(false);
+
+        // the offsets are the prefix sum of the counts
+        for (size_t i = 0; i < collection->size(); i++) {
+            neighbor_offsets[i + 1] += neighbor_offsets[i];
+        }
+
+        // write the neighbors to their final location
+        neighbor_indices.resize(neighbor_offsets.back());
+        find_neighbors_of_rows(true);
+    }
+
+    template<typename Callable>
+    void CompactGridNeighborhoodSearch::for_each_neighbor_of_position(const glm::vec2& position,
+            Callable&& callable) const {
+        if (cell_count_x == 0 || cell_count_y == 0)
+            return;
+
+        int32_t x = calculate_cell_coordinate(position.x, grid_origin.x, cell_count_x);
+        int32_t y = calculate_cell_coordinate(position.y, grid_origin.y, cell_count_y);
+
+        int32_t first_column = std::max(x - 1, 0);
+        int32_t last_column = std::min(x + 1, cell_count_x - 1);
+        int32_t first_row = std::max(y - 1, 0);
+        int32_t last_row = std::min(y + 1, cell_count_y - 1);
+
+        float search_radius_squared = search_radius * search_radius;
+        for (int32_t row = first_row; row <= last_row; row++) {
+            uint32_t begin = cell_starts[(uint32_t)row * cell_count_x + first_column];
+            uint32_t end = cell_starts[(uint32_t)row * cell_count_x + last_column + 1];
+            for (uint32_t j = begin; j < end; j++) {
+                glm::vec2 difference = position - sorted_positions[j];
+                if (glm::dot(difference, difference) <= search_radius_squared && !callable(sorted_particles[j])) {
+                    return;
+                }
+            }
+        }
+    }
+
+    CompactGridNeighborhoodSearch::Neighbors CompactGridNeighborhoodSearch::get_neighbors(
+            particleIndex_t particleIndex) {
+        FLUID_ASSERT(particleIndex + 1 < neighbor_offsets.size());
+
+        Neighbors n;
+        n.data = this;
+        n.position_based = false;
+        n.of.particle = particleIndex;
+        n.first = neighbor_indices.data() + neighbor_offsets[particleIndex];
+        n.last = neighbor_indices.data() + neighbor_offsets[particleIndex + 1];
+        return n;
+    }
+
+    CompactGridNeighborhoodSearch::Neighbors CompactGridNeighborhoodSearch::get_neighbors(const glm::vec2& position) {
+        Neighbors n;
+        n.data = this;
+        n.position_based = true;
+        n.of.position = position;
+        n.position_based_neighbors = std::make_shared<std::vector<uint32_t>>();
+
+        for_each_neighbor_of_position(position, [&](uint32_t neighbor) {
+            n.position_based_neighbors->push_back(neighbor);
+            return true;
+        });
+
+        n.first = n.position_based_neighbors->data();
+        n.last = n.first + n.position_based_neighbors->size();
+        return n;
+    }
+
+    CompactGridNeighborhoodSearch::NeighborsIterator CompactGridNeighborhoodSearch::Neighbors::begin() const {
+        NeighborsIterator iterator;
+        iterator.position_in_list = first;
+        return iterator;
+    }
+
+    CompactGridNeighborhoodSearch::NeighborsIterator CompactGridNeighborhoodSearch::Neighbors::end() const {
+        NeighborsIterator iterator;
+        iterator.position_in_list = last;
+        return iterator;
+    }
+
+    size_t CompactGridNeighborhoodSearch::Neighbors::size() const {
+        return last - first;
+    }
+
+    bool CompactGridNeighborhoodSearch::NeighborsIterator::operator==(const NeighborsIterator& other) const {
+        return position_in_list == other.position_in_list;
+    }
+
+    bool CompactGridNeighborhoodSearch::NeighborsIterator::operator!=(const NeighborsIterator& other) const {
+        return !(*this == other);
+    }
+
+    CompactGridNeighborhoodSearch::particleIndex_t& CompactGridNeighborhoodSearch::NeighborsIterator::operator*() {
+        FLUID_ASSERT(position_in_list != nullptr);
+        current = *position_in_list;
+        return current;
+    }
+
+    CompactGridNeighborhoodSearch::NeighborsIterator& CompactGridNeighborhoodSearch::NeighborsIterator::operator++() {
+        ++position_in_list;
+        return *this;
+    }
+
+    const CompactGridNeighborhoodSearch::NeighborsIterator CompactGridNeighborhoodSearch::NeighborsIterator::operator++(
+            int) {
+        NeighborsIterator copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+    std::shared_ptr<NeighborhoodInterface> CompactGridNeighborhoodSearch::create_interface() {
+        auto res = std::make_shared<NeighborhoodInterface>();
+
+        auto link_neighbors = [](const Neighbors& neighbors) {
+            auto n = NeighborhoodInterface::Neighbors();
+            n.iterator_link.begin = [neighbors]() {
+                auto real_it = neighbors.begin();
+                return new NeighborsIterator(real_it);
+            };
+            n.iterator_link.end = [neighbors]() {
+                auto real_it = neighbors.end();
+                return new NeighborsIterator(real_it);
+            };
+            n.iterator_link.iterator_copy = [](void* it) {
+                auto copy = new NeighborsIterator(*((NeighborsIterator*)it));
+                return copy;
+            };
+            n.iterator_link.iterator_delete = [](void* it) {
+                delete ((NeighborsIterator*)it);
+            };
+            n.iterator_link.iterator_dereference = [](void* it) {
+                auto& index = *(*(NeighborsIterator*)it);
+                return &index;
+            };
+            n.iterator_link.iterator_equals = [](void* it1, void* it2) {
+                return *((NeighborsIterator*)it1) == *((NeighborsIterator*)it2);
+            };
+            n.iterator_link.iterator_increment = [](void* it) {
+                ++(*(NeighborsIterator*)it);
+            };
+
+            return n;
+        };
+
+        res->link.get_by_index = [this, link_neighbors](particleIndex_t index) {
+            return link_neighbors(this->get_neighbors(index));
+        };
+
+        res->link.get_by_position = [this, link_neighbors](const glm::vec2& position) {
+            return link_neighbors(this->get_neighbors(position));
+        };
+
+        res->link.for_each_by_index = [this](particleIndex_t index, NeighborhoodInterface::NeighborCallback callback) {
+            FLUID_ASSERT(index + 1 < neighbor_offsets.size());
+            for (uint32_t n = neighbor_offsets[index]; n < neighbor_offsets[index + 1]; n++) {
+                if (!callback(neighbor_indices[n]))
+                    return;
+            }
+        };
+
+        auto for_each_by_position = [this](const glm::vec2& position,
+                                           NeighborhoodInterface::NeighborCallback callback) {
+            this->for_each_neighbor_of_position(position, callback);
+        };
+        res->link.for_each_by_position = for_each_by_position;
+        res->link.gather_by_position = [for_each_by_position](const glm::vec2* positions, size_t count,
+                std::vector<size_t>& offsets, std::vector<particleIndex_t>& indices) {
+            NeighborhoodInterface::gather_neighbors_with(for_each_by_position, positions, count, offsets, indices);
+        };
+
+        res->link.get_search_radius = [&] {
+            return this->search_radius;
+        };
+
+        return res;
+    }
+
+} // namespace LibFluid
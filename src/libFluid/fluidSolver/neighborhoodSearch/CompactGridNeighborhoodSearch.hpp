@@ -0,0 +1,135 @@
+#pragma once
+
+#include "fluidSolver/ParticleCollection.hpp"
+#include "fluidSolver/neighborhoodSearch/NeighborhoodInterface.hpp"
+#include "helpers/CompatibilityReport.hpp"
+#include "helpers/Initializable.hpp"
+#include "helpers/Reportable.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace LibFluid {
+
+    /**
+     * @brief 2D neighborhood search on a dense grid that spans the bounding box of the active particles.
+     *
+     * The particles are sorted by their cell with a counting sort, hence the particles of cell c are
+     * sorted_particles[cell_starts[c]] to sorted_particles[cell_starts[c + 1] - 1] and no cell has to be looked up in
+     * a hash map. The neighbors of all particles are stored in a compressed sparse row layout like in
+     * CsrNeighborhoodSearch3D and are built in parallel in two passes: first they are counted, then written.
+     */
+    class CompactGridNeighborhoodSearch : public Initializable, public Reportable {
+      public:
+        using particleIndex_t = size_t;
+
+        struct NeighborsIterator
+        {
+            const uint32_t* position_in_list = nullptr;
+            particleIndex_t current = 0;
+
+            bool operator==(const NeighborsIterator& other) const;
+
+            bool operator!=(const NeighborsIterator& other) const;
+
+            particleIndex_t& operator*();
+
+            NeighborsIterator& operator++();
+
+            const NeighborsIterator operator++(int);
+        };
+
+        struct Neighbors
+        {
+            friend class CompactGridNeighborhoodSearch;
+
+            // iterator defines
+            using T = particleIndex_t;
+            using iterator = NeighborsIterator;
+            using const_iterator = NeighborsIterator;
+            using difference_type = ptrdiff_t;
+            using size_type = size_t;
+            using value_type = T;
+            using pointer = T*;
+            using const_pointer = const T*;
+            using reference = T&;
+
+            // data
+            union {
+                glm::vec2 position;
+                particleIndex_t particle;
+            } of = {};
+            bool position_based = false;
+            CompactGridNeighborhoodSearch* data = nullptr;
+
+            NeighborsIterator begin() const;
+
+            NeighborsIterator end() const;
+
+            size_t size() const;
+
+          private:
+            const uint32_t* first = nullptr;
+            const uint32_t* last = nullptr;
+
+            // owns the neighbors of position based queries
+            std::shared_ptr<std::vector<uint32_t>> position_based_neighbors = nullptr;
+        };
+
+        std::shared_ptr<ParticleCollection> collection = nullptr;
+        float search_radius = 0.0f;
+
+        void find_neighbors();
+
+        Neighbors get_neighbors(particleIndex_t particleIndex);
+
+        Neighbors get_neighbors(const glm::vec2& position);
+
+        void initialize() override;
+
+        std::shared_ptr<NeighborhoodInterface> create_interface();
+
+        void create_compatibility_report(CompatibilityReport& report) override;
+
+      private:
+        // lower corner of the grid and the size of its cells, the cells are at least as large as the search radius
+        glm::vec2 grid_origin = glm::vec2(0.0f);
+        float cell_size = 0.0f;
+        int32_t cell_count_x = 0;
+        int32_t cell_count_y = 0;
+
+        // bounds the loop that enlarges the cells, e.g. if the search radius is too small for the extent of the grid
+        static constexpr size_t maximum_cell_size_doublings = 128;
+
+        void rebuild_grid();
+
+        int32_t calculate_cell_coordinate(float position, float origin, int32_t cell_count) const;
+
+        void find_neighbors_of_row(int32_t y, bool write_neighbors);
+
+        // calls the callable with each neighbor of the position until it returns false, the neighbors are not
+        // stored
+        template<typename Callable>
+        void for_each_neighbor_of_position(const glm::vec2& position, Callable&& callable) const;
+
+        // range of each cell inside sorted_particles, the cells are numbered row by row
+        std::vector<uint32_t> cell_starts;
+
+        // indices of all active particles, sorted by the cell they are contained in
+        std::vector<uint32_t> sorted_particles;
+
+        // positions of the particles in the order of sorted_particles
+        std::vector<glm::vec2> sorted_positions;
+
+        // cell of each particle, only valid for active particles
+        std::vector<uint32_t> particle_cells;
+
+        // particles per cell of each chunk of particles during the counting sort
+        std::vector<uint32_t> chunk_histograms;
+
+        std::vector<uint32_t> neighbor_offsets;
+        std::vector<uint32_t> neighbor_indices;
+    };
+
+
+} // namespace LibFluid
@@ -4,6 +4,7 @@
 #include "parallelization/StdParallelForEach.hpp"
 #include "LibFluidMath.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <libmorton/morton.h>
@@ -55,29 +56,41 @@ namespace LibFluid {
         return key;
     }
 
-    size_t CompressedNeighborhoodSearch::get_particle_index_by_cell_index(size_t cell_index) const {
-        std::function<size_t(size_t, size_t)> recursive_search = [&](size_t left, size_t right) -> size_t {
-            if (left >= cell_to_particle_map.size() || right == (size_t)(-1) || left == right) {
-                // could not find entry
-                return -1;
-            }
-
-            size_t middle = (right - left) / 2 + left;
-            FLUID_ASSERT(middle < cell_to_particle_map.size());
-
-            if (cell_to_particle_map[middle].cell_index > cell_index) {
-                // search in the left part
-                return recursive_search(left, middle);
-            } else if (cell_to_particle_map[middle].cell_index < cell_index) {
-                // search in the right part
-                return recursive_search(middle + 1, right);
-            } else {
-                // we found the cell index
-                return cell_to_particle_map[middle].index_of_first_particle;
+    void CompressedNeighborhoodSearch::build_cell_table() {
+        // the table is at most half full, which keeps the probe sequences short
+        size_t capacity_bits = 4;
+        while ((size_t(1) << capacity_bits) < 2 * cell_to_particle_map.size()) {
+            capacity_bits++;
+        }
+        cell_table_shift = 64 - capacity_bits;
+        cell_table.assign(size_t(1) << capacity_bits, {empty_cell_table_entry, 0});
+
+        size_t mask = cell_table.size() - 1;
+        for (size_t i = 0; i < cell_to_particle_map.size(); i++) {
+            uint64_t cell_index = cell_to_particle_map[i].cell_index;
+            size_t slot = (cell_index * 0x9E3779B97F4A7C15ull) >> cell_table_shift;
+            while (cell_table[slot].cell_index != empty_cell_table_entry) {
+                slot = (slot + 1) & mask;
             }
-        };
+            cell_table[slot] = {cell_index, (uint32_t)i};
+        }
+    }
 
-        return recursive_search(0, cell_to_particle_map.size());
+    const CompressedNeighborhoodSearch::GridCellToParticle* CompressedNeighborhoodSearch::find_cell(
+            uint64_t cell_index) const {
+        if (cell_table.empty())
+            return nullptr;
+
+        size_t mask = cell_table.size() - 1;
+        size_t slot = (cell_index * 0x9E3779B97F4A7C15ull) >> cell_table_shift;
+        while (true) {
+            const auto& entry = cell_table[slot];
+            if (entry.cell_index == cell_index)
+                return &cell_to_particle_map[entry.map_index];
+            if (entry.cell_index == empty_cell_table_entry)
+                return nullptr;
+            slot = (slot + 1) & mask;
+        }
     }
 
     void CompressedNeighborhoodSearch::initialize() {
@@ -87,6 +100,7 @@ namespace LibFluid {
         if (!collection->is_type_present<NeighborStorage>()) {
             collection->add_type<NeighborStorage>();
         }
+        sorted_collection_size = 0;
     }
 
     std::shared_ptr<NeighborhoodInterface> CompressedNeighborhoodSearch::create_interface() {
@@ -162,6 +176,26 @@ namespace LibFluid {
             return this->search_radius;
         };
 
+        res->link.for_each_by_index = [this](particleIndex_t index, NeighborhoodInterface::NeighborCallback callback) {
+            for (particleIndex_t neighbor : this->get_neighbors(index)) {
+                if (!callback(neighbor))
+                    return;
+            }
+        };
+
+        auto for_each_by_position = [this](const glm::vec3& position,
+                                           NeighborhoodInterface::NeighborCallback callback) {
+            for (particleIndex_t neighbor : this->get_neighbors(position)) {
+                if (!callback(neighbor))
+                    return;
+            }
+        };
+        res->link.for_each_by_position_3d = for_each_by_position;
+        res->link.gather_by_position_3d = [for_each_by_position](const glm::vec3* positions, size_t count,
+                std::vector<size_t>& offsets, std::vector<particleIndex_t>& indices) {
+            NeighborhoodInterface::gather_neighbors_with(for_each_by_position, positions, count, offsets, indices);
+        };
+
         return res;
     }
 
@@ -170,73 +204,165 @@ namespace LibFluid {
         FLUID_ASSERT(collection->is_type_present<ParticleInformation>());
         FLUID_ASSERT(collection->is_type_present<NeighborStorage>());
 
-        // calculate grid cell and cell index of each particle
-        parallel::loop_for(0, collection->size(), [&](size_t particle_index) {
-            const auto& particle_info = collection->get<ParticleInfo>(particle_index);
-            auto& information = collection->get<ParticleInformation>(particle_index);
-            if (particle_info.type == ParticleTypeInactive) {
-                information.cell_index = -1;
-                information.first_particle_of_cell = false;
-                information.cell_location = GridCellLocation::undefined();
-                return;
+        // calculate grid cell and cell index of each particle and detect the particles that changed their cell
+        cell_changed.resize(collection->size());
+        size_t changed_particles = parallel::reduce(
+                0, collection->size(), size_t(0),
+                [&](size_t particle_index) -> size_t {
+                    const auto& particle_info = collection->get<ParticleInfo>(particle_index);
+                    auto& information = collection->get<ParticleInformation>(particle_index);
+                    size_t previous_cell_index = information.cell_index;
+
+                    if (particle_info.type == ParticleTypeInactive) {
+                        information.cell_index = -1;
+                        information.first_particle_of_cell = false;
+                        information.cell_location = GridCellLocation::undefined();
+                    } else {
+                        const auto& mv = collection->get<MovementData3D>(particle_index);
+                        information.cell_location = calculate_grid_cell_location_of_position(mv.position);
+                        information.cell_index = calculate_cell_index_by_cell_location(information.cell_location);
+                    }
+
+                    cell_changed[particle_index] = information.cell_index != previous_cell_index;
+                    return cell_changed[particle_index];
+                },
+                [](size_t a, size_t b) { return a + b; });
+
+        // sort particles according to cell index, if the particles were sorted before and only few of them changed
+        // their cell, the sorting is done incrementally and an unchanged order keeps the cell map as it is
+        bool sorted_before = sorted_collection_size == collection->size();
+        bool still_sorted = sorted_before && changed_particles == 0 && is_sorted_by_cell_index();
+        if (!still_sorted) {
+            bool sorted_incrementally = sorted_before &&
+                    changed_particles * incremental_sort_ratio <= collection->size() && sort_incrementally();
+
+            if (!sorted_incrementally) {
+                ParticleCollectionAlgorithm::Sort sorter;
+
+                sorter.radix_sort(
+                        collection,
+                        [](const std::shared_ptr<ParticleCollection>& collection, const size_t index) -> uint64_t {
+                            auto& information = collection->get<ParticleInformation>(index);
+                            return information.cell_index;
+                        });
             }
 
-            const auto& mv = collection->get<MovementData3D>(particle_index);
+            build_cell_to_particle_map();
+            sorted_collection_size = collection->size();
+        }
+
+        // find neighbors of each particle, the surrounding cells are the same for all particles of a cell
+        parallel::loop_for(0, cell_to_particle_map.size(), [&](size_t c) {
+            const auto& cell = cell_to_particle_map[c];
 
-            information.first_particle_of_cell = false;
-            information.cell_location = calculate_grid_cell_location_of_position(mv.position);
-            information.cell_index = calculate_cell_index_by_cell_location(information.cell_location);
+            NeighboringCells neighboring_cells;
+            size_t neighboring_cell_count = collect_neighboring_cells(cell.cell_location, neighboring_cells);
+
+            for (size_t particle_index = cell.index_of_first_particle; particle_index < cell.index_of_end_particle;
+                    particle_index++) {
+                const auto& mv_particle = collection->get<MovementData3D>(particle_index);
+                auto& storage = collection->get<NeighborStorage>(particle_index);
+
+                save_neighbors_in_storage(mv_particle.position, neighboring_cells, neighboring_cell_count, storage);
+            }
         });
+    }
 
-        // sort particles according to cell index
-        {
-            ParticleCollectionAlgorithm::Sort sorter;
-
-            sorter.quick_sort_stable<false, true>(
-                    collection,
-                    [](const std::shared_ptr<ParticleCollection>& collection, const size_t index) -> uint64_t {
-                        auto& information = collection->get<ParticleInformation>(index);
-                        return information.cell_index;
-                    });
+    bool CompressedNeighborhoodSearch::sort_incrementally() {
+        size_t size = collection->size();
+        auto cell_index_of = [&](uint32_t particle_index) {
+            return collection->get<ParticleInformation>(particle_index).cell_index;
+        };
+
+        particles_changing_cell.clear();
+        for (size_t particle_index = 0; particle_index < size; particle_index++) {
+            if (cell_changed[particle_index]) {
+                particles_changing_cell.push_back(particle_index);
+            }
         }
+        std::stable_sort(particles_changing_cell.begin(), particles_changing_cell.end(),
+                [&](uint32_t a, uint32_t b) { return cell_index_of(a) < cell_index_of(b); });
+
+        // merge both sequences, particles of the same cell keep their relative order like in a stable sort
+        sort_permutation.resize(size);
+        size_t next_changed = 0;
+        size_t next_unchanged = 0;
+        size_t previous_unchanged_cell_index = 0;
+        size_t moved_particles = 0;
+        for (size_t target = 0; target < size; target++) {
+            while (next_unchanged < size && cell_changed[next_unchanged]) {
+                next_unchanged++;
+            }
 
-        // build map that maps cell to cell start
-        {
-            cell_to_particle_map.clear();
-            for (size_t particle_index = 0; particle_index < collection->size(); particle_index++) {
-                const auto& particle_info = collection->get<ParticleInfo>(particle_index);
-                if (particle_info.type == ParticleTypeInactive) {
-                    break;
-                }
+            bool take_changed;
+            if (next_changed == particles_changing_cell.size()) {
+                take_changed = false;
+            } else if (next_unchanged == size) {
+                take_changed = true;
+            } else {
+                uint32_t changed = particles_changing_cell[next_changed];
+                size_t changed_cell_index = cell_index_of(changed);
+                size_t unchanged_cell_index = cell_index_of(next_unchanged);
+                take_changed = changed_cell_index < unchanged_cell_index ||
+                        (changed_cell_index == unchanged_cell_index && changed < next_unchanged);
+            }
 
-                auto& information = collection->get<ParticleInformation>(particle_index);
-                if (particle_index == 0) {
-                    information.first_particle_of_cell = true;
-                    cell_to_particle_map.push_back({information.cell_location, particle_index, information.cell_index});
-                    continue;
+            uint32_t source;
+            if (take_changed) {
+                source = particles_changing_cell[next_changed++];
+            } else {
+                source = next_unchanged++;
+                if (cell_index_of(source) < previous_unchanged_cell_index) {
+                    // the collection was reordered by someone else since the last sort
+                    return false;
                 }
+                previous_unchanged_cell_index = cell_index_of(source);
+            }
 
-                const auto& prev_information = collection->get<ParticleInformation>(particle_index - 1);
-                if (prev_information.cell_index != information.cell_index) {
-                    information.first_particle_of_cell = true;
-                    cell_to_particle_map.push_back({information.cell_location, particle_index, information.cell_index});
-                }
+            sort_permutation[target] = source;
+            if (source != target) {
+                moved_particles++;
             }
         }
 
-        // find neighbors of each particle
-        {
-            parallel::loop_for(0, collection->size(), [&](size_t particle_index) {
-                const auto& pi = collection->get<ParticleInfo>(particle_index);
-                if (pi.type == ParticleTypeInactive) {
-                    return;
-                }
-                const auto& mv_particle = collection->get<MovementData3D>(particle_index);
-                auto& storage = collection->get<NeighborStorage>(particle_index);
+        if (moved_particles > 0) {
+            collection->reorder(sort_permutation);
+        }
+        return true;
+    }
 
-                find_neighbors_and_save_in_storage(mv_particle.position, storage);
-            });
+    bool CompressedNeighborhoodSearch::is_sorted_by_cell_index() const {
+        // detects whether the collection was reordered by someone else since the last sort
+        size_t descents = parallel::reduce(
+                1, collection->size(), size_t(0),
+                [&](size_t particle_index) -> size_t {
+                    return collection->get<ParticleInformation>(particle_index).cell_index <
+                            collection->get<ParticleInformation>(particle_index - 1).cell_index;
+                },
+                [](size_t a, size_t b) { return a + b; });
+        return descents == 0;
+    }
+
+    void CompressedNeighborhoodSearch::build_cell_to_particle_map() {
+        cell_to_particle_map.clear();
+        for (size_t particle_index = 0; particle_index < collection->size(); particle_index++) {
+            const auto& particle_info = collection->get<ParticleInfo>(particle_index);
+            if (particle_info.type == ParticleTypeInactive) {
+                break;
+            }
+
+            auto& information = collection->get<ParticleInformation>(particle_index);
+            information.first_particle_of_cell = particle_index == 0 ||
+                    collection->get<ParticleInformation>(particle_index - 1).cell_index != information.cell_index;
+            if (information.first_particle_of_cell) {
+                cell_to_particle_map.push_back(
+                        {information.cell_location, particle_index, information.cell_index, particle_index + 1});
+            } else {
+                cell_to_particle_map.back().index_of_end_particle = particle_index + 1;
+            }
         }
+
+        build_cell_table();
     }
 
     CompressedNeighborhoodSearch::Neighbors CompressedNeighborhoodSearch::get_neighbors(particleIndex_t particleIndex) {
@@ -258,13 +384,24 @@ namespace LibFluid {
 
 
     void CompressedNeighborhoodSearch::NeighborStorage::clear() {
-        control_sequence.reset();
+        std::memset(control_sequence, 0, sizeof(control_sequence));
         current_deltas_byte_size = 0;
         size_value = 0;
         first_neighbor = -1;
-        for (size_t i = 0; i < DELTAS_SIZE; i++) {
-            deltas[i] = 0;
-        }
+        std::memset(deltas, 0, sizeof(deltas));
+    }
+
+    uint8_t CompressedNeighborhoodSearch::NeighborStorage::get_control(size_t delta_index) const {
+        FLUID_ASSERT(delta_index < MAX_DELTAS);
+        return (control_sequence[delta_index / 4] >> ((delta_index % 4) * 2)) & 0b11;
+    }
+
+    void CompressedNeighborhoodSearch::NeighborStorage::set_control(size_t delta_index, uint8_t control) {
+        FLUID_ASSERT(delta_index < MAX_DELTAS);
+        FLUID_ASSERT(control <= 0b11);
+        size_t shift = (delta_index % 4) * 2;
+        uint8_t& control_byte = control_sequence[delta_index / 4];
+        control_byte = (uint8_t)((control_byte & ~(0b11 << shift)) | (control << shift));
     }
 
     void CompressedNeighborhoodSearch::NeighborStorage::set_first_neighbor(size_t index) {
@@ -277,21 +414,18 @@ namespace LibFluid {
         FLUID_ASSERT(size_value - 1 < MAX_DELTAS);
         FLUID_ASSERT(delta_to_previous_neighbor != 0);
 
-        size_t bit_pair_index = size_value - 1;
+        size_t delta_index = size_value - 1;
         if (delta_to_previous_neighbor == 1) {
             // zero byte representation
-            control_sequence.set(bit_pair_index * 2 + 0, false);
-            control_sequence.set(bit_pair_index * 2 + 1, false);
+            set_control(delta_index, 0b00);
         } else if (delta_to_previous_neighbor == 2) {
             // zero byte representation
-            control_sequence.set(bit_pair_index * 2 + 0, false);
-            control_sequence.set(bit_pair_index * 2 + 1, true);
+            set_control(delta_index, 0b10);
         } else if (delta_to_previous_neighbor <= 256 + 2) {
             FLUID_ASSERT(current_deltas_byte_size < DELTAS_SIZE);
 
             // one byte representation of the delta
-            control_sequence.set(bit_pair_index * 2 + 0, true);
-            control_sequence.set(bit_pair_index * 2 + 1, false);
+            set_control(delta_index, 0b01);
 
             // save a 8 bit unsigned integer inside the delta array
             // note that we subtract the already covered range to allow for larger delta values this 8 bits can
@@ -302,8 +436,7 @@ namespace LibFluid {
             FLUID_ASSERT(current_deltas_byte_size + 3 < DELTAS_SIZE);
 
             // four byte representation of the delta
-            control_sequence.set(bit_pair_index * 2 + 0, true);
-            control_sequence.set(bit_pair_index * 2 + 1, true);
+            set_control(delta_index, 0b11);
 
             // save a 32 bit unsigned integer inside the delta array
             // note that we subtract the already covered range to allow for larger delta values this 32 bits can
@@ -334,48 +467,121 @@ namespace LibFluid {
 
     uint32_t CompressedNeighborhoodSearch::NeighborStorage::get_delta(size_t delta_index) const {
         FLUID_ASSERT(delta_index < MAX_DELTAS);
-        if (control_sequence[delta_index * 2 + 0] == false) {
-            if (control_sequence[delta_index * 2 + 1] == false) {
+
+        size_t starting_byte_index = 0;
+        // we have to determine the byte position
+        for (size_t i = 0; i < delta_index; i++) {
+            uint8_t control = get_control(i);
+            if ((control & 0b01) == 0) {
+                // this sequence does not need any bytes to store its information
+                continue;
+            }
+
+            if ((control & 0b10) == 0) {
+                // this sequence takes one byte to store its information
+                starting_byte_index += 1;
+            } else {
+                // this sequence takes four bytes to store its information
+                starting_byte_index += 4;
+            }
+        }
+
+        return decode_delta(delta_index, starting_byte_index);
+    }
+
+    uint32_t CompressedNeighborhoodSearch::NeighborStorage::decode_delta(size_t delta_index, size_t& byte_offset) const {
+        uint8_t control = get_control(delta_index);
+        if ((control & 0b01) == 0) {
+            if ((control & 0b10) == 0) {
                 return 1;
             } else {
                 return 2;
             }
+        }
+
+        if ((control & 0b10) == 0) {
+            // the delta value is represented by one byte
+            FLUID_ASSERT(byte_offset < DELTAS_SIZE);
+            return deltas[byte_offset++] + 3;
         } else {
-            size_t starting_byte_index = 0;
-            // we have to determine the byte position
-            for (size_t i = 0; i < delta_index; i++) {
-                if (control_sequence[i * 2 + 0] == false) {
-                    // this sequence does not need any bytes to store its information
-                    continue;
-                }
+            // the delta value is represented by four bytes
+            FLUID_ASSERT(byte_offset + 3 < DELTAS_SIZE);
+
+            uint32_t value = uint32_t((uint8_t)(deltas[byte_offset + 3]) << 24 |
+                    (uint8_t)(deltas[byte_offset + 2]) << 16 |
+                    (uint8_t)(deltas[byte_offset + 1]) << 8 |
+                    (uint8_t)(deltas[byte_offset + 0]));
+            value = value + 3 + 256;
+            FLUID_ASSERT(value != std::numeric_limits<uint32_t>::max());
+            byte_offset += 4;
+            return value;
+        }
+    }
+
+    namespace {
+        // byte offsets of the four deltas of a control byte relative to the first byte of the first delta, as well
+        // as the amount of bytes that the four deltas occupy
+        struct ControlByteLayout
+        {
+            uint8_t offsets[4];
+            uint8_t byte_count;
+        };
 
-                if (control_sequence[i * 2 + 1] == false) {
-                    // this sequence takes one byte to store its information
-                    starting_byte_index += 1;
-                } else {
-                    // this sequence takes four bytes to store its information
-                    starting_byte_index += 4;
+        constexpr std::array<ControlByteLayout, 256> create_control_byte_layouts() {
+            std::array<ControlByteLayout, 256> layouts = {};
+            for (size_t control_byte = 0; control_byte < 256; control_byte++) {
+                uint8_t offset = 0;
+                for (size_t k = 0; k < 4; k++) {
+                    size_t control = (control_byte >> (k * 2)) & 0b11;
+                    layouts[control_byte].offsets[k] = offset;
+                    offset += control == 0b01 ? 1 : (control == 0b11 ? 4 : 0);
                 }
+                layouts[control_byte].byte_count = offset;
             }
+            return layouts;
+        }
 
+        constexpr std::array<ControlByteLayout, 256> control_byte_layouts = create_control_byte_layouts();
 
-            if (control_sequence[delta_index * 2 + 1] == false) {
-                // the delta value is represented by one byte
-                FLUID_ASSERT(starting_byte_index < DELTAS_SIZE);
-                return deltas[starting_byte_index] + 3;
-            } else {
-                // the delta value is represented by four bytes
-                FLUID_ASSERT(starting_byte_index + 3 < DELTAS_SIZE);
-
-                uint32_t value = uint32_t((uint8_t)(deltas[starting_byte_index + 3]) << 24 |
-                        (uint8_t)(deltas[starting_byte_index + 2]) << 16 |
-                        (uint8_t)(deltas[starting_byte_index + 1]) << 8 |
-                        (uint8_t)(deltas[starting_byte_index + 0]));
-                value = value + 3 + 256;
-                FLUID_ASSERT(value != std::numeric_limits<uint32_t>::max());
-                return value;
+        // the delta is base + (the four bytes at its offset & mask), indexed by the two control bits of the delta
+        constexpr uint32_t control_delta_base[4] = {1, 3, 2, 256 + 3};
+        constexpr uint32_t control_delta_mask[4] = {0, 0xff, 0, 0xffffffff};
+
+        inline uint32_t load_four_bytes(const uint8_t* bytes) {
+            return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+        }
+    } // namespace
+
+    size_t CompressedNeighborhoodSearch::NeighborStorage::decode_into(uint32_t* out) const {
+        if (size_value == 0)
+            return 0;
+
+        uint32_t current = first_neighbor;
+        out[0] = current;
+
+        // the deltas of the full control bytes are decoded four at a time, the offsets never exceed the used delta
+        // bytes, hence the four byte loads stay within the padded delta storage
+        size_t delta_count = size_value - 1;
+        size_t byte_offset = 0;
+        size_t i = 0;
+        for (; i + 4 <= delta_count; i += 4) {
+            uint8_t control_byte = control_sequence[i / 4];
+            const ControlByteLayout& layout = control_byte_layouts[control_byte];
+            for (size_t k = 0; k < 4; k++) {
+                size_t control = (control_byte >> (k * 2)) & 0b11;
+                uint32_t bytes = load_four_bytes(deltas + byte_offset + layout.offsets[k]);
+                current += control_delta_base[control] + (bytes & control_delta_mask[control]);
+                out[i + k + 1] = current;
             }
+            byte_offset += layout.byte_count;
+        }
+
+        // the remaining deltas only fill a part of the last control byte
+        for (; i < delta_count; i++) {
+            current += decode_delta(i, byte_offset);
+            out[i + 1] = current;
         }
+        return size_value;
     }
 
     CompressedNeighborhoodSearch::NeighborsIterator CompressedNeighborhoodSearch::Neighbors::begin() const {
@@ -410,6 +616,17 @@ namespace LibFluid {
         return iterator;
     }
 
+    size_t CompressedNeighborhoodSearch::Neighbors::decode_into(uint32_t* out) const {
+        FLUID_ASSERT(data != nullptr);
+        FLUID_ASSERT(data->collection != nullptr);
+
+        if (position_based) {
+            return internal_storage.decode_into(out);
+        }
+        FLUID_ASSERT(of.particle < data->collection->size());
+        return data->collection->get<NeighborStorage>(of.particle).decode_into(out);
+    }
+
     CompressedNeighborhoodSearch::NeighborsIterator CompressedNeighborhoodSearch::Neighbors::end() const {
         FLUID_ASSERT(data != nullptr);
         FLUID_ASSERT(data->collection != nullptr);
@@ -459,7 +676,7 @@ namespace LibFluid {
             const auto& storage = compressed->collection->get<NeighborStorage>(data->of.particle);
             current_counter++;
             if (current_counter < storage.size()) {
-                size_t delta = storage.get_delta(current_counter - 1);
+                size_t delta = storage.decode_delta(current_counter - 1, current_byte_offset);
                 current += delta;
 
                 FLUID_ASSERT(current < compressed->collection->size());
@@ -472,7 +689,7 @@ namespace LibFluid {
             const auto& storage = data->internal_storage;
             current_counter++;
             if (current_counter < storage.size()) {
-                size_t delta = storage.get_delta(current_counter - 1);
+                size_t delta = storage.decode_delta(current_counter - 1, current_byte_offset);
                 current += delta;
 
                 FLUID_ASSERT(current < compressed->collection->size());
@@ -491,37 +708,37 @@ namespace LibFluid {
 
     CompressedNeighborhoodSearch::NeighborStorage::NeighborStorage(const NeighborStorage& c) {
         first_neighbor = c.first_neighbor;
-        control_sequence = c.control_sequence;
+        std::memcpy(control_sequence, c.control_sequence, sizeof(control_sequence));
         size_value = c.size_value;
         current_deltas_byte_size = c.current_deltas_byte_size;
-        std::memcpy(deltas, c.deltas, DELTAS_SIZE * sizeof(uint8_t));
+        std::memcpy(deltas, c.deltas, sizeof(deltas));
     }
 
     CompressedNeighborhoodSearch::NeighborStorage::NeighborStorage(NeighborStorage&& c) {
         first_neighbor = c.first_neighbor;
-        control_sequence = c.control_sequence;
+        std::memcpy(control_sequence, c.control_sequence, sizeof(control_sequence));
         size_value = c.size_value;
         current_deltas_byte_size = c.current_deltas_byte_size;
-        std::memcpy(deltas, c.deltas, DELTAS_SIZE * sizeof(uint8_t));
+        std::memcpy(deltas, c.deltas, sizeof(deltas));
     }
 
     CompressedNeighborhoodSearch::NeighborStorage& CompressedNeighborhoodSearch::NeighborStorage::operator=(
             NeighborStorage&& c) {
         first_neighbor = c.first_neighbor;
-        control_sequence = c.control_sequence;
+        std::memcpy(control_sequence, c.control_sequence, sizeof(control_sequence));
         size_value = c.size_value;
         current_deltas_byte_size = c.current_deltas_byte_size;
-        std::memcpy(deltas, c.deltas, DELTAS_SIZE * sizeof(uint8_t));
+        std::memcpy(deltas, c.deltas, sizeof(deltas));
         return *this;
     }
 
     CompressedNeighborhoodSearch::NeighborStorage& CompressedNeighborhoodSearch::NeighborStorage::operator=(
             const NeighborStorage& c) {
         first_neighbor = c.first_neighbor;
-        control_sequence = c.control_sequence;
+        std::memcpy(control_sequence, c.control_sequence, sizeof(control_sequence));
         size_value = c.size_value;
         current_deltas_byte_size = c.current_deltas_byte_size;
-        std::memcpy(deltas, c.deltas, DELTAS_SIZE * sizeof(uint8_t));
+        std::memcpy(deltas, c.deltas, sizeof(deltas));
         return *this;
     }
 
@@ -533,47 +750,44 @@ namespace LibFluid {
         data->find_neighbors_and_save_in_storage(of.position, internal_storage);
     }
 
-    void CompressedNeighborhoodSearch::find_neighbors_and_save_in_storage(const glm::vec3& position,
-            NeighborStorage& storage) {
-        FLUID_ASSERT(collection != nullptr);
-
-        auto cell_location = calculate_grid_cell_location_of_position(position);
-
-        // determine the cells that need to be checked
-        std::array<size_t, 27> cell_indices_to_check;
-        size_t i = 0;
+    size_t CompressedNeighborhoodSearch::collect_neighboring_cells(const GridCellLocation& cell_location,
+            NeighboringCells& cells) const {
+        size_t cell_count = 0;
         for (int x = -1; x <= 1; x++) {
             for (int y = -1; y <= 1; y++) {
                 for (int z = -1; z <= 1; z++) {
-                    FLUID_ASSERT(i < cell_indices_to_check.size());
-
-                    cell_indices_to_check[i] = calculate_cell_index_by_cell_location({
+                    auto cell = find_cell(calculate_cell_index_by_cell_location({
                             cell_location.x + x,
                             cell_location.y + y,
                             cell_location.z + z,
-                    });
-                    i++;
+                    }));
+                    if (cell == nullptr) {
+                        // the cell is empty and therefore non existant
+                        continue;
+                    }
+                    cells[cell_count++] = {cell->index_of_first_particle, cell->index_of_end_particle};
                 }
             }
         }
-        std::sort(cell_indices_to_check.begin(), cell_indices_to_check.end());
 
+        // the morton order of the surrounding cells depends on the cell location, the particles of the cells are
+        // sorted by it, hence ordering the ranges by their first particle yields ascending neighbor indices
+        std::sort(cells.begin(), cells.begin() + cell_count,
+                [](const ParticleRange& a, const ParticleRange& b) { return a.begin < b.begin; });
+        return cell_count;
+    }
+
+    void CompressedNeighborhoodSearch::save_neighbors_in_storage(const glm::vec3& position,
+            const NeighboringCells& cells, size_t cell_count, NeighborStorage& storage) {
         storage.clear();
         size_t last_neighbor = -1;
-        size_t delta_counter = 0;
-
-        for (size_t i = 0; i < cell_indices_to_check.size(); i++) {
-            size_t first_particle_index = get_particle_index_by_cell_index(cell_indices_to_check[i]);
-            if (first_particle_index == (size_t)(-1)) {
-                // the cell is empty and therefore non existant
-                continue;
-            }
+        float search_radius_squared = Math::pow2(search_radius);
 
-            size_t current_particle = first_particle_index;
-            while (cell_indices_to_check[i] == collection->get<ParticleInformation>(current_particle).cell_index) {
+        for (size_t c = 0; c < cell_count; c++) {
+            for (size_t current_particle = cells[c].begin; current_particle < cells[c].end; current_particle++) {
                 const auto& mv_current = collection->get<MovementData3D>(current_particle);
                 auto diff = mv_current.position - position;
-                if (glm::dot(diff, diff) <= Math::pow2(search_radius)) {
+                if (glm::dot(diff, diff) <= search_radius_squared) {
                     // the particles are neighbors
                     if (last_neighbor == (size_t)(-1)) {
                         last_neighbor = current_particle;
@@ -583,15 +797,20 @@ namespace LibFluid {
                         size_t delta = current_particle - last_neighbor;
                         storage.set_next_neighbor(delta);
                         last_neighbor = current_particle;
-                        delta_counter++;
                     }
                 }
-                current_particle++;
-                if (current_particle >= collection->size()) {
-                    break;
-                }
             }
         }
     }
 
+    void CompressedNeighborhoodSearch::find_neighbors_and_save_in_storage(const glm::vec3& position,
+            NeighborStorage& storage) {
+        FLUID_ASSERT(collection != nullptr);
+
+        NeighboringCells neighboring_cells;
+        size_t neighboring_cell_count =
+                collect_neighboring_cells(calculate_grid_cell_location_of_position(position), neighboring_cells);
+        save_neighbors_in_storage(position, neighboring_cells, neighboring_cell_count, storage);
+    }
+
 } // namespace FluidSolver
@@ -6,7 +6,8 @@
 #include "helpers/Initializable.hpp"
 #include "helpers/Reportable.hpp"
 
-#include <bitset>
+#include <array>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -33,12 +34,32 @@ namespace LibFluid {
 
             static constexpr size_t MAX_CONTROLS = MAX_DELTAS * 2;
 
+            // the delta storage is followed by this many bytes, such that four bytes can be loaded at any byte offset
+            static constexpr size_t DELTAS_PADDING = 3;
+
 
             void clear();
             void set_first_neighbor(size_t index);
             void set_next_neighbor(size_t delta_to_previous_neighbor);
             size_t size() const;
             uint32_t get_delta(size_t delta_index) const;
+
+            /**
+             * @brief Decodes the delta at delta_index, whose bytes start at byte_offset, and advances byte_offset
+             * to the bytes of the following delta. Decoding all deltas in order this way takes constant time per
+             * delta, whereas get_delta has to determine the byte offset first.
+             */
+            uint32_t decode_delta(size_t delta_index, size_t& byte_offset) const;
+
+            /**
+             * @brief Writes all size() neighbor indices in ascending order to out.
+             *
+             * Four deltas share a control byte, hence they are decoded together: a lookup table yields the byte
+             * offsets of the four deltas from the control byte, and each delta is obtained without branches by
+             * masking a four byte load at its offset.
+             * @return The amount of written indices.
+             */
+            size_t decode_into(uint32_t* out) const;
             uint32_t get_first_neighbor() const;
             size_t get_used_delta_bytes() const;
 
@@ -51,8 +72,15 @@ namespace LibFluid {
 
           private:
             size_t first_neighbor;
-            std::bitset<MAX_CONTROLS> control_sequence;
-            uint8_t deltas[DELTAS_SIZE];
+
+            // two control bits per delta, four deltas share a byte: without the lower bit the delta is one or, if
+            // the upper bit is set, two; with the lower bit the delta is stored in one or, if the upper bit is set,
+            // four bytes
+            uint8_t control_sequence[MAX_CONTROLS / 8];
+            uint8_t deltas[DELTAS_SIZE + DELTAS_PADDING];
+
+            uint8_t get_control(size_t delta_index) const;
+            void set_control(size_t delta_index, uint8_t control);
 
 
             size_t size_value;
@@ -69,6 +97,9 @@ namespace LibFluid {
             particleIndex_t current = 0;
             size_t current_counter = 0;
 
+            // byte offset of the next delta in the delta storage
+            size_t current_byte_offset = 0;
+
             bool operator==(const NeighborsIterator& other) const;
 
             bool operator!=(const NeighborsIterator& other) const;
@@ -108,6 +139,16 @@ namespace LibFluid {
 
             NeighborsIterator end() const;
 
+            // maximum amount of indices that decode_into writes
+            static constexpr size_t max_size = NeighborStorage::MAX_DELTAS + 1;
+
+            /**
+             * @brief Writes all neighbor indices in ascending order to out, which has to provide space for max_size
+             * indices.
+             * @return The amount of written indices.
+             */
+            size_t decode_into(uint32_t* out) const;
+
           private:
             void calculate_position_based_neighbors();
             NeighborStorage internal_storage;
@@ -170,11 +211,69 @@ namespace LibFluid {
             GridCellLocation cell_location;
             size_t index_of_first_particle;
             size_t cell_index;
+
+            // index after the last particle of the cell
+            size_t index_of_end_particle;
         };
 
         std::vector<GridCellToParticle> cell_to_particle_map;
 
-        size_t get_particle_index_by_cell_index(size_t cell_index) const;
+        // open addressing hash table with linear probing, which maps the cell index to the entry of the cell in
+        // cell_to_particle_map
+        struct CellTableEntry
+        {
+            uint64_t cell_index;
+            uint32_t map_index;
+        };
+
+        static constexpr uint64_t empty_cell_table_entry = std::numeric_limits<uint64_t>::max();
+
+        std::vector<CellTableEntry> cell_table;
+        size_t cell_table_shift = 0;
+
+        struct ParticleRange
+        {
+            size_t begin;
+            size_t end;
+        };
+
+        using NeighboringCells = std::array<ParticleRange, 27>;
+
+        // the collection is re-sorted incrementally if at most one in incremental_sort_ratio particles changed its cell
+        static constexpr size_t incremental_sort_ratio = 10;
+
+        // size of the collection after it was sorted the last time, zero if it has to be sorted completely
+        size_t sorted_collection_size = 0;
+
+        // marks the particles whose cell index changed since the last call of find_neighbors
+        std::vector<uint8_t> cell_changed;
+        std::vector<uint32_t> particles_changing_cell;
+        std::vector<uint32_t> sort_permutation;
+
+        /**
+         * @brief Sorts the particles that changed their cell by their cell index and merges them into the remaining
+         * particles, which are still sorted from the last call.
+         * @return False if the remaining particles turned out not to be sorted, the collection is unchanged then.
+         */
+        bool sort_incrementally();
+
+        bool is_sorted_by_cell_index() const;
+
+        void build_cell_to_particle_map();
+
+        void build_cell_table();
+
+        const GridCellToParticle* find_cell(uint64_t cell_index) const;
+
+        /**
+         * @brief Collects the particle ranges of the non empty cells around the cell location, ordered by their
+         * position in the collection. Hence the particles of the ranges are visited in ascending order.
+         * @return The amount of collected ranges.
+         */
+        size_t collect_neighboring_cells(const GridCellLocation& cell_location, NeighboringCells& cells) const;
+
+        void save_neighbors_in_storage(const glm::vec3& position, const NeighboringCells& cells, size_t cell_count,
+                NeighborStorage& storage);
 
         void find_neighbors_and_save_in_storage(const glm::vec3& position, NeighborStorage& storage);
     };
@@ -0,0 +1,332 @@
+#include "CsrNeighborhoodSearch3D.hpp"
+
+#include "fluidSolver/ParticleCollectionAlgorithm.hpp"
+#include "parallelization/StdParallelForEach.hpp"
+
+#include <algorithm>
+#include <libmorton/morton.h>
+
+namespace LibFluid {
+
+    using parallel = StdParallelForEach;
+
+    void CsrNeighborhoodSearch3D::initialize() {
+        FLUID_ASSERT(collection != nullptr);
+    }
+
+    void CsrNeighborhoodSearch3D::create_compatibility_report(CompatibilityReport& report) {
+        report.begin_scope(FLUID_NAMEOF(CsrNeighborhoodSearch3D));
+        if (collection == nullptr) {
+            report.add_issue("ParticleCollection is null.");
+        } else {
+            if (!collection->is_type_present<MovementData3D>()) {
+                report.add_issue("Particles are missing the MovementData3D attribute.");
+            }
+            if (!collection->is_type_present<ParticleInfo>()) {
+                report.add_issue("Particles are missing the ParticleInfo attribute.");
+            }
+            if (collection->size() >= std::numeric_limits<uint32_t>::max()) {
+                report.add_issue("Too many particles, the particle indices have to fit into 32 bits.");
+            }
+        }
+
+        if (search_radius <= 0.0f) {
+            report.add_issue("Search radius is smaller or equal to zero.");
+        }
+
+        report.end_scope();
+    }
+
+    CsrNeighborhoodSearch3D::GridCellLocation CsrNeighborhoodSearch3D::calculate_grid_cell_location_of_position(
+            const glm::vec3& position) const {
+        return {(int)std::floor(position.x / search_radius), (int)std::floor(position.y / search_radius),
+                (int)std::floor(position.z / search_radius)};
+    }
+
+    uint64_t CsrNeighborhoodSearch3D::calculate_cell_index_by_cell_location(const GridCellLocation& location) {
+        auto transform_into_unsigned = [](int32_t v) -> uint32_t {
+            int64_t v2 = (int64_t)v;
+            v2 -= std::numeric_limits<int32_t>::min();
+            uint32_t res = (uint32_t)v2;
+            return res;
+        };
+
+        return libmorton::morton3D_64_encode(transform_into_unsigned(location.x), transform_into_unsigned(location.y),
+                transform_into_unsigned(location.z));
+    }
+
+    const CsrNeighborhoodSearch3D::GridCell* CsrNeighborhoodSearch3D::find_cell(uint64_t cell_index) const {
+        auto it = std::lower_bound(cells.begin(), cells.end(), cell_index,
+                [](const GridCell& cell, uint64_t index) { return cell.cell_index < index; });
+        if (it == cells.end() || it->cell_index != cell_index)
+            return nullptr;
+        return &(*it);
+    }
+
+    void CsrNeighborhoodSearch3D::rebuild_grid() {
+        FLUID_ASSERT(collection != nullptr);
+        FLUID_ASSERT(collection->is_type_present<MovementData3D>());
+        FLUID_ASSERT(collection->is_type_present<ParticleInfo>());
+        FLUID_ASSERT(search_radius > 0.0f);
+
+        // inactive particles get the largest key, morton codes of cells never reach it
+        constexpr uint64_t inactive_key = std::numeric_limits<uint64_t>::max();
+
+        std::vector<uint64_t> keys(collection->size());
+        parallel::loop_for(0, collection->size(), [&](size_t i) {
+            if (collection->get<ParticleInfo>(i).type == ParticleTypeInactive) {
+                keys[i] = inactive_key;
+            } else {
+                keys[i] = calculate_cell_index_by_cell_location(
+                        calculate_grid_cell_location_of_position(collection->get<MovementData3D>(i).position));
+            }
+        });
+
+        sorted_particles = ParticleCollectionAlgorithm::Sort::radix_sort_permutation(keys);
+
+        // drop the inactive particles at the end of the sorted particles
+        while (!sorted_particles.empty() && keys[sorted_particles.back()] == inactive_key) {
+            sorted_particles.pop_back();
+        }
+
+        sorted_positions.resize(sorted_particles.size());
+        parallel::loop_for(0, sorted_particles.size(),
+                [&](size_t i) { sorted_positions[i] = collection->get<MovementData3D>(sorted_particles[i]).position; });
+
+        // collect the ranges of the non empty cells
+        cells.clear();
+        for (size_t i = 0; i < sorted_particles.size(); i++) {
+            uint64_t cell_index = keys[sorted_particles[i]];
+            if (cells.empty() || cells.back().cell_index != cell_index) {
+                cells.push_back({cell_index, calculate_grid_cell_location_of_position(sorted_positions[i]), (uint32_t)i,
+                        (uint32_t)i});
+            }
+            cells.back().end = i + 1;
+        }
+    }
+
+    void CsrNeighborhoodSearch3D::find_neighbors_of_cell(const GridCell& cell, bool write_neighbors) {
+        // the surrounding cells are the same for all particles of the cell
+        std::array<const GridCell*, 27> neighboring_cells;
+        size_t neighboring_cell_count = 0;
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dz = -1; dz <= 1; dz++) {
+                    auto neighboring_cell = find_cell(calculate_cell_index_by_cell_location(
+                            {cell.cell_location.x + dx, cell.cell_location.y + dy, cell.cell_location.z + dz}));
+                    if (neighboring_cell != nullptr) {
+                        neighboring_cells[neighboring_cell_count++] = neighboring_cell;
+                    }
+                }
+            }
+        }
+
+        float search_radius_squared = search_radius * search_radius;
+
+        for (uint32_t i = cell.begin; i < cell.end; i++) {
+            const glm::vec3& position = sorted_positions[i];
+            uint32_t particle = sorted_particles[i];
+
+            uint32_t count = 0;
+            uint32_t* target = write_neighbors ? &neighbor_indices[neighbor_offsets[particle]] : nullptr;
+
+            for (size_t c = 0; c < neighboring_cell_count; c++) {
+                for (uint32_t j = neighboring_cells[c]->begin; j < neighboring_cells[c]->end; j++) {
+                    glm::vec3 difference = position - sorted_positions[j];
+                    if (glm::dot(difference, difference) <= search_radius_squared) {
+                        if (write_neighbors) {
+                            target[count] = sorted_particles[j];
+                        }
+                        count++;
+                    }
+                }
+            }
+
+            if (!write_neighbors) {
+                neighbor_offsets[particle + 1] = count;
+            }
+        }
+    }
+
+    void CsrNeighborhoodSearch3D::find_neighbors() {
+        FLUID_ASSERT(collection != nullptr);
+        FLUID_ASSERT(collection->size() < std::numeric_limits<uint32_t>::max());
+
+        rebuild_grid();
+
+        // count the neighbors of each particle, inactive particles keep zero neighbors
+        neighbor_offsets.assign(collection->size() + 1, 0);
+        parallel::loop_for(0, cells.size(), [&](size_t c) { find_neighbors_of_cell(cells[c], false); });
+
+        // the offsets are the prefix sum of the counts
+        for (size_t i = 0; i < collection->size(); i++) {
+            neighbor_offsets[i + 1] += neighbor_offsets[i];
+        }
+
+        // write the neighbors to their final location
+        neighbor_indices.resize(neighbor_offsets.back());
+        parallel::loop_for(0, cells.size(), [&](size_t c) { find_neighbors_of_cell(cells[c], true); });
+    }
+
+    template<typename Callable>
+    void CsrNeighborhoodSearch3D::for_each_neighbor_of_position(const glm::vec3& position, Callable&& callable) const {
+        auto cell_location = calculate_grid_cell_location_of_position(position);
+        float search_radius_squared = search_radius * search_radius;
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dz = -1; dz <= 1; dz++) {
+                    auto cell = find_cell(calculate_cell_index_by_cell_location(
+                            {cell_location.x + dx, cell_location.y + dy, cell_location.z + dz}));
+                    if (cell == nullptr)
+                        continue;
+
+                    for (uint32_t j = cell->begin; j < cell->end; j++) {
+                        glm::vec3 difference = position - sorted_positions[j];
+                        if (glm::dot(difference, difference) <= search_radius_squared &&
+                                !callable(sorted_particles[j])) {
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    CsrNeighborhoodSearch3D::Neighbors CsrNeighborhoodSearch3D::get_neighbors(particleIndex_t particleIndex) {
+        FLUID_ASSERT(particleIndex + 1 < neighbor_offsets.size());
+
+        Neighbors n;
+        n.data = this;
+        n.position_based = false;
+        n.of.particle = particleIndex;
+        n.first = neighbor_indices.data() + neighbor_offsets[particleIndex];
+        n.last = neighbor_indices.data() + neighbor_offsets[particleIndex + 1];
+        return n;
+    }
+
+    CsrNeighborhoodSearch3D::Neighbors CsrNeighborhoodSearch3D::get_neighbors(const glm::vec3& position) {
+        Neighbors n;
+        n.data = this;
+        n.position_based = true;
+        n.of.position = position;
+        n.position_based_neighbors = std::make_shared<std::vector<uint32_t>>();
+
+        for_each_neighbor_of_position(position, [&](uint32_t neighbor) {
+            n.position_based_neighbors->push_back(neighbor);
+            return true;
+        });
+
+        n.first = n.position_based_neighbors->data();
+        n.last = n.first + n.position_based_neighbors->size();
+        return n;
+    }
+
+    CsrNeighborhoodSearch3D::NeighborsIterator CsrNeighborhoodSearch3D::Neighbors::begin() const {
+        NeighborsIterator iterator;
+        iterator.position_in_list = first;
+        return iterator;
+    }
+
+    CsrNeighborhoodSearch3D::NeighborsIterator CsrNeighborhoodSearch3D::Neighbors::end() const {
+        NeighborsIterator iterator;
+        iterator.position_in_list = last;
+        return iterator;
+    }
+
+    size_t CsrNeighborhoodSearch3D::Neighbors::size() const {
+        return last - first;
+    }
+
+    bool CsrNeighborhoodSearch3D::NeighborsIterator::operator==(const NeighborsIterator& other) const {
+        return position_in_list == other.position_in_list;
+    }
+
+    bool CsrNeighborhoodSearch3D::NeighborsIterator::operator!=(const NeighborsIterator& other) const {
+        return !(*this == other);
+    }
+
+    CsrNeighborhoodSearch3D::particleIndex_t& CsrNeighborhoodSearch3D::NeighborsIterator::operator*() {
+        FLUID_ASSERT(position_in_list != nullptr);
+        current = *position_in_list;
+        return current;
+    }
+
+    CsrNeighborhoodSearch3D::NeighborsIterator& CsrNeighborhoodSearch3D::NeighborsIterator::operator++() {
+        ++position_in_list;
+        return *this;
+    }
+
+    const CsrNeighborhoodSearch3D::NeighborsIterator CsrNeighborhoodSearch3D::NeighborsIterator::operator++(int) {
+        NeighborsIterator copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+    std::shared_ptr<NeighborhoodInterface> CsrNeighborhoodSearch3D::create_interface() {
+        auto res = std::make_shared<NeighborhoodInterface>();
+
+        auto link_neighbors = [](const Neighbors& neighbors) {
+            auto n = NeighborhoodInterface::Neighbors();
+            n.iterator_link.begin = [neighbors]() {
+                auto real_it = neighbors.begin();
+                return new NeighborsIterator(real_it);
+            };
+            n.iterator_link.end = [neighbors]() {
+                auto real_it = neighbors.end();
+                return new NeighborsIterator(real_it);
+            };
+            n.iterator_link.iterator_copy = [](void* it) {
+                auto copy = new NeighborsIterator(*((NeighborsIterator*)it));
+                return copy;
+            };
+            n.iterator_link.iterator_delete = [](void* it) {
+                delete ((NeighborsIterator*)it);
+            };
+            n.iterator_link.iterator_dereference = [](void* it) {
+                auto& index = *(*(NeighborsIterator*)it);
+                return &index;
+            };
+            n.iterator_link.iterator_equals = [](void* it1, void* it2) {
+                return *((NeighborsIterator*)it1) == *((NeighborsIterator*)it2);
+            };
+            n.iterator_link.iterator_increment = [](void* it) {
+                ++(*(NeighborsIterator*)it);
+            };
+
+            return n;
+        };
+
+        res->link.get_by_index = [this, link_neighbors](particleIndex_t index) {
+            return link_neighbors(this->get_neighbors(index));
+        };
+
+        res->link.get_by_position_3d = [this, link_neighbors](const glm::vec3& position) {
+            return link_neighbors(this->get_neighbors(position));
+        };
+
+        res->link.for_each_by_index = [this](particleIndex_t index, NeighborhoodInterface::NeighborCallback callback) {
+            FLUID_ASSERT(index + 1 < neighbor_offsets.size());
+            for (uint64_t n = neighbor_offsets[index]; n < neighbor_offsets[index + 1]; n++) {
+                if (!callback(neighbor_indices[n]))
+                    return;
+            }
+        };
+
+        auto for_each_by_position = [this](const glm::vec3& position,
+                                           NeighborhoodInterface::NeighborCallback callback) {
+            this->for_each_neighbor_of_position(position, callback);
+        };
+        res->link.for_each_by_position_3d = for_each_by_position;
+        res->link.gather_by_position_3d = [for_each_by_position](const glm::vec3* positions, size_t count,
+                std::vector<size_t>& offsets, std::vector<particleIndex_t>& indices) {
+            NeighborhoodInterface::gather_neighbors_with(for_each_by_position, positions, count, offsets, indices);
+        };
+
+        res->link.get_search_radius = [&] {
+            return this->search_radius;
+        };
+
+        return res;
+    }
+
+} // namespace LibFluid
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "fluidSolver/ParticleCollection.hpp"
+#include "fluidSolver/neighborhoodSearch/NeighborhoodInterface.hpp"
+#include "helpers/CompatibilityReport.hpp"
+#include "helpers/Initializable.hpp"
+#include "helpers/Reportable.hpp"
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace LibFluid {
+
+    /**
+     * @brief Neighborhood search that stores the neighbors of all particles in a compressed sparse row layout.
+     *
+     * The neighbors of particle i are neighbor_indices[neighbor_offsets[i]] to
+     * neighbor_indices[neighbor_offsets[i + 1] - 1], hence iterating over the neighbors is a linear scan over a
+     * single array. The lists are built on a grid of cells that is sorted by the morton code of the cells, in two
+     * passes: first the neighbors of each particle are counted, then they are written to their final location.
+     */
+    class CsrNeighborhoodSearch3D : public Initializable, public Reportable {
+      public:
+        using particleIndex_t = size_t;
+        using particleAmount_t = uint16_t;
+
+        struct NeighborsIterator
+        {
+            const uint32_t* position_in_list = nullptr;
+            particleIndex_t current = 0;
+
+            bool operator==(const NeighborsIterator& other) const;
+
+            bool operator!=(const NeighborsIterator& other) const;
+
+            particleIndex_t& operator*();
+
+            NeighborsIterator& operator++();
+
+            const NeighborsIterator operator++(int);
+        };
+
+        struct Neighbors
+        {
+            friend class CsrNeighborhoodSearch3D;
+
+            // iterator defines
+            using T = particleIndex_t;
+            using iterator = NeighborsIterator;
+            using const_iterator = NeighborsIterator;
+            using difference_type = ptrdiff_t;
+            using size_type = size_t;
+            using value_type = T;
+            using pointer = T*;
+            using const_pointer = const T*;
+            using reference = T&;
+
+            // data
+            union {
+                glm::vec3 position;
+                particleIndex_t particle;
+            } of = {};
+            bool position_based = false;
+            CsrNeighborhoodSearch3D* data = nullptr;
+
+            NeighborsIterator begin() const;
+
+            NeighborsIterator end() const;
+
+            size_t size() const;
+
+          private:
+            const uint32_t* first = nullptr;
+            const uint32_t* last = nullptr;
+
+            // owns the neighbors of position based queries
+            std::shared_ptr<std::vector<uint32_t>> position_based_neighbors = nullptr;
+        };
+
+        std::shared_ptr<ParticleCollection> collection = nullptr;
+        float search_radius = 0.0f;
+
+        void find_neighbors();
+
+        Neighbors get_neighbors(particleIndex_t particleIndex);
+
+        Neighbors get_neighbors(const glm::vec3& position);
+
+        void initialize() override;
+
+        std::shared_ptr<NeighborhoodInterface> create_interface();
+
+        void create_compatibility_report(CompatibilityReport& report) override;
+
+      private:
+        struct GridCellLocation
+        {
+            int x = std::numeric_limits<int>::min();
+            int y = std::numeric_limits<int>::min();
+            int z = std::numeric_limits<int>::min();
+        };
+
+        struct GridCell
+        {
+            uint64_t cell_index;
+            GridCellLocation cell_location;
+
+            // range of the cell inside sorted_particles
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        GridCellLocation calculate_grid_cell_location_of_position(const glm::vec3& position) const;
+
+        static uint64_t calculate_cell_index_by_cell_location(const GridCellLocation& location);
+
+        const GridCell* find_cell(uint64_t cell_index) const;
+
+        void rebuild_grid();
+
+        void find_neighbors_of_cell(const GridCell& cell, bool write_neighbors);
+
+        // calls the callable with each neighbor of the position until it returns false, the neighbors are not
+        // stored
+        template<typename Callable>
+        void for_each_neighbor_of_position(const glm::vec3& position, Callable&& callable) const;
+
+        // indices of all active particles, sorted by the cell they are contained in
+        std::vector<uint32_t> sorted_particles;
+
+        // positions of the particles in the order of sorted_particles
+        std::vector<glm::vec3> sorted_positions;
+
+        // non empty cells, sorted by their cell index
+        std::vector<GridCell> cells;
+
+        // 64 bit, since the total amount of neighbors can exceed the range of uint32_t for large collections
+        std::vector<uint64_t> neighbor_offsets;
+        std::vector<uint32_t> neighbor_indices;
+    };
+
+
+} // namespace LibFluid
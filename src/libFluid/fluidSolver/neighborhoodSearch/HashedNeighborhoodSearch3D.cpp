@@ -3,19 +3,23 @@
 #include "fluidSolver/ParticleCollectionAlgorithm.hpp"
 #include "parallelization/StdParallelForEach.hpp"
 
+#include <algorithm>
 #include <libmorton/morton.h>
 
 namespace LibFluid {
 
     using parallel = StdParallelForEach;
 
+    // particles that are not part of a grid get the largest key, morton codes of cells never reach it
+    static constexpr uint64_t excluded_key = std::numeric_limits<uint64_t>::max();
+
     void HashedNeighborhoodSearch3D::initialize() {
         FLUID_ASSERT(collection != nullptr);
         if (!collection->is_type_present<GridCellState>()) {
             collection->add_type<GridCellState>();
         }
-        grid_rebuild_required = true;
-        grid.auto_initialize_protection_enabled = true;
+        // the collection or the search radius might have changed
+        boundary_change_detector.invalidate();
     }
 
     void HashedNeighborhoodSearch3D::create_compatibility_report(CompatibilityReport& report) {
@@ -66,70 +70,245 @@ namespace LibFluid {
                 (int)std::floor(position.z / search_radius)};
     }
 
+    uint64_t HashedNeighborhoodSearch3D::calculate_cell_key_by_cell_location(const GridCellLocation& location) {
+        auto transform_into_unsigned = [](int32_t v) -> uint32_t {
+            int64_t v2 = (int64_t)v;
+            v2 -= std::numeric_limits<int32_t>::min();
+            uint32_t res = (uint32_t)v2;
+            return res;
+        };
+
+        return libmorton::morton3D_64_encode(transform_into_unsigned(location.x), transform_into_unsigned(location.y),
+                transform_into_unsigned(location.z));
+    }
+
     void HashedNeighborhoodSearch3D::find_neighbors() {
         improve_cache_efficiency();
 
-        if (grid_rebuild_required) {
-            rebuild_grid();
-            grid_rebuild_required = false;
-        } else {
-            update_grid();
-        }
+        rebuild_grid();
 
         find_neighbors_with_grid();
     }
 
-    void HashedNeighborhoodSearch3D::rebuild_grid() {
-        FLUID_ASSERT(collection != nullptr);
-        FLUID_ASSERT(collection->is_type_present<GridCellState>());
-        FLUID_ASSERT(collection->is_type_present<ParticleInfo>());
+    template<typename Callable>
+    bool HashedNeighborhoodSearch3D::for_each_neighbor_in_grid(const SortedGrid& sorted_grid,
+            const GridCellLocation& cell, const glm::vec3& position, Callable&& callable) const {
+        float search_radius_squared = search_radius * search_radius;
 
-        grid.clear();
+        // iterate over the full 3x3 cube with the cell in the center to cover all possible cells that could contain
+        // neighbors of the position
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dz = -1; dz <= 1; dz++) {
+                    // iterate over the particles of the cube cell, they are stored contiguously
+                    GridCellRange range = sorted_grid.find_cell({cell.x + dx, cell.y + dy, cell.z + dz});
+                    for (size_t k = range.begin; k < range.end; k++) {
+                        glm::vec3 difference = position - sorted_grid.sorted_positions[k];
+                        if (glm::dot(difference, difference) <= search_radius_squared &&
+                                !callable(sorted_grid.sorted_particles[k])) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    void HashedNeighborhoodSearch3D::build_grid(SortedGrid& sorted_grid, const std::vector<uint64_t>& keys) {
+        // sort the particles by their cell, the particles of a cell are then stored contiguously
+        auto permutation = ParticleCollectionAlgorithm::Sort::radix_sort_permutation(keys);
+        while (!permutation.empty() && keys[permutation.back()] == excluded_key) {
+            permutation.pop_back();
+        }
+
+        auto& sorted_particles = sorted_grid.sorted_particles;
+        sorted_particles.resize(permutation.size());
+        sorted_grid.sorted_positions.resize(permutation.size());
+        parallel::loop_for(0, permutation.size(), [&](size_t i) {
+            sorted_particles[i] = permutation[i];
+            sorted_grid.sorted_positions[i] = collection->get<MovementData3D>(permutation[i]).position;
+        });
+
+        // a cell begins at each sorted particle whose key differs from the key of its predecessor. The sorted
+        // particles are split into chunks, which count the cells beginning inside of them. The exclusive prefix sum
+        // of the counts yields the index of the first cell of each chunk, the chunks then write their cells.
+        size_t particle_count = sorted_particles.size();
+        size_t chunk_size = parallel::grain_size(particle_count);
+        size_t chunk_count = (particle_count + chunk_size - 1) / chunk_size;
+        auto begins_cell = [&](size_t i) {
+            return i == 0 || keys[sorted_particles[i]] != keys[sorted_particles[i - 1]];
+        };
 
-        grid.auto_initialize_protection_enabled = false;
-        for (particleIndex_t i = 0; i < collection->size(); i++) {
-            if (collection->get<ParticleInfo>(i).type == ParticleTypeInactive) {
-                continue;
+        std::vector<size_t> chunk_cell_offsets(chunk_count + 1, 0);
+        auto count_chunk = [&](size_t c) {
+            size_t end = std::min((c + 1) * chunk_size, particle_count);
+            size_t count = 0;
+            for (size_t i = c * chunk_size; i < end; i++) {
+                if (begins_cell(i)) {
+                    count++;
+                }
             }
+            chunk_cell_offsets[c + 1] = count;
+        };
+        parallel::loop_for_range(0, chunk_count, 1, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; c++) {
+                count_chunk(c);
+            }
+        });
 
-            auto& state = collection->get<GridCellState>(i);
-            state.previous = GridCellLocation::undefined();
-            state.current = calculate_grid_cell_location_of_particle(i);
+        for (size_t c = 0; c < chunk_count; c++) {
+            chunk_cell_offsets[c + 1] += chunk_cell_offsets[c];
+        }
+        size_t cell_count = chunk_cell_offsets.back();
+
+        auto& cell_locations = sorted_grid.cell_locations;
+        auto& cell_begins = sorted_grid.cell_begins;
+        cell_locations.resize(cell_count);
+        cell_begins.resize(cell_count + 1);
+        cell_begins[cell_count] = particle_count;
+        auto write_chunk = [&](size_t c) {
+            size_t end = std::min((c + 1) * chunk_size, particle_count);
+            size_t cell = chunk_cell_offsets[c];
+            for (size_t i = c * chunk_size; i < end; i++) {
+                if (begins_cell(i)) {
+                    cell_locations[cell] = collection->get<GridCellState>(sorted_particles[i]).current;
+                    cell_begins[cell] = i;
+                    cell++;
+                }
+            }
+        };
+        parallel::loop_for_range(0, chunk_count, 1, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; c++) {
+                write_chunk(c);
+            }
+        });
+
+        // insert the cells into the hash table concurrently, a slot is claimed by swapping in the cell if it is
+        // still empty
+        size_t table_size = 1;
+        while (table_size < 2 * cell_count) {
+            table_size *= 2;
+        }
+        auto& cell_table = sorted_grid.cell_table;
+        if (cell_table.size() != table_size) {
+            cell_table = std::vector<std::atomic<uint32_t>>(table_size);
+        }
+        parallel::loop_for(0, table_size, [&](size_t slot) {
+            cell_table[slot].store(SortedGrid::empty_slot, std::memory_order_relaxed);
+        });
+
+        size_t mask = table_size - 1;
+        parallel::loop_for(0, cell_count, [&](size_t cell) {
+            for (size_t slot = GridCellLocation::hash()(cell_locations[cell]) & mask;; slot = (slot + 1) & mask) {
+                uint32_t expected = SortedGrid::empty_slot;
+                if (cell_table[slot].compare_exchange_strong(expected, (uint32_t)cell, std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        });
+    }
 
+    HashedNeighborhoodSearch3D::GridCellRange HashedNeighborhoodSearch3D::SortedGrid::find_cell(
+            const GridCellLocation& location) const {
+        if (cell_table.empty()) {
+            return {};
+        }
 
-            grid[state.current].insert(i);
+        // at least half of the slots are empty, hence the probing terminates
+        size_t mask = cell_table.size() - 1;
+        for (size_t slot = GridCellLocation::hash()(location) & mask;; slot = (slot + 1) & mask) {
+            uint32_t cell = cell_table[slot].load(std::memory_order_relaxed);
+            if (cell == empty_slot) {
+                return {};
+            }
+            if (cell_locations[cell] == location) {
+                return {cell_begins[cell], cell_begins[cell + 1]};
+            }
         }
-        grid.auto_initialize_protection_enabled = true;
     }
 
-    void HashedNeighborhoodSearch3D::update_grid() {
+    void HashedNeighborhoodSearch3D::rebuild_grid() {
         FLUID_ASSERT(collection != nullptr);
+        FLUID_ASSERT(collection->is_type_present<MovementData3D>());
         FLUID_ASSERT(collection->is_type_present<GridCellState>());
+        FLUID_ASSERT(collection->is_type_present<ParticleInfo>());
+        FLUID_ASSERT(collection->size() < std::numeric_limits<uint32_t>::max());
 
-        grid.auto_initialize_protection_enabled = false;
-        for (particleIndex_t i = 0; i < collection->size(); i++) {
-            if (collection->get<ParticleInfo>(i).type == ParticleTypeInactive) {
-                // TODO: erase inactive particles from the grid
-                continue;
-            }
+        if (boundary_change_detector.update(*collection)) {
+            rebuild_boundary();
+        }
 
+        // calculate the cell of each fluid particle in parallel, the cells of the boundary particles are unchanged
+        std::vector<uint64_t> keys(collection->size());
+        parallel::loop_for(0, collection->size(), [&](particleIndex_t i) {
+            auto type = collection->get<ParticleInfo>(i).type;
+            if (type == ParticleTypeBoundary) {
+                keys[i] = excluded_key;
+                return;
+            }
 
             auto& state = collection->get<GridCellState>(i);
-            state.previous = state.current;
+            if (type == ParticleTypeInactive) {
+                state.current = GridCellLocation::undefined();
+                keys[i] = excluded_key;
+                return;
+            }
+
             state.current = calculate_grid_cell_location_of_particle(i);
-            if (state.previous != state.current) {
-                // particle needs to be moved or inserted
-                if (state.previous == GridCellLocation::undefined()) {
-                    grid[state.current].insert(i);
-                } else {
-                    grid[state.previous].erase(i);
-                    grid[state.current].insert(i);
-                }
+            keys[i] = calculate_cell_key_by_cell_location(state.current);
+        });
+
+        build_grid(fluid_grid, keys);
+    }
+
+    void HashedNeighborhoodSearch3D::rebuild_boundary() {
+        std::vector<uint64_t> keys(collection->size());
+        parallel::loop_for(0, collection->size(), [&](particleIndex_t i) {
+            if (collection->get<ParticleInfo>(i).type != ParticleTypeBoundary) {
+                keys[i] = excluded_key;
+                return;
             }
+
+            auto& state = collection->get<GridCellState>(i);
+            state.current = calculate_grid_cell_location_of_particle(i);
+            keys[i] = calculate_cell_key_by_cell_location(state.current);
+        });
+
+        build_grid(boundary_grid, keys);
+
+        // the boundary neighbors of the boundary particles are counted first and written afterwards
+        boundary_neighbor_offsets.assign(collection->size() + 1, 0);
+        parallel::loop_for(0, collection->size(), [&](particleIndex_t i) {
+            if (keys[i] == excluded_key)
+                return;
+
+            size_t count = 0;
+            for_each_neighbor_in_grid(boundary_grid, collection->get<GridCellState>(i).current,
+                    collection->get<MovementData3D>(i).position, [&](particleIndex_t) {
+                        count++;
+                        return true;
+                    });
+            boundary_neighbor_offsets[i + 1] = count;
+        });
+
+        for (size_t i = 0; i < collection->size(); i++) {
+            boundary_neighbor_offsets[i + 1] += boundary_neighbor_offsets[i];
         }
-        grid.auto_initialize_protection_enabled = true;
-    }
+        boundary_neighbor_indices.resize(boundary_neighbor_offsets.back());
+
+        parallel::loop_for(0, collection->size(), [&](particleIndex_t i) {
+            if (keys[i] == excluded_key)
+                return;
 
+            particleIndex_t* out = boundary_neighbor_indices.data() + boundary_neighbor_offsets[i];
+            for_each_neighbor_in_grid(boundary_grid, collection->get<GridCellState>(i).current,
+                    collection->get<MovementData3D>(i).position, [&](particleIndex_t neighbor) {
+                        *out++ = neighbor;
+                        return true;
+                    });
+        });
+    }
 
     void HashedNeighborhoodSearch3D::find_neighbors_with_grid() {
         FLUID_ASSERT(collection != nullptr);
@@ -137,49 +316,47 @@ namespace LibFluid {
         FLUID_ASSERT(collection->is_type_present<ParticleInfo>());
         FLUID_ASSERT(collection->is_type_present<GridCellState>());
         FLUID_ASSERT(search_radius > 0.0f);
+        FLUID_ASSERT(boundary_neighbor_offsets.size() == collection->size() + 1);
 
         if (collection->size() > neighbor_data.size())
             neighbor_data.resize(collection->size());
 
-        float search_radius_squared = search_radius * search_radius;
-
         // search in parallel for each particle
-        parallel::loop_for(0, collection->size(), [&](particleIndex_t i) {
-            auto& data = neighbor_data[i];
-            data.size = 0;
+        parallel::loop_for_range(0, collection->size(), [&](size_t begin, size_t end) {
+            // the neighbors of a particle are collected in a buffer that is reused for the particles of the range,
+            // hence the neighbor list of the particle grows at most once to the amount of found neighbors
+            std::vector<particleIndex_t> found_neighbors;
+            auto add_neighbor = [&found_neighbors](particleIndex_t neighbor) {
+                found_neighbors.push_back(neighbor);
+                return true;
+            };
 
-            if (collection->get<ParticleInfo>(i).type == ParticleTypeInactive)
-                return;
+            for (particleIndex_t i = begin; i < end; i++) {
+                auto& data = neighbor_data[i];
+                data.size = 0;
 
-            auto& mv_i = collection->get<MovementData3D>(i);
-            auto& state = collection->get<GridCellState>(i);
+                auto type = collection->get<ParticleInfo>(i).type;
+                if (type == ParticleTypeInactive)
+                    continue;
 
+                auto& mv_i = collection->get<MovementData3D>(i);
+                auto& state = collection->get<GridCellState>(i);
 
-            // iterate over the full 3x3 cube with the current cell in the center to cover all possible
-            // cells that could contain neighbors of the current particle
-            for (int dx = -1; dx <= 1; dx++) {
-                for (int dy = -1; dy <= 1; dy++) {
-                    for (int dz = -1; dz <= 1; dz++) {
-                        // calculate the cell location of the current cube cell
-                        GridCellLocation cell_to_check {state.current.x + dx, state.current.y + dy,
-                                state.current.z + dz};
-
-                        // iterate over the particles of the cube cell
-                        for (particleIndex_t j : grid[cell_to_check]) {
-                            auto& mv_j = collection->get<MovementData3D>(j);
-
-                            glm::vec3 difference = mv_i.position - mv_j.position;
-
-                            if (glm::dot(difference, difference) <= search_radius_squared) {
-                                // the particle is a neighbor
-                                if (data.neighbor_indices.size() <= data.size)
-                                    data.neighbor_indices.resize(data.size + 1);
-                                data.neighbor_indices[data.size] = j;
-                                data.size++;
-                            }
-                        }
-                    }
+                found_neighbors.clear();
+                if (type == ParticleTypeBoundary) {
+                    // the boundary neighbors of boundary particles were found when the boundary was built
+                    found_neighbors.insert(found_neighbors.end(),
+                            boundary_neighbor_indices.begin() + boundary_neighbor_offsets[i],
+                            boundary_neighbor_indices.begin() + boundary_neighbor_offsets[i + 1]);
+                } else {
+                    for_each_neighbor_in_grid(boundary_grid, state.current, mv_i.position, add_neighbor);
                 }
+                for_each_neighbor_in_grid(fluid_grid, state.current, mv_i.position, add_neighbor);
+
+                data.size = found_neighbors.size();
+                if (data.neighbor_indices.size() < data.size)
+                    data.neighbor_indices.resize(data.size);
+                std::copy(found_neighbors.begin(), found_neighbors.end(), data.neighbor_indices.begin());
             }
         });
     }
@@ -190,29 +367,14 @@ namespace LibFluid {
 
         if (calls_since_last_cache_efficiency_improvement > 100) {
             ParticleCollectionAlgorithm::Sort sorter;
-            sorter.adapt_collection(collection);
-
-            sorter.quick_sort(
+            sorter.radix_sort(
                     collection,
                     [&](const std::shared_ptr<ParticleCollection>& collection, const size_t index) -> uint64_t {
                         auto& grid_data = collection->get<GridCellState>(index);
-
-                        auto transform_into_unsigned = [](int32_t v) -> uint32_t {
-                            int64_t v2 = (int64_t)v;
-                            v2 -= std::numeric_limits<int32_t>::min();
-                            uint32_t res = (uint32_t)v2;
-                            return res;
-                        };
-
-
-                        uint64_t key = libmorton::morton3D_64_encode(transform_into_unsigned(grid_data.current.x),
-                                transform_into_unsigned(grid_data.current.y),
-                                transform_into_unsigned(grid_data.current.z));
-                        return key;
+                        return calculate_cell_key_by_cell_location(grid_data.current);
                     });
 
             calls_since_last_cache_efficiency_improvement = 0;
-            grid_rebuild_required = true;
         }
     }
 
@@ -279,29 +441,24 @@ namespace LibFluid {
             FLUID_ASSERT(data->data->collection != nullptr);
             FLUID_ASSERT(data->data->search_radius > 0.0f);
             auto collection = data->data->collection;
-            bool found = false;
 
             auto center_cell = data->data->calculate_grid_cell_location_of_position(data->of.position);
 
-            while (!found) {
-                GridCellLocation current_cell {center_cell.x + dx, center_cell.y + dy, center_cell.z + dz};
+            while (true) {
+                const SortedGrid& sorted_grid = boundary_cells ? data->data->boundary_grid : data->data->fluid_grid;
 
-                // initialize or advance the current iterator by one
-                if (!current_set_iterator.has_value()) {
-                    if (data->data->grid[current_cell].size() != 0) {
-                        current_set_iterator = data->data->grid[current_cell].begin();
-                    }
-                } else {
-                    (*current_set_iterator)++;
-                    if (*current_set_iterator == data->data->grid[current_cell].end()) {
-                        // set the iterator object to empty, since this iterator is depleted of entries
-                        current_set_iterator.reset();
+                // check the remaining particles of the current cell
+                while (position_in_cell < cell_end) {
+                    size_t k = position_in_cell++;
+                    if (glm::length(data->of.position - sorted_grid.sorted_positions[k]) <= data->data->search_radius) {
+                        // we found a neighbor -> set the current particle index to the neighbor
+                        current = sorted_grid.sorted_particles[k];
+                        return *this;
                     }
                 }
 
-                // check if we need to choose the next cell and therefore the next iterator
-                if (!current_set_iterator.has_value()) {
-                    // increment counters to the next cell location
+                // the current cell is depleted, increment counters to the next cell location
+                if (cell_loaded) {
                     dz++;
                     if (dz > 1) {
                         dy++;
@@ -312,37 +469,26 @@ namespace LibFluid {
                         dy = -1;
                     }
                     if (dx > 1) {
-                        // there are no cells left to check, set the iterator to the end() and return
-                        current = collection->size();
-                        return *this;
-                    }
-
-                    // update the current cell
-                    current_cell = {center_cell.x + dx, center_cell.y + dy, center_cell.z + dz};
-
-                    // set the current iterator the the new cell
-                    if (data->data->grid[current_cell].size() != 0) {
-                        current_set_iterator = data->data->grid[current_cell].begin();
-                    }
+                        if (boundary_cells) {
+                            // there are no cells left to check, set the iterator to the end() and return
+                            current = collection->size();
+                            return *this;
+                        }
 
-                    // repreat to check the next cell
-                    found = false;
-                    continue;
-                } else {
-                    // check the particle the iterator points to
-                    particleIndex_t current_candidate = *(*current_set_iterator);
-                    const glm::vec3& position = collection->get<MovementData3D>(current_candidate).position;
-                    if (glm::length(data->of.position - position) <= data->data->search_radius) {
-                        // we found a neighbor -> set the current particle index to the neighbor
-                        current = current_candidate;
-                        found = true;
-                        continue;
-                    } else {
-                        // the candidate is not a neighbor, repeat to check the next particle
-                        found = false;
-                        continue;
+                        // continue with the cells of the boundary grid
+                        boundary_cells = true;
+                        dx = -1;
+                        dy = -1;
+                        dz = -1;
                     }
                 }
+
+                GridCellLocation current_cell {center_cell.x + dx, center_cell.y + dy, center_cell.z + dz};
+                const auto& grid = boundary_cells ? data->data->boundary_grid : data->data->fluid_grid;
+                GridCellRange range = grid.find_cell(current_cell);
+                position_in_cell = range.begin;
+                cell_end = range.end;
+                cell_loaded = true;
             }
         }
         return *this;
@@ -372,6 +518,15 @@ namespace LibFluid {
     }
 
 
+    template<typename Callable>
+    void HashedNeighborhoodSearch3D::for_each_neighbor_of_position(const glm::vec3& position, Callable&& callable) {
+        FLUID_ASSERT(search_radius > 0.0f);
+
+        auto cell = calculate_grid_cell_location_of_position(position);
+        if (for_each_neighbor_in_grid(fluid_grid, cell, position, callable))
+            for_each_neighbor_in_grid(boundary_grid, cell, position, callable);
+    }
+
     std::shared_ptr<NeighborhoodInterface> HashedNeighborhoodSearch3D::create_interface() {
         auto res = std::make_shared<NeighborhoodInterface>();
 
@@ -445,6 +600,25 @@ namespace LibFluid {
             return this->search_radius;
         };
 
+        res->link.for_each_by_index = [this](particleIndex_t index, NeighborhoodInterface::NeighborCallback callback) {
+            FLUID_ASSERT(neighbor_data.size() > index);
+            const auto& data = neighbor_data[index];
+            for (size_t n = 0; n < data.size; n++) {
+                if (!callback(data.neighbor_indices[n]))
+                    return;
+            }
+        };
+
+        auto for_each_by_position = [this](const glm::vec3& position,
+                                           NeighborhoodInterface::NeighborCallback callback) {
+            this->for_each_neighbor_of_position(position, callback);
+        };
+        res->link.for_each_by_position_3d = for_each_by_position;
+        res->link.gather_by_position_3d = [for_each_by_position](const glm::vec3* positions, size_t count,
+                std::vector<size_t>& offsets, std::vector<particleIndex_t>& indices) {
+            NeighborhoodInterface::gather_neighbors_with(for_each_by_position, positions, count, offsets, indices);
+        };
+
         return res;
     }
 } // namespace FluidSolver
\ No newline at end of file
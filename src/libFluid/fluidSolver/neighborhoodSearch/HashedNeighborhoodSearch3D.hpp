@@ -1,21 +1,30 @@
 #pragma once
 
+#include "fluidSolver/BoundaryChangeDetector.hpp"
 #include "fluidSolver/ParticleCollection.hpp"
 #include "fluidSolver/neighborhoodSearch/NeighborhoodInterface.hpp"
-#include "helpers/ProtectedUnorderedMap.hpp"
 #include "helpers/CompatibilityReport.hpp"
 #include "helpers/Initializable.hpp"
 #include "helpers/Reportable.hpp"
 
 #include <array>
+#include <atomic>
 #include <limits>
 #include <memory>
-#include <set>
-#include <optional>
+#include <vector>
 
 namespace LibFluid {
 
 
+    /**
+     * @brief Neighborhood search on a hashed grid of cells, whose particles are sorted by the morton code of their
+     * cell.
+     *
+     * Fluid and boundary particles are stored in separate grids. Boundary particles usually do not move, hence
+     * their grid and the boundary neighbors of each boundary particle are only rebuilt if a boundary particle was
+     * added, removed, moved or reordered. In each search only the fluid particles are sorted into their grid and
+     * searched for.
+     */
     class HashedNeighborhoodSearch3D : public Initializable, public Reportable {
       public:
         using particleIndex_t = size_t;
@@ -34,7 +43,12 @@ namespace LibFluid {
             int8_t dy = -1;
             int8_t dz = -1;
 
-            std::optional<std::set<particleIndex_t>::iterator> current_set_iterator;
+            // range of the currently checked cell inside the sorted particles, the cells of the fluid grid are
+            // checked before the cells of the boundary grid
+            bool cell_loaded = false;
+            bool boundary_cells = false;
+            size_t position_in_cell = 0;
+            size_t cell_end = 0;
 
             bool operator==(const NeighborsIterator& other) const;
 
@@ -107,7 +121,8 @@ namespace LibFluid {
             {
                 inline size_t operator()(const GridCellLocation& cell) const
                 {
-                    return std::hash<int>()(cell.x) ^ std::hash<int>()(cell.y) ^ std::hash<int>()(cell.z);
+                    // spatial hash of Teschner et al., large primes to spread neighboring cells over the buckets
+                    return ((size_t)cell.x * 73856093) ^ ((size_t)cell.y * 19349663) ^ ((size_t)cell.z * 83492791);
                 }
             };
 
@@ -120,22 +135,76 @@ namespace LibFluid {
 
         struct GridCellState
         {
-            GridCellLocation previous;
             GridCellLocation current;
         };
 
+        struct GridCellRange
+        {
+            // range of the cell inside sorted_particles
+            size_t begin = 0;
+            size_t end = 0;
+        };
+
         GridCellLocation calculate_grid_cell_location_of_particle(particleIndex_t index);
         GridCellLocation calculate_grid_cell_location_of_position(const glm::vec3& position);
 
+        static uint64_t calculate_cell_key_by_cell_location(const GridCellLocation& location);
+
+
+        struct SortedGrid
+        {
+            // indices of the particles, sorted by the cell they are contained in
+            std::vector<particleIndex_t> sorted_particles;
+
+            // positions of the particles in the order of sorted_particles
+            std::vector<glm::vec3> sorted_positions;
+
+            // the particles of the non empty cell c are sorted_particles[cell_begins[c]] up to
+            // sorted_particles[cell_begins[c + 1] - 1]
+            std::vector<GridCellLocation> cell_locations;
+            std::vector<size_t> cell_begins;
+
+            // hash table with linear probing that maps the locations to the non empty cells, its size is a power of
+            // two of at least twice the amount of cells, unused slots contain empty_slot
+            static constexpr uint32_t empty_slot = std::numeric_limits<uint32_t>::max();
+            std::vector<std::atomic<uint32_t>> cell_table;
+
+            // returns the range of the cell inside sorted_particles, which is empty if the cell contains no particles
+            GridCellRange find_cell(const GridCellLocation& location) const;
+        };
+
+        // sorts all particles whose key is not the excluded key into the grid, the cells are determined and
+        // inserted into the hash table in parallel
+        void build_grid(SortedGrid& sorted_grid, const std::vector<uint64_t>& keys);
 
         void rebuild_grid();
 
-        void update_grid();
+        void rebuild_boundary();
 
         void find_neighbors_with_grid();
 
-        Helper::ProtectedUnorderedMap<GridCellLocation, std::set<particleIndex_t>, GridCellLocation::hash> grid;
-        bool grid_rebuild_required = true;
+        // calls the callable with each particle of the grid that is a neighbor of the position until it returns
+        // false, returns false if the iteration was stopped this way
+        template<typename Callable>
+        bool for_each_neighbor_in_grid(const SortedGrid& sorted_grid, const GridCellLocation& cell,
+                const glm::vec3& position, Callable&& callable) const;
+
+        // calls the callable with each neighbor of the position without the state machine of NeighborsIterator,
+        // until it returns false
+        template<typename Callable>
+        void for_each_neighbor_of_position(const glm::vec3& position, Callable&& callable);
+
+        // active fluid particles, they are sorted into the grid in each search
+        SortedGrid fluid_grid;
+
+        // boundary particles, they are only sorted into the grid if they changed
+        SortedGrid boundary_grid;
+        BoundaryChangeDetector boundary_change_detector;
+
+        // the boundary neighbors of boundary particle i are boundary_neighbor_indices[boundary_neighbor_offsets[i]]
+        // up to boundary_neighbor_indices[boundary_neighbor_offsets[i + 1] - 1]
+        std::vector<size_t> boundary_neighbor_offsets;
+        std::vector<particleIndex_t> boundary_neighbor_indices;
 
 
       private:
@@ -97,6 +97,38 @@ LibFluid::NeighborhoodInterface::NeighborsIterator::NeighborsIterator(const Neig
     this->data = to_copy.data;
 }
 
+void LibFluid::NeighborhoodInterface::for_each_neighbor(particleIndex_t particleIndex, NeighborCallback callback)
+{
+    FLUID_ASSERT(link.for_each_by_index != nullptr);
+    link.for_each_by_index(particleIndex, callback);
+}
+
+void LibFluid::NeighborhoodInterface::for_each_neighbor(const glm::vec2& position, NeighborCallback callback)
+{
+    FLUID_ASSERT(link.for_each_by_position != nullptr);
+    link.for_each_by_position(position, callback);
+}
+
+void LibFluid::NeighborhoodInterface::for_each_neighbor(const glm::vec3& position, NeighborCallback callback)
+{
+    FLUID_ASSERT(link.for_each_by_position_3d != nullptr);
+    link.for_each_by_position_3d(position, callback);
+}
+
+void LibFluid::NeighborhoodInterface::gather_neighbors(const glm::vec2* positions, size_t count,
+    std::vector<size_t>& offsets, std::vector<particleIndex_t>& indices)
+{
+    FLUID_ASSERT(link.gather_by_position != nullptr);
+    link.gather_by_position(positions, count, offsets, indices);
+}
+
+void LibFluid::NeighborhoodInterface::gather_neighbors(const glm::vec3* positions, size_t count,
+    std::vector<size_t>& offsets, std::vector<particleIndex_t>& indices)
+{
+    FLUID_ASSERT(link.gather_by_position_3d != nullptr);
+    link.gather_by_position_3d(positions, count, offsets, indices);
+}
+
 float LibFluid::NeighborhoodInterface::get_search_radius(){
     FLUID_ASSERT(this->link.get_search_radius != nullptr);
     return this->link.get_search_radius();
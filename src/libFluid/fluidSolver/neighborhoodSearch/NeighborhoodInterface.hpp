@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <functional>
 #include <glm/glm.hpp>
+#include <type_traits>
+#include <vector>
 
 
 namespace LibFluid {
@@ -23,6 +25,10 @@ namespace LibFluid {
 	 * The NeighborhoodInterface provides the basic requirements of the Neighbor object
 	 * used in the
      * neighborhood searches.
+	 *
+	 * Components that query many neighborhoods should use for_each_neighbor or gather_neighbors instead of
+	 * get_neighbors. They are implemented by each search with its own iterators and cost a single call through a
+	 * function object per query instead of allocations and calls for every step of the iteration.
 	 */
     class NeighborhoodInterface {
       public:
@@ -83,19 +89,104 @@ namespace LibFluid {
         };
 
 
+        /**
+         * @brief Non owning reference to a callable that is invoked with the index of each neighbor.
+         *
+         * In contrast to std::function it never allocates memory. The referenced callable has to outlive the
+         * NeighborCallback, which is the case for a lambda that is passed directly to for_each_neighbor.
+         * The callable either returns nothing or a bool, in which case returning false stops the iteration.
+         */
+        class NeighborCallback {
+          public:
+            template<typename Callable,
+                    typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, NeighborCallback>>>
+            NeighborCallback(Callable&& callable)
+                : callable(const_cast<void*>(static_cast<const void*>(&callable))),
+                  call([](void* referenced, particleIndex_t neighbor) -> bool {
+                      auto& function = *static_cast<std::remove_reference_t<Callable>*>(referenced);
+                      if constexpr (std::is_void_v<decltype(function(neighbor))>) {
+                          function(neighbor);
+                          return true;
+                      } else {
+                          return function(neighbor);
+                      }
+                  }) {
+            }
+
+            // returns false if the iteration over the neighbors should stop
+            bool operator()(particleIndex_t neighbor) const {
+                return call(callable, neighbor);
+            }
+
+          private:
+            void* callable;
+            bool (*call)(void* callable, particleIndex_t neighbor);
+        };
+
+
         Neighbors get_neighbors(particleIndex_t particleIndex);
 
         Neighbors get_neighbors(const glm::vec2& position);
         Neighbors get_neighbors(const glm::vec3& position);
 
+        /**
+         * @brief Calls the callback with the index of each neighbor until the callback returns false.
+         */
+        void for_each_neighbor(particleIndex_t particleIndex, NeighborCallback callback);
+
+        void for_each_neighbor(const glm::vec2& position, NeighborCallback callback);
+        void for_each_neighbor(const glm::vec3& position, NeighborCallback callback);
+
+        /**
+         * @brief Collects the neighbors of count positions into the given buffers.
+         *
+         * The neighbors of positions[i] are stored in indices[offsets[i]] up to indices[offsets[i + 1] - 1]. The
+         * buffers are resized but keep their capacity, hence reusing them avoids any allocations.
+         */
+        void gather_neighbors(const glm::vec2* positions, size_t count, std::vector<size_t>& offsets,
+                std::vector<particleIndex_t>& indices);
+        void gather_neighbors(const glm::vec3* positions, size_t count, std::vector<size_t>& offsets,
+                std::vector<particleIndex_t>& indices);
+
         float get_search_radius();
 
+        /**
+         * @brief Implements gather_neighbors for the searches by calling for_each(position, callback) for each
+         * position.
+         */
+        template<typename Position, typename ForEach>
+        static void gather_neighbors_with(const ForEach& for_each, const Position* positions, size_t count,
+                std::vector<size_t>& offsets, std::vector<particleIndex_t>& indices) {
+            offsets.resize(count + 1);
+            offsets[0] = 0;
+            indices.clear();
+
+            auto append = [&indices](particleIndex_t neighbor) {
+                indices.push_back(neighbor);
+            };
+            for (size_t i = 0; i < count; i++) {
+                for_each(positions[i], NeighborCallback(append));
+                offsets[i + 1] = indices.size();
+            }
+        }
+
+
+        using GatherByPosition = std::function<void(const glm::vec2* positions, size_t count,
+                std::vector<size_t>& offsets, std::vector<particleIndex_t>& indices)>;
+        using GatherByPosition3D = std::function<void(const glm::vec3* positions, size_t count,
+                std::vector<size_t>& offsets, std::vector<particleIndex_t>& indices)>;
 
         struct Interface {
             std::function<Neighbors(particleIndex_t particleIndex)> get_by_index;
             std::function<Neighbors(const glm::vec2& position)> get_by_position;
             std::function<Neighbors(const glm::vec3& position)> get_by_position_3d;
             std::function<float()> get_search_radius;
+
+            std::function<void(particleIndex_t particleIndex, NeighborCallback callback)> for_each_by_index;
+            std::function<void(const glm::vec2& position, NeighborCallback callback)> for_each_by_position;
+            std::function<void(const glm::vec3& position, NeighborCallback callback)> for_each_by_position_3d;
+            GatherByPosition gather_by_position;
+            GatherByPosition3D gather_by_position_3d;
         } link;
     };
 
@@ -149,6 +149,26 @@ namespace LibFluid {
             return n;
         };
 
+        res->link.for_each_by_index = [this](particleIndex_t index, NeighborhoodInterface::NeighborCallback callback) {
+            for (particleIndex_t neighbor : this->get_neighbors(index)) {
+                if (!callback(neighbor))
+                    return;
+            }
+        };
+
+        auto for_each_by_position = [this](const glm::vec2& position,
+                                           NeighborhoodInterface::NeighborCallback callback) {
+            for (particleIndex_t neighbor : this->get_neighbors(position)) {
+                if (!callback(neighbor))
+                    return;
+            }
+        };
+        res->link.for_each_by_position = for_each_by_position;
+        res->link.gather_by_position = [for_each_by_position](const glm::vec2* positions, size_t count,
+                std::vector<size_t>& offsets, std::vector<particleIndex_t>& indices) {
+            NeighborhoodInterface::gather_neighbors_with(for_each_by_position, positions, count, offsets, indices);
+        };
+
         return res;
     }
 
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "LibFluidAssert.hpp"
+#include "fluidSolver/ParticleCollection.hpp"
+#include "fluidSolver/neighborhoodSearch/NeighborhoodInterface.hpp"
+#include "helpers/CompatibilityReport.hpp"
+#include "helpers/Initializable.hpp"
+#include "helpers/Reportable.hpp"
+#include "parallelization/StdParallelForEach.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace LibFluid {
+
+    /**
+     * @brief Neighborhood search that reuses the neighbor lists of an underlying search over multiple steps.
+     *
+     * The underlying search looks for neighbors within search_radius + skin. As long as no particle moved more than
+     * half of the skin since the lists were built, every pair of particles that is now closer than search_radius is
+     * still contained in the lists and the search is skipped. The lists may therefore contain particles up to a
+     * distance of search_radius + skin, which does not change the results since the kernels vanish beyond their
+     * support. Queries by position and the queries of the interface are used by components that do not apply a
+     * kernel, hence their neighbors are filtered by their current distance to the search_radius.
+     *
+     * @tparam NeighborhoodSearch Underlying 3D neighborhood search
+     */
+    template<typename NeighborhoodSearch>
+    class VerletNeighborhoodSearch : public Initializable, public Reportable {
+      public:
+        using particleIndex_t = typename NeighborhoodSearch::particleIndex_t;
+        using particleAmount_t = typename NeighborhoodSearch::particleAmount_t;
+        using Neighbors = typename NeighborhoodSearch::Neighbors;
+        using NeighborsIterator = typename NeighborhoodSearch::NeighborsIterator;
+        using PositionNeighbors = std::vector<particleIndex_t>;
+
+        std::shared_ptr<ParticleCollection> collection = nullptr;
+        float search_radius = 0.0f;
+
+        // size of the skin relative to the search radius
+        float skin_factor = 0.1f;
+
+        void find_neighbors();
+
+        Neighbors get_neighbors(particleIndex_t particleIndex);
+
+        /**
+         * @brief Returns the particles whose current position is within search_radius of the position.
+         */
+        PositionNeighbors get_neighbors(const glm::vec3& position);
+
+        void initialize() override;
+
+        std::shared_ptr<NeighborhoodInterface> create_interface();
+
+        void create_compatibility_report(CompatibilityReport& report) override;
+
+        /**
+         * @brief Returns true if the last call of find_neighbors rebuilt the neighbor lists.
+         */
+        bool were_lists_rebuilt_in_last_search() const;
+
+      private:
+        NeighborhoodSearch search;
+
+        std::vector<glm::vec3> positions_at_last_rebuild;
+        size_t inactive_particles_at_last_rebuild = 0;
+        bool rebuild_required = true;
+        bool rebuilt_in_last_search = false;
+
+        bool is_rebuild_required();
+
+        // true if the current position of the neighbor is within search_radius of the position
+        bool is_within_search_radius(const glm::vec3& position, particleIndex_t neighbor) const;
+
+        static NeighborhoodInterface::Neighbors create_interface_neighbors(
+                std::vector<NeighborhoodInterface::particleIndex_t> neighbors);
+    };
+
+    template<typename NeighborhoodSearch>
+    void VerletNeighborhoodSearch<NeighborhoodSearch>::initialize() {
+        FLUID_ASSERT(collection != nullptr);
+        search.collection = collection;
+        search.search_radius = search_radius * (1.0f + skin_factor);
+        search.initialize();
+        rebuild_required = true;
+    }
+
+    template<typename NeighborhoodSearch>
+    void VerletNeighborhoodSearch<NeighborhoodSearch>::create_compatibility_report(CompatibilityReport& report) {
+        report.begin_scope(FLUID_NAMEOF(VerletNeighborhoodSearch));
+        if (collection == nullptr) {
+            report.add_issue("ParticleCollection is null.");
+        } else {
+            if (!collection->is_type_present<MovementData3D>()) {
+                report.add_issue("Particles are missing the MovementData3D attribute.");
+            }
+            if (!collection->is_type_present<ParticleInfo>()) {
+                report.add_issue("Particles are missing the ParticleInfo attribute.");
+            }
+        }
+
+        if (skin_factor < 0.0f) {
+            report.add_issue("Skin factor is smaller than zero.");
+        }
+
+        search.create_compatibility_report(report);
+        report.end_scope();
+    }
+
+    template<typename NeighborhoodSearch>
+    bool VerletNeighborhoodSearch<NeighborhoodSearch>::is_rebuild_required() {
+        if (rebuild_required || positions_at_last_rebuild.size() != collection->size())
+            return true;
+
+        struct Movement {
+            float maximum_displacement_squared;
+            size_t inactive_particles;
+        };
+
+        auto movement = StdParallelForEach::reduce(
+                0, collection->size(), Movement {0.0f, 0},
+                [&](size_t i) -> Movement {
+                    if (collection->get<ParticleInfo>(i).type == ParticleTypeInactive)
+                        return {0.0f, 1};
+
+                    glm::vec3 displacement =
+                            collection->get<MovementData3D>(i).position - positions_at_last_rebuild[i];
+                    return {glm::dot(displacement, displacement), 0};
+                },
+                [](const Movement& a, const Movement& b) -> Movement {
+                    return {std::max(a.maximum_displacement_squared, b.maximum_displacement_squared),
+                            a.inactive_particles + b.inactive_particles};
+                });
+
+        // particles that became inactive are still contained in the lists of their former neighbors
+        if (movement.inactive_particles != inactive_particles_at_last_rebuild)
+            return true;
+
+        // two particles moving towards each other by half the skin each can just close the skin
+        float half_skin = search_radius * skin_factor * 0.5f;
+        return movement.maximum_displacement_squared > half_skin * half_skin;
+    }
+
+    template<typename NeighborhoodSearch>
+    void VerletNeighborhoodSearch<NeighborhoodSearch>::find_neighbors() {
+        FLUID_ASSERT(collection != nullptr);
+        FLUID_ASSERT(collection->is_type_present<MovementData3D>());
+        FLUID_ASSERT(collection->is_type_present<ParticleInfo>());
+
+        rebuilt_in_last_search = is_rebuild_required();
+        if (!rebuilt_in_last_search)
+            return;
+
+        // the underlying search might reorder the particles, hence the positions are stored afterwards
+        search.find_neighbors();
+
+        positions_at_last_rebuild.resize(collection->size());
+        inactive_particles_at_last_rebuild = StdParallelForEach::reduce(
+                0, collection->size(), size_t(0),
+                [&](size_t i) -> size_t {
+                    positions_at_last_rebuild[i] = collection->get<MovementData3D>(i).position;
+                    return collection->get<ParticleInfo>(i).type == ParticleTypeInactive ? 1 : 0;
+                },
+                [](size_t a, size_t b) { return a + b; });
+
+        rebuild_required = false;
+    }
+
+    template<typename NeighborhoodSearch>
+    typename VerletNeighborhoodSearch<NeighborhoodSearch>::Neighbors VerletNeighborhoodSearch<
+            NeighborhoodSearch>::get_neighbors(particleIndex_t particleIndex) {
+        return search.get_neighbors(particleIndex);
+    }
+
+    template<typename NeighborhoodSearch>
+    bool VerletNeighborhoodSearch<NeighborhoodSearch>::is_within_search_radius(const glm::vec3& position,
+            particleIndex_t neighbor) const {
+        glm::vec3 difference = collection->get<MovementData3D>(neighbor).position - position;
+        return glm::dot(difference, difference) <= search_radius * search_radius;
+    }
+
+    template<typename NeighborhoodSearch>
+    typename VerletNeighborhoodSearch<NeighborhoodSearch>::PositionNeighbors VerletNeighborhoodSearch<
+            NeighborhoodSearch>::get_neighbors(const glm::vec3& position) {
+        // every particle that is now within search_radius was within the enlarged radius of the underlying search at
+        // the last rebuild, since it moved less than half the skin
+        PositionNeighbors neighbors;
+        for (auto neighbor : search.get_neighbors(position)) {
+            if (is_within_search_radius(position, neighbor))
+                neighbors.push_back(neighbor);
+        }
+        return neighbors;
+    }
+
+    template<typename NeighborhoodSearch>
+    NeighborhoodInterface::Neighbors VerletNeighborhoodSearch<NeighborhoodSearch>::create_interface_neighbors(
+            std::vector<NeighborhoodInterface::particleIndex_t> neighbors) {
+        using Iterator = std::vector<NeighborhoodInterface::particleIndex_t>::iterator;
+        auto list = std::make_shared<std::vector<NeighborhoodInterface::particleIndex_t>>(std::move(neighbors));
+
+        auto n = NeighborhoodInterface::Neighbors();
+        n.iterator_link.begin = [list]() {
+            return new Iterator(list->begin());
+        };
+        n.iterator_link.end = [list]() {
+            return new Iterator(list->end());
+        };
+        n.iterator_link.iterator_copy = [](void* it) {
+            return new Iterator(*((Iterator*)it));
+        };
+        n.iterator_link.iterator_delete = [](void* it) {
+            delete ((Iterator*)it);
+        };
+        n.iterator_link.iterator_dereference = [](void* it) {
+            return &(*(*(Iterator*)it));
+        };
+        n.iterator_link.iterator_equals = [](void* it1, void* it2) {
+            return *((Iterator*)it1) == *((Iterator*)it2);
+        };
+        n.iterator_link.iterator_increment = [](void* it) {
+            ++(*(Iterator*)it);
+        };
+        return n;
+    }
+
+    template<typename NeighborhoodSearch>
+    std::shared_ptr<NeighborhoodInterface> VerletNeighborhoodSearch<NeighborhoodSearch>::create_interface() {
+        auto res = search.create_interface();
+
+        // the lists of the underlying search contain particles up to a distance of search_radius + skin, the
+        // components using the interface only receive the neighbors within search_radius
+        NeighborhoodInterface::Interface underlying = res->link;
+
+        res->link.get_by_index = [this](NeighborhoodInterface::particleIndex_t index) {
+            glm::vec3 position = collection->get<MovementData3D>(index).position;
+            std::vector<NeighborhoodInterface::particleIndex_t> neighbors;
+            for (auto neighbor : search.get_neighbors(index)) {
+                if (is_within_search_radius(position, neighbor))
+                    neighbors.push_back(neighbor);
+            }
+            return create_interface_neighbors(std::move(neighbors));
+        };
+
+        res->link.get_by_position_3d = [this](const glm::vec3& position) {
+            auto neighbors = get_neighbors(position);
+            return create_interface_neighbors({neighbors.begin(), neighbors.end()});
+        };
+
+        res->link.for_each_by_index = [this, underlying](NeighborhoodInterface::particleIndex_t index,
+                NeighborhoodInterface::NeighborCallback callback) {
+            glm::vec3 position = collection->get<MovementData3D>(index).position;
+            underlying.for_each_by_index(index, [&](NeighborhoodInterface::particleIndex_t neighbor) {
+                return !is_within_search_radius(position, neighbor) || callback(neighbor);
+            });
+        };
+
+        res->link.for_each_by_position_3d = [this, underlying](const glm::vec3& position,
+                NeighborhoodInterface::NeighborCallback callback) {
+            underlying.for_each_by_position_3d(position, [&](NeighborhoodInterface::particleIndex_t neighbor) {
+                return !is_within_search_radius(position, neighbor) || callback(neighbor);
+            });
+        };
+
+        res->link.gather_by_position_3d = [for_each = res->link.for_each_by_position_3d](const glm::vec3* positions,
+                size_t count, std::vector<size_t>& offsets, std::vector<NeighborhoodInterface::particleIndex_t>& indices) {
+            NeighborhoodInterface::gather_neighbors_with(for_each, positions, count, offsets, indices);
+        };
+
+        res->link.get_search_radius = [this] {
+            return this->search_radius;
+        };
+        return res;
+    }
+
+    template<typename NeighborhoodSearch>
+    bool VerletNeighborhoodSearch<NeighborhoodSearch>::were_lists_rebuilt_in_last_search() const {
+        return rebuilt_in_last_search;
+    }
+
+} // namespace LibFluid
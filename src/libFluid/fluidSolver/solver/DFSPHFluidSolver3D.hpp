@@ -0,0 +1,595 @@
+#pragma once
+
+#include "fluidSolver/IFluidSolver.hpp"
+#include "fluidSolver/MovementColumns3D.hpp"
+#include "fluidSolver/ParticleTypeIndices.hpp"
+#include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
+#include "fluidSolver/neighborhoodSearch/QuadraticNeighborhoodSearch3D.hpp"
+#include "fluidSolver/solver/settings/DFSPHSettings3D.hpp"
+#include "parallelization/StdParallelForEach.hpp"
+#include "LibFluidMath.hpp"
+
+#include <vector>
+
+namespace LibFluid {
+
+
+    struct DFSPHParticleData3D {
+        glm::vec3 predicted_velocity;
+
+        // factor that converts the density error of a particle into its stiffness
+        float alpha;
+
+        // stiffness of the current solver iteration, the pressure acceleration of the particle is stiffness / density
+        float stiffness;
+    };
+
+    struct DFSPHNeighborGradient3D {
+        uint32_t neighbor;
+        uint8_t neighbor_type;
+
+        // kernel gradient with respect to the particle, multiplied with the mass of the neighbor
+        glm::vec3 mass_weighted_gradient;
+    };
+
+
+    /**
+     * @brief Divergence-free SPH solver as described by Bender and Koschier.
+     *
+     * Each step first corrects the divergence of the velocity field, then predicts the velocities with the non
+     * pressure accelerations and corrects them until the predicted density matches the rest density. Both solves use
+     * the same per particle alpha factors, which only depend on the positions and are therefore computed once per
+     * step. The timestep is chosen before the density solve, such that the non pressure accelerations and the current
+     * velocities do not violate the cfl condition.
+     */
+    template<typename Kernel = CubicSplineKernel3D, typename NeighborhoodSearch = QuadraticNeighborhoodSearch3D,
+            typename parallel = StdParallelForEach>
+    class DFSPHFluidSolver3D : public IFluidSolverBase {
+      public:
+        Kernel kernel;
+
+        NeighborhoodSearch neighborhood_search;
+
+        DFSPHSettings3D settings;
+
+        size_t stat_last_iteration_count = 0;
+        size_t stat_last_divergence_iteration_count = 0;
+        float stat_last_average_predicted_density_error = 0.0f;
+        float stat_last_average_divergence_error = 0.0f;
+
+      private:
+        float current_timestep = 0.0f;
+
+        // the kernel derivatives are the gradients multiplied by (kernel_support / 2)^2 (see Kernel), the density
+        // change rates of both solves require the actual gradients though, otherwise the velocity corrections
+        // overshoot by the inverse of this factor
+        float gradient_scale = 1.0f;
+
+        // the positions do not change during a step, hence the mass weighted kernel gradients of all neighbors of a
+        // fluid particle i are stored once per step at neighbor_gradients[neighbor_gradient_offsets[i]] up to
+        // neighbor_gradients[neighbor_gradient_offsets[i + 1] - 1]
+        std::vector<size_t> neighbor_gradient_offsets;
+        std::vector<DFSPHNeighborGradient3D> neighbor_gradients;
+
+        // the loops that only process fluid particles iterate over the fluid indices
+        ParticleTypeIndices particle_indices;
+
+        struct SolverStatistics {
+            float error_sum = 0.0f;
+            size_t average_counter = 0;
+        };
+
+        static SolverStatistics combine_statistics(const SolverStatistics& a, const SolverStatistics& b) {
+            return {a.error_sum + b.error_sum, a.average_counter + b.average_counter};
+        }
+
+        void adapt_collection() {
+            FLUID_ASSERT(!data.collection->is_type_present<DFSPHParticleData3D>());
+            data.collection->add_type<DFSPHParticleData3D>();
+        }
+
+        glm::vec3 ComputeViscosityAcceleration(size_t particleIndex) {
+            auto& movement_data = data.collection->get<MovementData3D>(particleIndex);
+
+            const glm::vec3& position = movement_data.position;
+            const glm::vec3& velocity = movement_data.velocity;
+
+
+            glm::vec3 tmp = glm::vec3(0.0f);
+            auto neighbors = neighborhood_search.get_neighbors(particleIndex);
+            for (uint32_t neighbor : neighbors) {
+                auto type = data.collection->get<ParticleInfo>(neighbor).type;
+                if (type == ParticleTypeInactive) {
+                    continue; // don*t calculate unnecessary values for inactive particles.
+                }
+
+                const glm::vec3& neighborPosition = data.collection->get<MovementData3D>(neighbor).position;
+                const glm::vec3& neighborVelocity = data.collection->get<MovementData3D>(neighbor).velocity;
+                float neighborMass = data.collection->get<ParticleData>(neighbor).mass;
+                float neighborDensity = data.collection->get<ParticleData>(neighbor).density;
+
+                if (neighborDensity == 0.0f)
+                    continue;
+
+                glm::vec3 vij = velocity - neighborVelocity;
+                glm::vec3 xij = position - neighborPosition;
+
+                tmp += (neighborMass / neighborDensity) *
+                        (glm::dot(vij, xij) /
+                                (glm::dot(xij, xij) + 0.01f * parameters.particle_size * parameters.particle_size)) *
+                        kernel.GetKernelDerivativeReversedValue(neighborPosition, position);
+            }
+
+            return 2.0f * settings.viscosity * tmp;
+        }
+
+        template<typename Movement>
+        void compute_densities_and_factors(const Movement& movement) {
+            // the neighbor counts of fluid particles are stored while calculating the density, all other particles do
+            // not need any kernel gradients
+            neighbor_gradient_offsets.assign(data.collection->size() + 1, 0);
+
+            const auto& fluid = particle_indices.fluid();
+            parallel::loop_for(0, fluid.size(), [&](size_t f) {
+                size_t i = fluid[f];
+
+                glm::vec3 position = movement.position(i);
+
+                float density = 0.0f;
+                size_t neighbor_count = 0;
+
+                auto neighbors = neighborhood_search.get_neighbors(i);
+                for (uint32_t neighbor : neighbors) {
+                    auto type = data.collection->get<ParticleInfo>(neighbor).type;
+                    if (type == ParticleTypeInactive) {
+                        continue; // don't calculate unnecessary values for inactive particles.
+                    }
+                    neighbor_count++;
+
+                    glm::vec3 neighbor_position = movement.position(neighbor);
+                    float neighbor_mass = data.collection->get<ParticleData>(neighbor).mass;
+                    density += neighbor_mass * kernel.GetKernelValue(neighbor_position, position);
+                }
+
+                data.collection->get<ParticleData>(i).density = density;
+                neighbor_gradient_offsets[i + 1] = neighbor_count;
+            });
+
+            // the offsets of the gradients are the prefix sum of the neighbor counts
+            for (size_t i = 0; i < data.collection->size(); i++) {
+                neighbor_gradient_offsets[i + 1] += neighbor_gradient_offsets[i];
+            }
+            neighbor_gradients.resize(neighbor_gradient_offsets.back());
+
+            // store the kernel gradients and compute the alpha factors
+            parallel::loop_for(0, fluid.size(), [&](size_t f) {
+                size_t i = fluid[f];
+
+                glm::vec3 position = movement.position(i);
+
+                // sum of the mass weighted kernel gradients of all neighbors
+                glm::vec3 mass_weighted_gradient_sum = glm::vec3(0.0f);
+
+                // sum of the squared mass weighted kernel gradients of all fluid neighbors
+                float squared_mass_weighted_gradient_sum = 0.0f;
+
+                DFSPHNeighborGradient3D* cached_gradient = neighbor_gradients.data() + neighbor_gradient_offsets[i];
+
+                auto neighbors = neighborhood_search.get_neighbors(i);
+                for (uint32_t neighbor : neighbors) {
+                    auto type = data.collection->get<ParticleInfo>(neighbor).type;
+                    if (type == ParticleTypeInactive) {
+                        continue; // don't calculate unnecessary values for inactive particles.
+                    }
+
+                    glm::vec3 neighbor_position = movement.position(neighbor);
+                    float neighbor_mass = data.collection->get<ParticleData>(neighbor).mass;
+                    glm::vec3 mass_weighted_gradient =
+                            neighbor_mass * gradient_scale * kernel.GetKernelDerivativeReversedValue(neighbor_position, position);
+
+                    *cached_gradient = {(uint32_t)neighbor, type, mass_weighted_gradient};
+                    cached_gradient++;
+
+                    mass_weighted_gradient_sum += mass_weighted_gradient;
+                    if (type == ParticleTypeNormal) {
+                        squared_mass_weighted_gradient_sum += glm::dot(mass_weighted_gradient, mass_weighted_gradient);
+                    }
+                }
+                FLUID_ASSERT(cached_gradient == neighbor_gradients.data() + neighbor_gradient_offsets[i + 1]);
+
+                float denominator =
+                        glm::dot(mass_weighted_gradient_sum, mass_weighted_gradient_sum) + squared_mass_weighted_gradient_sum;
+
+                auto& dfsph_data = data.collection->get<DFSPHParticleData3D>(i);
+                if (denominator > std::numeric_limits<float>::epsilon()) {
+                    dfsph_data.alpha = data.collection->get<ParticleData>(i).density / denominator;
+                } else {
+                    // particle has no neighbors, hence it can not be corrected
+                    dfsph_data.alpha = 0.0f;
+                }
+            });
+        }
+
+        float compute_density_change_rate(size_t i) {
+            // boundary particles are treated as static
+            const glm::vec3& predicted_velocity = data.collection->get<DFSPHParticleData3D>(i).predicted_velocity;
+
+            float density_change_rate = 0.0f;
+            for (size_t n = neighbor_gradient_offsets[i]; n < neighbor_gradient_offsets[i + 1]; n++) {
+                const auto& cached = neighbor_gradients[n];
+                if (cached.neighbor_type == ParticleTypeNormal) {
+                    const auto& neighbor_dfsph_data = data.collection->get<DFSPHParticleData3D>(cached.neighbor);
+                    density_change_rate += glm::dot(predicted_velocity - neighbor_dfsph_data.predicted_velocity,
+                            cached.mass_weighted_gradient);
+                } else if (cached.neighbor_type == ParticleTypeBoundary) {
+                    density_change_rate += glm::dot(predicted_velocity, cached.mass_weighted_gradient);
+                }
+            }
+            return density_change_rate;
+        }
+
+        void apply_stiffness_to_predicted_velocities() {
+            // all stiffness values are computed before any velocity is changed, hence this is a jacobi style update
+            const auto& fluid = particle_indices.fluid();
+            parallel::loop_for(0, fluid.size(), [&](size_t f) {
+                size_t i = fluid[f];
+
+                auto& dfsph_data = data.collection->get<DFSPHParticleData3D>(i);
+                float density = data.collection->get<ParticleData>(i).density;
+                if (density == 0.0f)
+                    return;
+
+                float stiffness_by_density = dfsph_data.stiffness / density;
+
+                glm::vec3 pressure_acceleration = glm::vec3(0.0f);
+                for (size_t n = neighbor_gradient_offsets[i]; n < neighbor_gradient_offsets[i + 1]; n++) {
+                    const auto& cached = neighbor_gradients[n];
+                    if (cached.neighbor_type == ParticleTypeNormal) {
+                        float neighbor_stiffness = data.collection->get<DFSPHParticleData3D>(cached.neighbor).stiffness;
+                        float neighbor_density = data.collection->get<ParticleData>(cached.neighbor).density;
+                        float neighbor_stiffness_by_density = neighbor_density == 0.0f ? 0.0f : neighbor_stiffness / neighbor_density;
+                        pressure_acceleration -= (stiffness_by_density + neighbor_stiffness_by_density) * cached.mass_weighted_gradient;
+                    } else if (cached.neighbor_type == ParticleTypeBoundary) {
+                        pressure_acceleration -= stiffness_by_density * cached.mass_weighted_gradient;
+                    }
+                }
+
+                dfsph_data.predicted_velocity += current_timestep * pressure_acceleration;
+            });
+        }
+
+        void correct_divergence_error() {
+            // the solve works on the predicted velocities, which are the current velocities at this point
+            const auto& fluid = particle_indices.fluid();
+            parallel::loop_for(0, fluid.size(), [&](size_t f) {
+                size_t i = fluid[f];
+                data.collection->get<DFSPHParticleData3D>(i).predicted_velocity =
+                        data.collection->get<MovementData3D>(i).velocity;
+            });
+
+            stat_last_divergence_iteration_count = 0;
+            for (size_t iteration = 0; iteration < settings.max_number_of_divergence_iterations; iteration++) {
+                // compute the stiffness of each particle from the divergence of its velocity
+                SolverStatistics statistics = parallel::reduce(
+                        0, fluid.size(), SolverStatistics(),
+                        [&](size_t f) {
+                            SolverStatistics result;
+                            size_t i = fluid[f];
+
+                            auto& dfsph_data = data.collection->get<DFSPHParticleData3D>(i);
+
+                            // only compression is corrected, expansion is handled by the density solve
+                            float density_change_rate = std::fmax(0.0f, compute_density_change_rate(i));
+
+                            // the timestep cancels out in the velocity change, it only scales the error
+                            dfsph_data.stiffness = density_change_rate / current_timestep * dfsph_data.alpha;
+
+                            result.error_sum = density_change_rate * current_timestep / parameters.rest_density;
+                            result.average_counter = 1;
+                            return result;
+                        },
+                        combine_statistics);
+
+                apply_stiffness_to_predicted_velocities();
+
+                this->stat_last_divergence_iteration_count = iteration + 1;
+
+                float average_divergence_error = statistics.error_sum;
+                if (statistics.average_counter > 0) {
+                    average_divergence_error /= (float)statistics.average_counter;
+                }
+                this->stat_last_average_divergence_error = average_divergence_error;
+
+                // check termination criteria
+                if (iteration >= settings.min_number_of_divergence_iterations - 1) {
+                    if (average_divergence_error <= settings.max_divergence_error_allowed) {
+                        break;
+                    }
+                }
+            }
+
+            parallel::loop_for(0, fluid.size(), [&](size_t f) {
+                size_t i = fluid[f];
+                data.collection->get<MovementData3D>(i).velocity =
+                        data.collection->get<DFSPHParticleData3D>(i).predicted_velocity;
+            });
+        }
+
+        void correct_density_error() {
+            const auto& fluid = particle_indices.fluid();
+
+            stat_last_iteration_count = 0;
+            for (size_t iteration = 0; iteration < settings.max_number_of_iterations; iteration++) {
+                // compute the stiffness of each particle from its predicted density
+                SolverStatistics statistics = parallel::reduce(
+                        0, fluid.size(), SolverStatistics(),
+                        [&](size_t f) {
+                            SolverStatistics result;
+                            size_t i = fluid[f];
+
+                            auto& dfsph_data = data.collection->get<DFSPHParticleData3D>(i);
+                            auto& particle_data = data.collection->get<ParticleData>(i);
+
+                            float predicted_density =
+                                    particle_data.density + current_timestep * compute_density_change_rate(i);
+
+                            // only compression is corrected
+                            float density_error = std::fmax(0.0f, predicted_density - parameters.rest_density);
+
+                            dfsph_data.stiffness = density_error / Math::pow2(current_timestep) * dfsph_data.alpha;
+
+                            // the stiffness values of all iterations sum up to the pressure of the particle
+                            particle_data.pressure += dfsph_data.stiffness * particle_data.density;
+
+                            result.error_sum = density_error / parameters.rest_density;
+                            result.average_counter = 1;
+                            return result;
+                        },
+                        combine_statistics);
+
+                apply_stiffness_to_predicted_velocities();
+
+                this->stat_last_iteration_count = iteration + 1;
+
+                float average_predicted_density_error = statistics.error_sum;
+                if (statistics.average_counter > 0) {
+                    average_predicted_density_error /= (float)statistics.average_counter;
+                }
+                this->stat_last_average_predicted_density_error = average_predicted_density_error;
+
+                // check termination criteria
+                if (iteration >= settings.min_number_of_iterations - 1) {
+                    if (average_predicted_density_error <= settings.max_density_error_allowed) {
+                        break;
+                    }
+                }
+            }
+        }
+
+      public:
+        void initialize() override {
+            FLUID_ASSERT(data.collection != nullptr);
+            if (data.has_data_changed()) {
+                data.acknowledge_data_change();
+
+                if (!data.collection->is_type_present<DFSPHParticleData3D>())
+                    adapt_collection();
+
+                neighborhood_search.collection = data.collection;
+                neighborhood_search.initialize();
+            }
+
+            if (parameters.has_data_changed()) {
+                parameters.acknowledge_data_change();
+
+                neighborhood_search.search_radius = parameters.particle_size * Math::kernel_support_factor;
+                neighborhood_search.initialize();
+                kernel.kernel_support = parameters.particle_size * Math::kernel_support_factor;
+                gradient_scale = 1.0f / Math::pow2(kernel.kernel_support / 2.0f);
+                kernel.initialize();
+            }
+
+            if (settings.has_data_changed()) {
+                settings.acknowledge_data_change();
+            }
+        }
+
+        void execute_neighborhood_search() override {
+            initialize();
+
+            FLUID_ASSERT(data.collection != nullptr)
+            FLUID_ASSERT(data.collection->is_type_present<MovementData3D>());
+            FLUID_ASSERT(data.collection->is_type_present<ParticleData>());
+            FLUID_ASSERT(data.collection->is_type_present<ParticleInfo>());
+            FLUID_ASSERT(data.collection->is_type_present<ExternalForces3D>());
+            FLUID_ASSERT(data.collection->is_type_present<DFSPHParticleData3D>());
+
+            // find neighbors for all particles
+            FLUID_ASSERT(neighborhood_search.collection == data.collection);
+            neighborhood_search.find_neighbors();
+        }
+
+        void execute_simulation_step(Timepoint& timestep) override {
+            initialize();
+
+            FLUID_ASSERT(data.collection != nullptr)
+            FLUID_ASSERT(data.collection->is_type_present<MovementData3D>());
+            FLUID_ASSERT(data.collection->is_type_present<ParticleData>());
+            FLUID_ASSERT(data.collection->is_type_present<ParticleInfo>());
+            FLUID_ASSERT(data.collection->is_type_present<ExternalForces3D>());
+            FLUID_ASSERT(data.collection->is_type_present<DFSPHParticleData3D>());
+
+            FLUID_ASSERT(settings.max_number_of_iterations >= settings.min_number_of_iterations);
+            FLUID_ASSERT(settings.max_density_error_allowed > 0.0f);
+            FLUID_ASSERT(settings.max_number_of_divergence_iterations >= settings.min_number_of_divergence_iterations);
+            FLUID_ASSERT(settings.max_divergence_error_allowed > 0.0f);
+
+            FLUID_ASSERT(timestep.desired_time_step > 0.0f);
+
+            FLUID_ASSERT(data.timestep_generator != nullptr);
+
+            // the divergence solve uses the desired timestep, the actual timestep is not known yet
+            current_timestep = timestep.desired_time_step;
+
+            particle_indices.update(*data.collection);
+
+            // the alpha factors only depend on the positions, hence they are used by both solves. The positions are read
+            // from the structure of arrays columns if they were added to the collection.
+            MovementColumns3D::visit<parallel>(*data.collection,
+                    [&](const auto& movement) { compute_densities_and_factors(movement); });
+
+            // make the velocity field divergence free, which corresponds to the end of the previous step
+            if (settings.divergence_solve) {
+                correct_divergence_error();
+            } else {
+                stat_last_divergence_iteration_count = 0;
+                stat_last_average_divergence_error = 0.0f;
+            }
+
+            // calculate non pressure accelerations and keep track of the maximal velocity and acceleration of all fluid
+            // particles
+            struct MovementStatistics {
+                float max_velocity_squared = 0.0f;
+                float max_acceleration_squared = 0.0f;
+            };
+
+            MovementStatistics movement_statistics = parallel::reduce(
+                    0, data.collection->size(), MovementStatistics(),
+                    [&](size_t i) {
+                        MovementStatistics result;
+
+                        auto type = data.collection->get<ParticleInfo>(i).type;
+                        if (type == ParticleTypeInactive) {
+                            return result; // don't calculate unnecessary data
+                        }
+
+                        glm::vec3& non_pressure_acceleration =
+                                data.collection->get<ExternalForces3D>(i).non_pressure_acceleration;
+
+                        // adding gravity and viscosity to non pressure acceleration
+                        if (type != ParticleTypeBoundary) {
+                            non_pressure_acceleration += glm::vec3(0.0f, -parameters.gravity, 0.0f);
+                            non_pressure_acceleration += ComputeViscosityAcceleration(i);
+                        }
+
+                        if (type == ParticleTypeNormal) {
+                            const glm::vec3& velocity = data.collection->get<MovementData3D>(i).velocity;
+                            result.max_velocity_squared = glm::dot(velocity, velocity);
+                            result.max_acceleration_squared = glm::dot(non_pressure_acceleration, non_pressure_acceleration);
+                        }
+
+                        return result;
+                    },
+                    [](const MovementStatistics& a, const MovementStatistics& b) {
+                        MovementStatistics result;
+                        result.max_velocity_squared = std::fmax(a.max_velocity_squared, b.max_velocity_squared);
+                        result.max_acceleration_squared = std::fmax(a.max_acceleration_squared, b.max_acceleration_squared);
+                        return result;
+                    });
+
+            // adapting timestep in order to not invalidate cfl condition
+            {
+                float max_velocity = sqrt(movement_statistics.max_velocity_squared);
+                float max_acceleration = sqrt(movement_statistics.max_acceleration_squared);
+                float corrected_timestep = data.timestep_generator->get_non_cfl_validating_timestep(max_acceleration, max_velocity);
+                corrected_timestep = std::fmin(corrected_timestep, timestep.desired_time_step);
+                FLUID_ASSERT(corrected_timestep > 0.0f);
+                timestep.actual_time_step = corrected_timestep;
+                current_timestep = timestep.actual_time_step;
+            }
+
+            // calculate predicted velocity and reset the pressure
+            parallel::loop_for(0, data.collection->size(), [&](size_t i) {
+                auto type = data.collection->get<ParticleInfo>(i).type;
+                if (type == ParticleTypeInactive) {
+                    return; // don't calculate unnecessary data
+                }
+
+                glm::vec3& non_pressure_acceleration =
+                        data.collection->get<ExternalForces3D>(i).non_pressure_acceleration;
+
+                data.collection->get<DFSPHParticleData3D>(i).predicted_velocity =
+                        data.collection->get<MovementData3D>(i).velocity + current_timestep * non_pressure_acceleration;
+                data.collection->get<ParticleData>(i).pressure = 0.0f;
+
+                // reset non pressure accelerations
+                non_pressure_acceleration = glm::vec3(0.0f);
+            });
+
+            correct_density_error();
+
+            // integrate particle movement
+            parallel::loop_for(0, data.collection->size(), [&](size_t i) {
+                // update velocity and position of all particles
+
+                auto type = data.collection->get<ParticleInfo>(i).type;
+                if (type == ParticleTypeInactive) {
+                    return; // don't calculate unnecessary values for inactive particles.
+                }
+
+                auto& movement_data = data.collection->get<MovementData3D>(i);
+                const glm::vec3& predicted_velocity = data.collection->get<DFSPHParticleData3D>(i).predicted_velocity;
+
+                // integrate using euler cromer
+                movement_data.acceleration = (predicted_velocity - movement_data.velocity) / current_timestep;
+                movement_data.velocity = predicted_velocity;
+                movement_data.position = movement_data.position + current_timestep * movement_data.velocity;
+            });
+        }
+
+
+        virtual std::shared_ptr<NeighborhoodInterface> create_neighborhood_interface() override {
+            return neighborhood_search.create_interface();
+        }
+
+        void create_compatibility_report(CompatibilityReport& report) override {
+            initialize();
+
+            report.begin_scope(FLUID_NAMEOF(DFSPHFluidSolver3D));
+            if (data.collection == nullptr) {
+                report.add_issue("Particle collection is null.");
+            } else {
+                if (!data.collection->is_type_present<MovementData3D>()) {
+                    report.add_issue("Particles are missing the MovementData3D attribute.");
+                }
+                if (!data.collection->is_type_present<ParticleData>()) {
+                    report.add_issue("Particles are missing the ParticleData attribute.");
+                }
+                if (!data.collection->is_type_present<ParticleInfo>()) {
+                    report.add_issue("Particles are missing the ParticleInfo attribute.");
+                }
+                if (!data.collection->is_type_present<ExternalForces3D>()) {
+                    report.add_issue("Particles are missing the ExternalForces3D attribute.");
+                }
+                if (!data.collection->is_type_present<DFSPHParticleData3D>()) {
+                    report.add_issue("Particles are missing the DFSPHParticleData3D attribute.");
+                }
+            }
+
+            if (settings.max_number_of_iterations < settings.min_number_of_iterations) {
+                report.add_issue("Max iterations are less than min number of iterations.");
+            }
+
+            if (settings.max_density_error_allowed <= 0.0f) {
+                report.add_issue("MaxDensityErrorAllowed is smaller or equal to zero.");
+            }
+
+            if (settings.max_number_of_divergence_iterations < settings.min_number_of_divergence_iterations) {
+                report.add_issue("Max divergence iterations are less than min number of divergence iterations.");
+            }
+
+            if (settings.max_divergence_error_allowed <= 0.0f) {
+                report.add_issue("MaxDivergenceErrorAllowed is smaller or equal to zero.");
+            }
+
+            if (data.timestep_generator == nullptr) {
+                report.add_issue("Timestep generator is null");
+            }
+            neighborhood_search.create_compatibility_report(report);
+            kernel.create_compatibility_report(report);
+
+            report.end_scope();
+        }
+    };
+
+} // namespace LibFluid
@@ -1,12 +1,18 @@
 #pragma once
 
 #include "fluidSolver/IFluidSolver.hpp"
+#include "fluidSolver/MovementColumns3D.hpp"
+#include "fluidSolver/ParticleTypeIndices.hpp"
+#include "fluidSolver/kernel/BatchedCubicSplineKernel3D.hpp"
 #include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
 #include "fluidSolver/neighborhoodSearch/QuadraticNeighborhoodSearch3D.hpp"
 #include "fluidSolver/solver/settings/IISPHSettings3D.hpp"
 #include "parallelization/StdParallelForEach.hpp"
 #include "LibFluidMath.hpp"
 
+#include <type_traits>
+#include <vector>
+
 namespace LibFluid {
 
 
@@ -18,6 +24,14 @@ namespace LibFluid {
         float predicted_density_error;
     };
 
+    struct IISPHNeighborGradient3D {
+        uint32_t neighbor;
+        uint8_t neighbor_type;
+
+        // kernel gradient with respect to the particle, multiplied with the mass of the neighbor
+        glm::vec3 mass_weighted_gradient;
+    };
+
 
     template<typename Kernel = CubicSplineKernel3D, typename NeighborhoodSearch = QuadraticNeighborhoodSearch3D,
             typename parallel = StdParallelForEach>
@@ -35,16 +49,30 @@ namespace LibFluid {
       private:
         float current_timestep = 0.0f;
 
+        // the positions do not change during the pressure solve, hence the mass weighted kernel gradients of all
+        // neighbors of a fluid particle i are stored once per step at neighbor_gradients[neighbor_gradient_offsets[i]]
+        // up to neighbor_gradients[neighbor_gradient_offsets[i + 1] - 1]
+        std::vector<size_t> neighbor_gradient_offsets;
+        std::vector<IISPHNeighborGradient3D> neighbor_gradients;
+
+        // evaluates the cubic spline for whole neighborhoods with the vector instructions of the cpu
+        BatchedCubicSplineKernel3D batched_kernel;
+
+        // contribution of each particle to the density of its neighbors relative to the kernel value
+        std::vector<float> density_weights;
+
+        // the loops that only process fluid particles iterate over the fluid indices
+        ParticleTypeIndices particle_indices;
+
         void adapt_collection() {
             FLUID_ASSERT(!data.collection->is_type_present<IISPHParticleData3D>());
             data.collection->add_type<IISPHParticleData3D>();
         }
 
-        glm::vec3 ComputeViscosityAcceleration(size_t particleIndex) {
-            auto& movement_data = data.collection->get<MovementData3D>(particleIndex);
-
-            const glm::vec3& position = movement_data.position;
-            const glm::vec3& velocity = movement_data.velocity;
+        template<typename Movement>
+        glm::vec3 ComputeViscosityAcceleration(size_t particleIndex, const Movement& movement) {
+            glm::vec3 position = movement.position(particleIndex);
+            glm::vec3 velocity = movement.velocity(particleIndex);
 
 
             glm::vec3 tmp = glm::vec3(0.0f);
@@ -55,8 +83,8 @@ namespace LibFluid {
                     continue; // don*t calculate unnecessary values for inactive particles.
                 }
 
-                const glm::vec3& neighborPosition = data.collection->get<MovementData3D>(neighbor).position;
-                const glm::vec3& neighborVelocity = data.collection->get<MovementData3D>(neighbor).velocity;
+                glm::vec3 neighborPosition = movement.position(neighbor);
+                glm::vec3 neighborVelocity = movement.velocity(neighbor);
                 float neighborMass = data.collection->get<ParticleData>(neighbor).mass;
                 float neighborDensity = data.collection->get<ParticleData>(neighbor).density;
 
@@ -75,6 +103,125 @@ namespace LibFluid {
             return 2.0f * settings.viscosity * tmp;
         }
 
+        // sets the pressure to zero or warm starts it, computes the non pressure accelerations, the predicted velocities
+        // and the densities and counts the neighbors of the fluid particles
+        template<typename Movement>
+        void compute_densities_and_predicted_velocities(const Movement& movement) {
+            // the type and mass of a neighbor are folded into a single weight for the vectorized density computation
+            bool vectorized_density = std::is_same_v<Kernel, CubicSplineKernel3D> && settings.vectorized_density_computation;
+            if (vectorized_density) {
+                density_weights.resize(data.collection->size());
+                parallel::loop_for(0, data.collection->size(), [&](size_t i) {
+                    auto type = data.collection->get<ParticleInfo>(i).type;
+                    float mass = data.collection->get<ParticleData>(i).mass;
+                    if (type == ParticleTypeBoundary && settings.single_layer_boundary) {
+                        mass *= settings.single_layer_boundary_gamma_1; // scale the boundary particles contribution
+                    }
+                    density_weights[i] = type == ParticleTypeInactive ? 0.0f : mass;
+                });
+            }
+            BatchedCubicSplineKernel3D::Positions positions = movement.batched_positions();
+
+            // set pressure to zero, calculate density, calculate non pressure accelerations and predicted velocity
+            parallel::loop_for(0, data.collection->size(), [&](size_t particle_index) {
+                auto particle_type = data.collection->get<ParticleInfo>(particle_index).type;
+
+                if (particle_type == ParticleTypeInactive) {
+                    return; // don't calculate unnecessary data
+                }
+
+                auto& particle_data = data.collection->get<ParticleData>(particle_index);
+                auto& movement_data = data.collection->get<MovementData3D>(particle_index);
+
+                // set pressure to zero or start with the scaled pressure of the previous step
+                if (settings.warm_start_pressure) {
+                    particle_data.pressure *= settings.warm_start_pressure_factor;
+                } else {
+                    particle_data.pressure = 0.0f;
+                }
+
+                // compute non pressure accelerations and predicted velocity
+                {
+                    glm::vec3& nonPressureAcc =
+                            data.collection->get<ExternalForces3D>(particle_index).non_pressure_acceleration;
+                    const glm::vec3& velocity = movement_data.velocity;
+
+                    // adding gravity to non pressure acceleration
+                    if (particle_type != ParticleTypeBoundary) {
+                        nonPressureAcc += glm::vec3(0.0f, -parameters.gravity, 0.0f);
+                        nonPressureAcc += ComputeViscosityAcceleration(particle_index, movement);
+                    }
+
+                    // calculate predicted velocity
+                    glm::vec3 predictedVelocity = velocity + current_timestep * nonPressureAcc;
+
+                    // set predicted velocity and original non pressure acceleration
+                    auto& ip = data.collection->get<IISPHParticleData3D>(particle_index);
+                    ip.predicted_velocity = predictedVelocity;
+                    ip.original_non_pressure_acceleration = nonPressureAcc;
+
+                    // reset non pressure accelerations
+                    nonPressureAcc = glm::vec3(0.0f);
+                }
+
+                // compute density
+                {
+                    if (particle_type == ParticleTypeBoundary) {
+                        return; // don't calculate density for the boundary particles
+                    }
+
+                    float density = 0.0f;
+                    size_t neighbor_count = 0;
+
+                    glm::vec3 position = movement.position(particle_index);
+                    auto neighbors = neighborhood_search.get_neighbors(particle_index);
+                    if (vectorized_density) {
+                        uint32_t buffer[BatchedCubicSplineKernel3D::neighbor_buffer_size];
+                        size_t buffered = 0;
+                        for (uint32_t neighbor : neighbors) {
+                            if (data.collection->get<ParticleInfo>(neighbor).type == ParticleTypeInactive) {
+                                continue; // don't calculate unnecessary values for inactive particles.
+                            }
+                            neighbor_count++;
+
+                            buffer[buffered++] = neighbor;
+                            if (buffered == BatchedCubicSplineKernel3D::neighbor_buffer_size) {
+                                density += batched_kernel.sum_weighted_values(position, buffer, buffered, positions, density_weights.data());
+                                buffered = 0;
+                            }
+                        }
+                        density += batched_kernel.sum_weighted_values(position, buffer, buffered, positions, density_weights.data());
+                    } else {
+                        for (uint32_t neighbor : neighbors) {
+                            auto type = data.collection->get<ParticleInfo>(neighbor).type;
+                            if (type == ParticleTypeInactive) {
+                                continue; // don't calculate unnecessary values for inactive particles.
+                            }
+                            neighbor_count++;
+
+                            if (!settings.single_layer_boundary) {
+                                // multi layer boundaries are expected
+                                glm::vec3 neighbor_position = movement.position(neighbor);
+                                float neighbor_mass = data.collection->get<ParticleData>(neighbor).mass;
+                                density += neighbor_mass * kernel.GetKernelValue(neighbor_position, position);
+                            } else {
+                                // single layer boundaries are activated
+                                glm::vec3 neighbor_position = movement.position(neighbor);
+                                float neighbor_mass = data.collection->get<ParticleData>(neighbor).mass;
+                                if (type == ParticleTypeBoundary) {
+                                    neighbor_mass *= settings.single_layer_boundary_gamma_1; // scale the boundary particles contribution
+                                }
+                                density += neighbor_mass * kernel.GetKernelValue(neighbor_position, position);
+                            }
+                        }
+                    }
+
+                    particle_data.density = density;
+                    neighbor_gradient_offsets[particle_index + 1] = neighbor_count;
+                }
+            });
+        }
+
       public:
         void initialize() override {
             FLUID_ASSERT(data.collection != nullptr);
@@ -95,6 +242,8 @@ namespace LibFluid {
                 neighborhood_search.initialize();
                 kernel.kernel_support = parameters.particle_size * Math::kernel_support_factor;
                 kernel.initialize();
+                batched_kernel.kernel_support = parameters.particle_size * Math::kernel_support_factor;
+                batched_kernel.initialize();
             }
 
             if (settings.has_data_changed()) {
@@ -137,96 +286,52 @@ namespace LibFluid {
             // set the current timestep
             current_timestep = timestep.desired_time_step;
 
-            // set pressure to zero, calculate density, calculate non pressure accelerations and predicted velocity
-            parallel::loop_for(0, data.collection->size(), [&](size_t particle_index) {
-                auto particle_type = data.collection->get<ParticleInfo>(particle_index).type;
-
-                if (particle_type == ParticleTypeInactive) {
-                    return; // don't calculate unnecessary data
-                }
-
-                auto& particle_data = data.collection->get<ParticleData>(particle_index);
-                auto& movement_data = data.collection->get<MovementData3D>(particle_index);
-
-                // set pressure to zero
-                particle_data.pressure = 0.0f;
-
-                // compute non pressure accelerations and predicted velocity
-                {
-                    glm::vec3& nonPressureAcc =
-                            data.collection->get<ExternalForces3D>(particle_index).non_pressure_acceleration;
-                    const glm::vec3& velocity = movement_data.velocity;
-
-                    // adding gravity to non pressure acceleration
-                    if (particle_type != ParticleTypeBoundary) {
-                        nonPressureAcc += glm::vec3(0.0f, -parameters.gravity, 0.0f);
-                        nonPressureAcc += ComputeViscosityAcceleration(particle_index);
-                    }
-
-                    // calculate predicted velocity
-                    glm::vec3 predictedVelocity = velocity + current_timestep * nonPressureAcc;
-
-                    // set predicted velocity and original non pressure acceleration
-                    auto& ip = data.collection->get<IISPHParticleData3D>(particle_index);
-                    ip.predicted_velocity = predictedVelocity;
-                    ip.original_non_pressure_acceleration = nonPressureAcc;
-
-                    // reset non pressure accelerations
-                    nonPressureAcc = glm::vec3(0.0f);
-                }
-
-                // compute density
-                {
-                    if (particle_type == ParticleTypeBoundary) {
-                        return; // don't calculate density for the boundary particles
-                    }
+            // without any particles there is nothing to simulate and the columns of the collection may not exist
+            if (data.collection->size() == 0) {
+                return;
+            }
 
-                    float density = 0.0f;
+            particle_indices.update(*data.collection);
+            const auto& fluid = particle_indices.fluid();
 
-                    const glm::vec3& position = movement_data.position;
-                    auto neighbors = neighborhood_search.get_neighbors(particle_index);
-                    for (uint32_t neighbor : neighbors) {
-                        auto type = data.collection->get<ParticleInfo>(neighbor).type;
-                        if (type == ParticleTypeInactive) {
-                            continue; // don't calculate unnecessary values for inactive particles.
-                        }
+            // the neighbor counts of fluid particles are stored while calculating the density, all other particles do
+            // not need any kernel gradients
+            neighbor_gradient_offsets.assign(data.collection->size() + 1, 0);
 
-                        if (!settings.single_layer_boundary) {
-                            // multi layer boundaries are expected
-                            const glm::vec3& neighbor_position = data.collection->get<MovementData3D>(neighbor).position;
-                            float neighbor_mass = data.collection->get<ParticleData>(neighbor).mass;
-                            density += neighbor_mass * kernel.GetKernelValue(neighbor_position, position);
-                        } else {
-                            // single layer boundaries are activated
-                            const glm::vec3& neighbor_position = data.collection->get<MovementData3D>(neighbor).position;
-                            float neighbor_mass = data.collection->get<ParticleData>(neighbor).mass;
-                            if (type == ParticleTypeBoundary) {
-                                neighbor_mass *= settings.single_layer_boundary_gamma_1; // scale the boundary particles contribution
-                            }
-                            density += neighbor_mass * kernel.GetKernelValue(neighbor_position, position);
-                        }
-                    }
+            // positions and velocities are read from the structure of arrays columns if they were added to the collection
+            MovementColumns3D::visit<parallel>(*data.collection,
+                    [&](const auto& movement) { compute_densities_and_predicted_velocities(movement); });
 
-                    particle_data.density = density;
-                }
-            });
+            // the offsets of the gradients are the prefix sum of the neighbor counts
+            for (size_t i = 0; i < data.collection->size(); i++) {
+                neighbor_gradient_offsets[i + 1] += neighbor_gradient_offsets[i];
+            }
+            neighbor_gradients.resize(neighbor_gradient_offsets.back());
 
 
             // compute source term and diagonal element
-            parallel::loop_for(0, data.collection->size(), [&](size_t i) {
-                auto type = data.collection->get<ParticleInfo>(i).type;
-                if (type == ParticleTypeInactive)
-                    return; // we do not want to process inactive particles
-                if (type == ParticleTypeBoundary)
-                    return; // we do not want to process boundary particles
+            parallel::loop_for(0, fluid.size(), [&](size_t f) {
+                size_t i = fluid[f];
 
                 auto& iisph_data = data.collection->get<IISPHParticleData3D>(i);
                 auto& movement_data = data.collection->get<MovementData3D>(i);
                 auto& particle_data = data.collection->get<ParticleData>(i);
 
-                // compute source term
+                // compute source term and diagonal element, store the kernel gradients for the pressure solve
                 {
                     float neighbor_contribution = 0.0f;
+
+                    // inner part of the first sum of the diagonal element
+                    glm::vec3 inner_part_of_sum = glm::vec3(0.0f);
+
+                    // sum of the mass weighted kernel gradients of all neighbors
+                    glm::vec3 mass_weighted_gradient_sum = glm::vec3(0.0f);
+
+                    // contribution of the particle itself to the fluid neighbors
+                    float own_contribution = 0.0f;
+
+                    IISPHNeighborGradient3D* cached_gradient = neighbor_gradients.data() + neighbor_gradient_offsets[i];
+
                     auto neighbors = neighborhood_search.get_neighbors(i);
                     for (auto neighbor : neighbors) {
                         auto type = data.collection->get<ParticleInfo>(neighbor).type;
@@ -238,102 +343,45 @@ namespace LibFluid {
                         auto& neighbor_iisph_data = data.collection->get<IISPHParticleData3D>(neighbor);
                         auto& neighbor_movement_data = data.collection->get<MovementData3D>(neighbor);
 
+                        glm::vec3 gradient =
+                                kernel.GetKernelDerivativeReversedValue(neighbor_movement_data.position, movement_data.position);
+                        glm::vec3 mass_weighted_gradient = neighbor_particle_data.mass * gradient;
+
+                        *cached_gradient = {(uint32_t)neighbor, type, mass_weighted_gradient};
+                        cached_gradient++;
+
+                        mass_weighted_gradient_sum += mass_weighted_gradient;
+
                         if (type == ParticleTypeNormal) {
-                            neighbor_contribution +=
-                                    neighbor_particle_data.mass *
-                                    glm::dot(iisph_data.predicted_velocity - neighbor_iisph_data.predicted_velocity,
-                                            kernel.GetKernelDerivativeReversedValue(neighbor_movement_data.position,
-                                                    movement_data.position));
-                        } else if (type == ParticleTypeBoundary) {
-                            neighbor_contribution +=
-                                    neighbor_particle_data.mass *
-                                    glm::dot(iisph_data.predicted_velocity,
-                                            kernel.GetKernelDerivativeReversedValue(neighbor_movement_data.position,
-                                                    movement_data.position));
-                        }
-                    }
+                            neighbor_contribution += glm::dot(
+                                    iisph_data.predicted_velocity - neighbor_iisph_data.predicted_velocity, mass_weighted_gradient);
 
-                    iisph_data.source_term =
-                            parameters.rest_density - particle_data.density - current_timestep * neighbor_contribution;
-                }
+                            inner_part_of_sum -= mass_weighted_gradient / Math::pow2(parameters.rest_density);
 
-                // compute diagonal element
-                {
-                    // calculate the inner part of the sum
-                    glm::vec3 inner_part_of_sum = glm::vec3(0.0f);
-                    {
-                        auto neighbors = neighborhood_search.get_neighbors(i);
-                        for (auto neighbor : neighbors) {
-                            auto type = data.collection->get<ParticleInfo>(neighbor).type;
-                            if (type == ParticleTypeInactive) {
-                                continue; // don't calculate unnecessary values for inactive particles.
-                            }
+                            // the gradient with respect to the neighbor is the negated gradient
+                            own_contribution -= particle_data.mass / Math::pow2(parameters.rest_density) *
+                                    glm::dot(gradient, mass_weighted_gradient);
+                        } else if (type == ParticleTypeBoundary) {
+                            neighbor_contribution += glm::dot(iisph_data.predicted_velocity, mass_weighted_gradient);
 
-                            auto& neighbor_particle_data = data.collection->get<ParticleData>(neighbor);
-                            auto& neighbor_iisph_data = data.collection->get<IISPHParticleData3D>(neighbor);
-                            auto& neighbor_movement_data = data.collection->get<MovementData3D>(neighbor);
-
-                            if (type == ParticleTypeNormal) {
-                                inner_part_of_sum -= neighbor_particle_data.mass / Math::pow2(parameters.rest_density) *
-                                        kernel.GetKernelDerivativeReversedValue(
-                                                neighbor_movement_data.position, movement_data.position);
-                            } else if (type == ParticleTypeBoundary) {
-                                // TODO: gamma is used here even if single layer boundaries are deactivated?
-                                if (settings.single_layer_boundary) {
-                                    inner_part_of_sum -= 2.0f * settings.gamma * neighbor_particle_data.mass /
-                                            Math::pow2(parameters.rest_density) *
-                                            kernel.GetKernelDerivativeReversedValue(
-                                                    neighbor_movement_data.position, movement_data.position);
-                                } else {
-                                    // TODO: check if we can leave out gamma here
-                                    inner_part_of_sum -= 2.0f * neighbor_particle_data.mass /
-                                            Math::pow2(parameters.rest_density) *
-                                            kernel.GetKernelDerivativeReversedValue(
-                                                    neighbor_movement_data.position, movement_data.position);
-                                }
+                            // TODO: gamma is used here even if single layer boundaries are deactivated?
+                            if (settings.single_layer_boundary) {
+                                inner_part_of_sum -=
+                                        2.0f * settings.gamma * mass_weighted_gradient / Math::pow2(parameters.rest_density);
+                            } else {
+                                // TODO: check if we can leave out gamma here
+                                inner_part_of_sum -= 2.0f * mass_weighted_gradient / Math::pow2(parameters.rest_density);
                             }
                         }
                     }
+                    FLUID_ASSERT(cached_gradient == neighbor_gradients.data() + neighbor_gradient_offsets[i + 1]);
 
-                    // calculate the diagonal element
-                    float diagonal_element = 0.0f;
-                    {
-                        auto neighbors = neighborhood_search.get_neighbors(i);
-                        for (auto neighbor : neighbors) {
-                            auto type = data.collection->get<ParticleInfo>(neighbor).type;
-                            if (type == ParticleTypeInactive) {
-                                continue; // don't calculate unnecessary values for inactive particles.
-                            }
-
-                            auto& neighbor_particle_data = data.collection->get<ParticleData>(neighbor);
-                            auto& neighbor_iisph_data = data.collection->get<IISPHParticleData3D>(neighbor);
-                            auto& neighbor_movement_data = data.collection->get<MovementData3D>(neighbor);
-
-                            if (type == ParticleTypeNormal) {
-                                diagonal_element +=
-                                        neighbor_particle_data.mass *
-                                        glm::dot(inner_part_of_sum,
-                                                kernel.GetKernelDerivativeReversedValue(neighbor_movement_data.position,
-                                                        movement_data.position));
-
-                                diagonal_element +=
-                                        neighbor_particle_data.mass *
-                                        glm::dot(particle_data.mass / Math::pow2(parameters.rest_density) *
-                                                        kernel.GetKernelDerivativeReversedValue(
-                                                                movement_data.position, neighbor_movement_data.position),
-                                                kernel.GetKernelDerivativeReversedValue(neighbor_movement_data.position,
-                                                        movement_data.position));
-                            } else if (type == ParticleTypeBoundary) {
-                                diagonal_element +=
-                                        neighbor_particle_data.mass *
-                                        glm::dot(inner_part_of_sum,
-                                                kernel.GetKernelDerivativeReversedValue(neighbor_movement_data.position,
-                                                        movement_data.position));
-                            }
-                        }
+                    iisph_data.source_term =
+                            parameters.rest_density - particle_data.density - current_timestep * neighbor_contribution;
 
-                        diagonal_element *= Math::pow2(current_timestep);
-                    }
+                    // inner_part_of_sum does not depend on the neighbor, hence it can be moved out of the first sum
+                    float diagonal_element = glm::dot(inner_part_of_sum, mass_weighted_gradient_sum) + own_contribution;
+                    diagonal_element *= Math::pow2(current_timestep);
                     iisph_data.diagonal_element = diagonal_element;
                 }
             });
@@ -345,12 +393,8 @@ namespace LibFluid {
             // start iterations
             for (size_t iteration = 0; iteration < settings.max_number_of_iterations; iteration++) {
                 // compute pressure acceleration
-                parallel::loop_for(0, data.collection->size(), [&](size_t i) {
-                    auto type = data.collection->get<ParticleInfo>(i).type;
-                    if (type == ParticleTypeInactive)
-                        return; // we do not want to process inactive particles
-                    if (type == ParticleTypeBoundary)
-                        return; // we do not want to process boundary particles
+                parallel::loop_for(0, fluid.size(), [&](size_t f) {
+                    size_t i = fluid[f];
 
                     auto& iisph_data = data.collection->get<IISPHParticleData3D>(i);
                     auto& movement_data = data.collection->get<MovementData3D>(i);
@@ -358,37 +402,22 @@ namespace LibFluid {
 
                     glm::vec3 pressure_acceleration = glm::vec3(0.0f);
 
-                    auto neighbors = neighborhood_search.get_neighbors(i);
-                    for (auto neighbor : neighbors) {
-                        auto type = data.collection->get<ParticleInfo>(neighbor).type;
-                        if (type == ParticleTypeInactive) {
-                            continue; // don't calculate unnecessary values for inactive particles.
-                        }
-
-                        auto& neighbor_particle_data = data.collection->get<ParticleData>(neighbor);
-                        auto& neighbor_iisph_data = data.collection->get<IISPHParticleData3D>(neighbor);
-                        auto& neighbor_movement_data = data.collection->get<MovementData3D>(neighbor);
-
-                        if (type == ParticleTypeNormal) {
-                            pressure_acceleration -=
-                                    neighbor_particle_data.mass *
-                                    (particle_data.pressure / Math::pow2(parameters.rest_density) +
-                                            neighbor_particle_data.pressure / Math::pow2(parameters.rest_density)) *
-                                    kernel.GetKernelDerivativeReversedValue(neighbor_movement_data.position,
-                                            movement_data.position);
-                        } else if (type == ParticleTypeBoundary) {
+                    for (size_t n = neighbor_gradient_offsets[i]; n < neighbor_gradient_offsets[i + 1]; n++) {
+                        const auto& cached = neighbor_gradients[n];
+                        if (cached.neighbor_type == ParticleTypeNormal) {
+                            auto& neighbor_particle_data = data.collection->get<ParticleData>(cached.neighbor);
+                            pressure_acceleration -= (particle_data.pressure / Math::pow2(parameters.rest_density) +
+                                                             neighbor_particle_data.pressure / Math::pow2(parameters.rest_density)) *
+                                    cached.mass_weighted_gradient;
+                        } else if (cached.neighbor_type == ParticleTypeBoundary) {
                             // TODO: gamma was used here even for multi layer boundaries
                             if (settings.single_layer_boundary) {
-                                pressure_acceleration -= settings.gamma * neighbor_particle_data.mass * 2.0f *
-                                        particle_data.pressure / Math::pow2(parameters.rest_density) *
-                                        kernel.GetKernelDerivativeReversedValue(
-                                                neighbor_movement_data.position, movement_data.position);
+                                pressure_acceleration -= settings.gamma * 2.0f * particle_data.pressure /
+                                        Math::pow2(parameters.rest_density) * cached.mass_weighted_gradient;
                             } else {
                                 // TODO: check if we can ignore gamma in scenarios with multi layer boundaries
-                                pressure_acceleration -= neighbor_particle_data.mass * 2.0f *
-                                        particle_data.pressure / Math::pow2(parameters.rest_density) *
-                                        kernel.GetKernelDerivativeReversedValue(
-                                                neighbor_movement_data.position, movement_data.position);
+                                pressure_acceleration -= 2.0f * particle_data.pressure / Math::pow2(parameters.rest_density) *
+                                        cached.mass_weighted_gradient;
                             }
                         }
                     }
@@ -399,12 +428,8 @@ namespace LibFluid {
 
                 // compute divergence of the velocity change, update pressure, compute predicted density error per
                 // particle
-                parallel::loop_for(0, data.collection->size(), [&](size_t i) {
-                    auto type = data.collection->get<ParticleInfo>(i).type;
-                    if (type == ParticleTypeInactive)
-                        return; // we do not want to process inactive particles
-                    if (type == ParticleTypeBoundary)
-                        return; // we do not want to process boundary particles
+                parallel::loop_for(0, fluid.size(), [&](size_t f) {
+                    size_t i = fluid[f];
 
                     auto& iisph_data = data.collection->get<IISPHParticleData3D>(i);
                     auto& movement_data = data.collection->get<MovementData3D>(i);
@@ -412,27 +437,14 @@ namespace LibFluid {
 
                     float ap = 0.0f;
 
-                    auto neighbors = neighborhood_search.get_neighbors(i);
-                    for (auto neighbor : neighbors) {
-                        auto type = data.collection->get<ParticleInfo>(neighbor).type;
-                        if (type == ParticleTypeInactive) {
-                            continue; // don't calculate unnecessary values for inactive particles.
-                        }
-
-                        auto& neighbor_particle_data = data.collection->get<ParticleData>(neighbor);
-                        auto& neighbor_iisph_data = data.collection->get<IISPHParticleData3D>(neighbor);
-                        auto& neighbor_movement_data = data.collection->get<MovementData3D>(neighbor);
-
-                        if (type == ParticleTypeNormal) {
-                            ap += neighbor_particle_data.mass *
-                                    glm::dot(movement_data.acceleration - neighbor_movement_data.acceleration,
-                                            kernel.GetKernelDerivativeReversedValue(neighbor_movement_data.position,
-                                                    movement_data.position));
-                        } else if (type == ParticleTypeBoundary) {
-                            ap += neighbor_particle_data.mass *
-                                    glm::dot(movement_data.acceleration,
-                                            kernel.GetKernelDerivativeReversedValue(neighbor_movement_data.position,
-                                                    movement_data.position));
+                    for (size_t n = neighbor_gradient_offsets[i]; n < neighbor_gradient_offsets[i + 1]; n++) {
+                        const auto& cached = neighbor_gradients[n];
+                        if (cached.neighbor_type == ParticleTypeNormal) {
+                            auto& neighbor_movement_data = data.collection->get<MovementData3D>(cached.neighbor);
+                            ap += glm::dot(movement_data.acceleration - neighbor_movement_data.acceleration,
+                                    cached.mass_weighted_gradient);
+                        } else if (cached.neighbor_type == ParticleTypeBoundary) {
+                            ap += glm::dot(movement_data.acceleration, cached.mass_weighted_gradient);
                         }
                     }
 
@@ -465,44 +477,57 @@ namespace LibFluid {
 
                 // check if we need further iterations
                 {
-                    float max_predicted_density_error = 0.0f;
-                    float average_predicted_density_error = 0.0f;
-                    size_t average_counter = 0;
-
-                    // reset the max final velocity and acceleration since values from previous iterations are not required anymore
-                    max_final_velocity_squared = 0.0f;
-                    max_final_acceleration_squared = 0.0f;
-
-                    for (size_t i = 0; i < data.collection->size(); i++) {
-                        // skip particles that are not normal fluid particles
-                        auto type = data.collection->get<ParticleInfo>(i).type;
-                        if (type != ParticleTypeNormal) {
-                            continue;
-                        }
+                    struct IterationStatistics {
+                        float max_velocity_squared = 0.0f;
+                        float max_acceleration_squared = 0.0f;
+                        float predicted_density_error_sum = 0.0f;
+                        size_t average_counter = 0;
+                    };
 
-                        auto& iisph_data = data.collection->get<IISPHParticleData3D>(i);
+                    IterationStatistics statistics = parallel::reduce(
+                            0, fluid.size(), IterationStatistics(),
+                            [&](size_t f) {
+                                IterationStatistics result;
+                                size_t i = fluid[f];
 
-                        {
-                            // calculate the current maximal velocity and acceleration of all fluid particles
-                            const auto& movement_data = data.collection->get<MovementData3D>(i);
+                                const auto& iisph_data = data.collection->get<IISPHParticleData3D>(i);
 
-                            max_final_acceleration_squared = std::fmax(max_final_acceleration_squared, glm::dot(movement_data.acceleration, movement_data.acceleration));
+                                {
+                                    // calculate the current velocity and acceleration of the fluid particle
+                                    const auto& movement_data = data.collection->get<MovementData3D>(i);
 
-                            glm::vec3 particle_velocity = iisph_data.predicted_velocity + current_timestep * movement_data.acceleration;
-                            max_final_velocity_squared = std::fmax(max_final_velocity_squared, glm::dot(particle_velocity, particle_velocity));
-                        }
+                                    result.max_acceleration_squared = glm::dot(movement_data.acceleration, movement_data.acceleration);
 
-                        {
-                            // calculate the max predicted density error for the iteration termination criteria
-                            if (std::abs(iisph_data.diagonal_element) > std::numeric_limits<float>::epsilon()) {
-                                // this particle contributes to the density error
-                                max_predicted_density_error =
-                                        std::fmax(max_predicted_density_error, iisph_data.predicted_density_error);
-                                average_predicted_density_error += iisph_data.predicted_density_error;
-                                average_counter++;
-                            }
-                        }
-                    }
+                                    glm::vec3 particle_velocity = iisph_data.predicted_velocity + current_timestep * movement_data.acceleration;
+                                    result.max_velocity_squared = glm::dot(particle_velocity, particle_velocity);
+                                }
+
+                                {
+                                    // calculate the predicted density error for the iteration termination criteria
+                                    if (std::abs(iisph_data.diagonal_element) > std::numeric_limits<float>::epsilon()) {
+                                        // this particle contributes to the density error
+                                        result.predicted_density_error_sum = iisph_data.predicted_density_error;
+                                        result.average_counter = 1;
+                                    }
+                                }
+
+                                return result;
+                            },
+                            [](const IterationStatistics& a, const IterationStatistics& b) {
+                                IterationStatistics result;
+                                result.max_velocity_squared = std::fmax(a.max_velocity_squared, b.max_velocity_squared);
+                                result.max_acceleration_squared = std::fmax(a.max_acceleration_squared, b.max_acceleration_squared);
+                                result.predicted_density_error_sum = a.predicted_density_error_sum + b.predicted_density_error_sum;
+                                result.average_counter = a.average_counter + b.average_counter;
+                                return result;
+                            });
+
+                    // values from previous iterations are not required anymore
+                    max_final_velocity_squared = statistics.max_velocity_squared;
+                    max_final_acceleration_squared = statistics.max_acceleration_squared;
+
+                    size_t average_counter = statistics.average_counter;
+                    float average_predicted_density_error = statistics.predicted_density_error_sum;
 
                     if (average_counter > 0) {
                         average_predicted_density_error = average_predicted_density_error / (float)average_counter;
@@ -1,11 +1,19 @@
 #pragma once
 
+#include "LibFluidMath.hpp"
 #include "fluidSolver/IFluidSolver.hpp"
+#include "fluidSolver/MovementColumns3D.hpp"
+#include "fluidSolver/ParticleTypeIndices.hpp"
+#include "fluidSolver/kernel/BatchedCubicSplineKernel3D.hpp"
 #include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
 #include "fluidSolver/neighborhoodSearch/QuadraticNeighborhoodSearch3D.hpp"
 #include "fluidSolver/solver/settings/SESPHSettings3D.hpp"
 #include "parallelization/StdParallelForEach.hpp"
 
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 namespace LibFluid {
 
 
@@ -31,13 +39,45 @@ namespace LibFluid {
 
         float ComputePressure(size_t particleIndex);
 
-        float ComputeDensity(size_t particleIndex);
+        template<typename Movement>
+        void ComputeDensitiesAndAccelerations(const Movement& movement);
+
+        template<typename Movement>
+        float ComputeDensity(size_t particleIndex, const Movement& movement);
+
+        template<typename Movement>
+        void ComputeDensitiesVectorized(const Movement& movement);
 
-        glm::vec3 ComputeNonPressureAcceleration(size_t particleIndex);
+        template<typename Movement>
+        glm::vec3 ComputeAcceleration(size_t particleIndex, const Movement& movement);
+
+        template<typename Movement>
+        void ComputeAccelerationsPairwise(const Movement& movement);
+
+        // accelerations that the pairs of neighbors of a contiguous range of particles contributed, the buffer covers
+        // the particles of the range and of the following range
+        struct AccelerationAccumulationChunk
+        {
+            size_t begin = 0;
+            std::vector<glm::vec3> accelerations;
+        };
 
-        glm::vec3 ComputePressureAcceleration(size_t particleIndex);
+        // acceleration of the fluid particle caused by its neighbor, gradient is the kernel gradient with respect to
+        // the particle
+        template<typename Movement>
+        glm::vec3 ComputePairAcceleration(size_t particleIndex, size_t neighbor, const glm::vec3& gradient,
+                const Movement& movement);
 
-        glm::vec3 ComputeViscosityAcceleration(size_t particleIndex);
+        std::vector<AccelerationAccumulationChunk> acceleration_accumulation_chunks;
+
+        // evaluates the cubic spline for whole neighborhoods with the vector instructions of the cpu
+        BatchedCubicSplineKernel3D batched_kernel;
+
+        // contribution of each particle to the density of its neighbors relative to the kernel value
+        std::vector<float> density_weights;
+
+        // the loops that only process fluid particles iterate over the fluid indices
+        ParticleTypeIndices particle_indices;
 
 
       public:
@@ -60,50 +100,27 @@ namespace LibFluid {
 
         current_timestep = timestep.desired_time_step;
 
-        // calculate density and pressure for all particles
-        parallel::loop_for(0, data.collection->size(), [&](size_t i) {
-            auto type = data.collection->get<ParticleInfo>(i).type;
-            if (type == ParticleTypeBoundary) {
-                return; // don't calculate unnecessary values for the boundary particles.
-            }
-            if (type == ParticleTypeInactive) {
-                return; // don't calculate unnecessary values for inactive particles.
-            }
+        particle_indices.update(*data.collection);
 
-            data.collection->get<ParticleData>(i).density = ComputeDensity(i);
-            data.collection->get<ParticleData>(i).pressure = ComputePressure(i);
-        });
-
-        // compute non pressure accelerations and pressure accelerations for all particles
-        parallel::loop_for(0, data.collection->size(), [&](size_t i) {
-            auto type = data.collection->get<ParticleInfo>(i).type;
-            if (type == ParticleTypeBoundary) {
-                return; // don't calculate unnecessary values for the boundary particles.
-            }
-            if (type == ParticleTypeInactive) {
-                return; // don*t calculate unnecessary values for inactive particles.
-            }
-            auto& mv = data.collection->get<MovementData3D>(i);
-
-            glm::vec3 nonPressureAcc = ComputeNonPressureAcceleration(i);
-            glm::vec3 pressureAcc = ComputePressureAcceleration(i);
-            mv.acceleration = pressureAcc + nonPressureAcc;
-        });
+        // positions and velocities are read from the structure of arrays columns if they were added to the collection
+        MovementColumns3D::visit<parallel>(*data.collection,
+                [&](const auto& movement) { ComputeDensitiesAndAccelerations(movement); });
 
         // compute max_final_velocity and max_final_acceleration
         float max_final_velocity;
         float max_final_acceleration;
         {
-            float max_final_velocity_squared = 0.0f;
-            float max_final_acceleration_squared = 0.0f;
-            for (size_t i = 0; i < data.collection->size(); i++) {
-                const auto& mv = data.collection->get<MovementData3D>(i);
-                max_final_acceleration_squared = Math::max(max_final_acceleration_squared, glm::dot(mv.acceleration, mv.acceleration));
-                glm::vec3 velocity = mv.velocity + current_timestep * mv.acceleration;
-                max_final_velocity_squared = Math::max(max_final_velocity_squared, glm::dot(velocity, velocity));
-            }
-            max_final_velocity = Math::sqrt(max_final_velocity_squared);
-            max_final_acceleration = Math::sqrt(max_final_acceleration_squared);
+            // x: squared velocity, y: squared acceleration
+            glm::vec2 max_squared = parallel::reduce(
+                    0, data.collection->size(), glm::vec2(0.0f),
+                    [&](size_t i) {
+                        const auto& mv = data.collection->get<MovementData3D>(i);
+                        glm::vec3 velocity = mv.velocity + current_timestep * mv.acceleration;
+                        return glm::vec2(glm::dot(velocity, velocity), glm::dot(mv.acceleration, mv.acceleration));
+                    },
+                    [](const glm::vec2& a, const glm::vec2& b) { return glm::vec2(Math::max(a.x, b.x), Math::max(a.y, b.y)); });
+            max_final_velocity = Math::sqrt(max_squared.x);
+            max_final_acceleration = Math::sqrt(max_squared.y);
         }
 
         // correct the timestep if required
@@ -146,6 +163,8 @@ namespace LibFluid {
             neighborhood_search.initialize();
             kernel.kernel_support = parameters.particle_size * Math::kernel_support_factor;
             kernel.initialize();
+            batched_kernel.kernel_support = parameters.particle_size * Math::kernel_support_factor;
+            batched_kernel.initialize();
         }
 
         if (settings.has_data_changed()) {
@@ -192,6 +211,34 @@ namespace LibFluid {
         return neighborhood_search.create_interface();
     }
 
+    template<typename Kernel, typename NeighborhoodSearch, typename parallel>
+    template<typename Movement>
+    void SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputeDensitiesAndAccelerations(const Movement& movement) {
+        // calculate density and pressure for all particles
+        if (std::is_same_v<Kernel, CubicSplineKernel3D> && settings.vectorized_density_computation) {
+            ComputeDensitiesVectorized(movement);
+        } else {
+            const auto& fluid = particle_indices.fluid();
+            parallel::loop_for(0, fluid.size(), [&](size_t f) {
+                size_t i = fluid[f];
+                data.collection->get<ParticleData>(i).density = ComputeDensity(i, movement);
+                data.collection->get<ParticleData>(i).pressure = ComputePressure(i);
+            });
+        }
+
+        if (settings.pairwise_force_computation) {
+            ComputeAccelerationsPairwise(movement);
+            return;
+        }
+
+        // compute the accelerations of the fluid particles, each neighborhood is traversed once for pressure and viscosity
+        const auto& fluid = particle_indices.fluid();
+        parallel::loop_for(0, fluid.size(), [&](size_t f) {
+            size_t i = fluid[f];
+            data.collection->get<MovementData3D>(i).acceleration = ComputeAcceleration(i, movement);
+        });
+    }
+
     template<typename Kernel, typename NeighborhoodSearch, typename parallel>
     float SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputePressure(size_t particleIndex) {
         float density = data.collection->get<ParticleData>(particleIndex).density;
@@ -200,8 +247,9 @@ namespace LibFluid {
     }
 
     template<typename Kernel, typename NeighborhoodSearch, typename parallel>
-    float SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputeDensity(size_t particleIndex) {
-        const glm::vec3& position = data.collection->get<MovementData3D>(particleIndex).position;
+    template<typename Movement>
+    float SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputeDensity(size_t particleIndex, const Movement& movement) {
+        glm::vec3 position = movement.position(particleIndex);
 
         float density = 0.0f;
         auto neighbors = neighborhood_search.get_neighbors(particleIndex);
@@ -211,7 +259,7 @@ namespace LibFluid {
                 continue; // don't calculate unnecessary values for inactive particles.
             }
 
-            const glm::vec3& neighborPosition = data.collection->get<MovementData3D>(neighbor).position;
+            glm::vec3 neighborPosition = movement.position(neighbor);
             float neighborMass = data.collection->get<ParticleData>(neighbor).mass;
             if (type == ParticleTypeBoundary) {
                 if (settings.single_layer_boundary) {
@@ -228,30 +276,56 @@ namespace LibFluid {
     }
 
     template<typename Kernel, typename NeighborhoodSearch, typename parallel>
-    glm::vec3 SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputeNonPressureAcceleration(
-            size_t particleIndex) {
-        glm::vec3 nonPressureAcceleration = glm::vec3(0.0f);
+    template<typename Movement>
+    void SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputeDensitiesVectorized(const Movement& movement) {
+        // the column of an empty collection may not exist
+        if (data.collection->size() == 0) {
+            return;
+        }
 
-        // Gravity
-        nonPressureAcceleration += glm::vec3(0.0f, -parameters.gravity, 0.0f);
+        // the type and mass of a neighbor are folded into a single weight, hence the neighbors can be gathered by
+        // their index without any branching on their type
+        density_weights.resize(data.collection->size());
+        parallel::loop_for(0, data.collection->size(), [&](size_t i) {
+            auto type = data.collection->get<ParticleInfo>(i).type;
+            float mass = data.collection->get<ParticleData>(i).mass;
+            if (type == ParticleTypeNormal) {
+                density_weights[i] = mass;
+            } else if (type == ParticleTypeBoundary) {
+                // scale the contribution of the boundary particles to support single layer boundaries
+                density_weights[i] = settings.single_layer_boundary ? settings.single_layer_boundary_gamma_1 * mass : mass;
+            } else {
+                density_weights[i] = 0.0f;
+            }
+        });
 
-        // Viscosity
-        nonPressureAcceleration += ComputeViscosityAcceleration(particleIndex);
+        BatchedCubicSplineKernel3D::Positions positions = movement.batched_positions();
 
-        return nonPressureAcceleration;
+        const auto& fluid = particle_indices.fluid();
+        parallel::loop_for(0, fluid.size(), [&](size_t f) {
+            size_t i = fluid[f];
+            data.collection->get<ParticleData>(i).density = batched_kernel.sum_weighted_values(
+                    movement.position(i), neighborhood_search.get_neighbors(i), positions, density_weights.data());
+            data.collection->get<ParticleData>(i).pressure = ComputePressure(i);
+        });
     }
 
     template<typename Kernel, typename NeighborhoodSearch, typename parallel>
-    glm::vec3 SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputePressureAcceleration(size_t particleIndex) {
-        const glm::vec3& position = data.collection->get<MovementData3D>(particleIndex).position;
+    template<typename Movement>
+    glm::vec3 SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputeAcceleration(size_t particleIndex, const Movement& movement) {
+        glm::vec3 position = movement.position(particleIndex);
+        glm::vec3 velocity = movement.velocity(particleIndex);
         const ParticleData& pData = data.collection->get<ParticleData>(particleIndex);
-        const float& density = pData.density;
-        const float& pressure = pData.pressure;
-        const float& mass = pData.mass;
 
-        float pressureDivDensitySquared = density == 0.0f ? 0.0f : pressure / Math::pow2(density);
+        float pressureDivDensitySquared = pData.density == 0.0f ? 0.0f : pData.pressure / Math::pow2(pData.density);
+
+        float viscosity_epsilon = 0.01f * parameters.particle_size * parameters.particle_size;
+        float boundary_gamma = settings.single_layer_boundary ? settings.single_layer_boundary_gamma_2 : 1.0f;
 
+        // the pressure and viscosity terms share the kernel gradient and the data of each neighbor
         glm::vec3 pressureAcceleration = glm::vec3(0.0f);
+        glm::vec3 viscosityAcceleration = glm::vec3(0.0f);
+
         auto neighbors = neighborhood_search.get_neighbors(particleIndex);
         for (uint32_t neighbor : neighbors) {
             auto type = data.collection->get<ParticleInfo>(neighbor).type;
@@ -259,69 +333,160 @@ namespace LibFluid {
                 continue; // don*t calculate unnecessary values for inactive particles.
             }
 
-            const glm::vec3& neighborPosition = data.collection->get<MovementData3D>(neighbor).position;
-            if (type == ParticleTypeBoundary) {
-                // simple mirroring is used to calculate the pressure acceleration with a boundary particle
-                if (settings.single_layer_boundary) {
-                    // scale the boundary contribution accordingly to support single layer boundaries
-                    pressureAcceleration += -mass * (pressureDivDensitySquared + pressureDivDensitySquared) *
-                            kernel.GetKernelDerivativeReversedValue(neighborPosition, position) * settings.single_layer_boundary_gamma_2;
+            glm::vec3 neighborPosition = movement.position(neighbor);
+            glm::vec3 neighborVelocity = movement.velocity(neighbor);
+            const ParticleData& neighbor_pData = data.collection->get<ParticleData>(neighbor);
 
-                } else {
-                    pressureAcceleration += -mass * (pressureDivDensitySquared + pressureDivDensitySquared) *
-                            kernel.GetKernelDerivativeReversedValue(neighborPosition, position);
-                }
-            } else {
-                // normal particles
-                const ParticleData& neighbor_pData = data.collection->get<ParticleData>(neighbor);
-                const float& neighborMass = neighbor_pData.mass;
-                const float& neighborDensity = neighbor_pData.density;
-                const float& neighborPressure = neighbor_pData.pressure;
+            glm::vec3 gradient = kernel.GetKernelDerivativeReversedValue(neighborPosition, position);
 
+            if (type == ParticleTypeBoundary) {
+                // simple mirroring is used to calculate the pressure acceleration with a boundary particle, the
+                // contribution is scaled accordingly to support single layer boundaries
+                pressureAcceleration += -pData.mass * (pressureDivDensitySquared + pressureDivDensitySquared) * gradient * boundary_gamma;
+            } else {
                 float neighborPressureDivDensitySquared =
-                        neighborDensity == 0.0f ? 0.0f : neighborPressure / Math::pow2(neighborDensity);
+                        neighbor_pData.density == 0.0f ? 0.0f : neighbor_pData.pressure / Math::pow2(neighbor_pData.density);
 
-                pressureAcceleration += -neighborMass *
-                        (pressureDivDensitySquared + neighborPressureDivDensitySquared) *
-                        kernel.GetKernelDerivativeReversedValue(neighborPosition, position);
+                pressureAcceleration += -neighbor_pData.mass * (pressureDivDensitySquared + neighborPressureDivDensitySquared) * gradient;
             }
+
+            if (neighbor_pData.density == 0.0f)
+                continue;
+
+            glm::vec3 vij = velocity - neighborVelocity;
+            glm::vec3 xij = position - neighborPosition;
+
+            viscosityAcceleration += (neighbor_pData.mass / neighbor_pData.density) *
+                    (glm::dot(vij, xij) / (glm::dot(xij, xij) + viscosity_epsilon)) * gradient;
         }
-        return pressureAcceleration;
+
+        return glm::vec3(0.0f, -parameters.gravity, 0.0f) + 2.0f * settings.Viscosity * viscosityAcceleration + pressureAcceleration;
     }
 
     template<typename Kernel, typename NeighborhoodSearch, typename parallel>
-    glm::vec3 SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputeViscosityAcceleration(size_t particleIndex) {
-        const glm::vec3& position = data.collection->get<MovementData3D>(particleIndex).position;
-        const glm::vec3& velocity = data.collection->get<MovementData3D>(particleIndex).velocity;
+    template<typename Movement>
+    void SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputeAccelerationsPairwise(const Movement& movement) {
+        // The pressure and viscosity forces of a pair are antisymmetric. Hence each pair (i, j) with j > i is visited
+        // once, the kernel gradient is evaluated once and the contributions are scattered to both particles. Each chunk
+        // of particles scatters into its own buffer to avoid write conflicts, the buffers are summed up afterwards.
+        // The buffer of a chunk only covers the chunk and the following one, which bounds the memory of all buffers to
+        // twice the amount of particles. If the neighbor is outside of the buffer, both particles compute their own
+        // contribution of the pair instead.
+        static const size_t chunk_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+        size_t size = data.collection->size();
+        if (size == 0)
+            return;
+
+        size_t chunk_size = (size + chunk_count - 1) / chunk_count;
+        acceleration_accumulation_chunks.resize(chunk_count);
+
+        // particles from the first particle of the chunk of particle_index up to this index are covered by its buffer
+        auto buffer_end = [&](size_t particle_index) {
+            return std::min((particle_index / chunk_size) * chunk_size + 2 * chunk_size, size);
+        };
+
+        auto accumulate_chunk = [&](size_t c) {
+            auto& chunk = acceleration_accumulation_chunks[c];
+            chunk.begin = std::min(c * chunk_size, size);
+            size_t end = std::min(chunk.begin + chunk_size, size);
+            size_t chunk_buffer_end = chunk.begin == size ? size : buffer_end(chunk.begin);
+            chunk.accelerations.assign(chunk_buffer_end - chunk.begin, glm::vec3(0.0f));
+
+            for (size_t i = chunk.begin; i < end; i++) {
+                auto type = data.collection->get<ParticleInfo>(i).type;
+                if (type == ParticleTypeInactive) {
+                    continue;
+                }
 
+                glm::vec3 position = movement.position(i);
+
+                auto neighbors = neighborhood_search.get_neighbors(i);
+                for (uint32_t neighbor : neighbors) {
+                    if (neighbor == i) {
+                        continue;
+                    }
+
+                    // the pair is handled by the neighbor if this particle is covered by the buffer of the neighbor
+                    bool scatter_to_neighbor = neighbor > i && neighbor < chunk_buffer_end;
+                    if (neighbor < i && i < buffer_end(neighbor)) {
+                        continue;
+                    }
+
+                    auto neighborType = data.collection->get<ParticleInfo>(neighbor).type;
+                    if (neighborType == ParticleTypeInactive) {
+                        continue;
+                    }
+                    if (type != ParticleTypeNormal && (neighborType != ParticleTypeNormal || !scatter_to_neighbor)) {
+                        continue; // boundary particles do not receive accelerations
+                    }
+
+                    // gradient with respect to particle i, the gradient with respect to the neighbor is its negation
+                    glm::vec3 neighborPosition = movement.position(neighbor);
+                    glm::vec3 gradient = kernel.GetKernelDerivativeReversedValue(neighborPosition, position);
+
+                    if (type == ParticleTypeNormal) {
+                        chunk.accelerations[i - chunk.begin] += ComputePairAcceleration(i, neighbor, gradient, movement);
+                    }
+                    if (scatter_to_neighbor && neighborType == ParticleTypeNormal) {
+                        chunk.accelerations[neighbor - chunk.begin] += ComputePairAcceleration(neighbor, i, -gradient, movement);
+                    }
+                }
+            }
+        };
 
-        glm::vec3 tmp = glm::vec3(0.0f);
-        auto neighbors = neighborhood_search.get_neighbors(particleIndex);
-        for (uint32_t neighbor : neighbors) {
-            auto type = data.collection->get<ParticleInfo>(neighbor).type;
-            if (type == ParticleTypeInactive) {
-                continue; // don*t calculate unnecessary values for inactive particles.
+        // each chunk is a task of its own, the default grain size would run all chunks on the calling thread
+        parallel::loop_for_range(0, chunk_count, 1, [&](size_t first_chunk, size_t last_chunk) {
+            for (size_t c = first_chunk; c < last_chunk; c++) {
+                accumulate_chunk(c);
             }
+        });
 
-            const glm::vec3& neighborPosition = data.collection->get<MovementData3D>(neighbor).position;
-            const glm::vec3& neighborVelocity = data.collection->get<MovementData3D>(neighbor).velocity;
-            float neighborMass = data.collection->get<ParticleData>(neighbor).mass;
-            float neighborDensity = data.collection->get<ParticleData>(neighbor).density;
+        // sum up the contributions of the chunk of each particle and of the previous chunk
+        const auto& fluid = particle_indices.fluid();
+        parallel::loop_for(0, fluid.size(), [&](size_t f) {
+            size_t i = fluid[f];
+            size_t c = i / chunk_size;
+            glm::vec3 acceleration = glm::vec3(0.0f, -parameters.gravity, 0.0f);
+            acceleration += acceleration_accumulation_chunks[c].accelerations[i - acceleration_accumulation_chunks[c].begin];
+            if (c > 0) {
+                acceleration += acceleration_accumulation_chunks[c - 1].accelerations[i - acceleration_accumulation_chunks[c - 1].begin];
+            }
+            data.collection->get<MovementData3D>(i).acceleration = acceleration;
+        });
+    }
 
-            if (neighborDensity == 0.0f)
-                continue;
+    template<typename Kernel, typename NeighborhoodSearch, typename parallel>
+    template<typename Movement>
+    glm::vec3 SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::ComputePairAcceleration(size_t particleIndex,
+            size_t neighbor, const glm::vec3& gradient, const Movement& movement) {
+        const ParticleData& pData = data.collection->get<ParticleData>(particleIndex);
+        const ParticleData& neighbor_pData = data.collection->get<ParticleData>(neighbor);
+        float pressureDivDensitySquared = pData.density == 0.0f ? 0.0f : pData.pressure / Math::pow2(pData.density);
+
+        glm::vec3 acceleration;
+        if (data.collection->get<ParticleInfo>(neighbor).type == ParticleTypeBoundary) {
+            // simple mirroring is used to calculate the pressure acceleration with a boundary particle, the
+            // contribution is scaled accordingly to support single layer boundaries
+            float boundary_gamma = settings.single_layer_boundary ? settings.single_layer_boundary_gamma_2 : 1.0f;
+            acceleration = -pData.mass * (pressureDivDensitySquared + pressureDivDensitySquared) * gradient * boundary_gamma;
+        } else {
+            float neighborPressureDivDensitySquared =
+                    neighbor_pData.density == 0.0f ? 0.0f : neighbor_pData.pressure / Math::pow2(neighbor_pData.density);
+            acceleration = -neighbor_pData.mass * (pressureDivDensitySquared + neighborPressureDivDensitySquared) * gradient;
+        }
 
-            glm::vec3 vij = velocity - neighborVelocity;
-            glm::vec3 xij = position - neighborPosition;
+        if (neighbor_pData.density != 0.0f) {
+            float viscosity_epsilon = 0.01f * parameters.particle_size * parameters.particle_size;
 
-            tmp += (neighborMass / neighborDensity) *
-                    (glm::dot(vij, xij) /
-                            (glm::dot(xij, xij) + 0.01f * parameters.particle_size * parameters.particle_size)) *
-                    kernel.GetKernelDerivativeReversedValue(neighborPosition, position);
+            glm::vec3 vij = movement.velocity(particleIndex) - movement.velocity(neighbor);
+            glm::vec3 xij = movement.position(particleIndex) - movement.position(neighbor);
+            acceleration += 2.0f * settings.Viscosity * (neighbor_pData.mass / neighbor_pData.density) *
+                    (glm::dot(vij, xij) / (glm::dot(xij, xij) + viscosity_epsilon)) * gradient;
         }
-
-        return 2.0f * settings.Viscosity * tmp;
+        return acceleration;
     }
+
     template<typename Kernel, typename NeighborhoodSearch, typename parallel>
     void SESPHFluidSolver3D<Kernel, NeighborhoodSearch, parallel>::execute_neighborhood_search() {
         initialize();
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "helpers/DataChangeStruct.hpp"
+
+namespace LibFluid {
+    struct DFSPHSettings3D : public DataChangeStruct {
+        // average density error relative to the rest density
+        float max_density_error_allowed = 0.001f;
+
+        size_t min_number_of_iterations = 2;
+        size_t max_number_of_iterations = 100;
+
+        // correct the divergence of the velocity field at the beginning of each step
+        bool divergence_solve = true;
+
+        // average density change during one timestep relative to the rest density
+        float max_divergence_error_allowed = 0.01f;
+
+        size_t min_number_of_divergence_iterations = 1;
+        size_t max_number_of_divergence_iterations = 100;
+
+        float viscosity = 5.0f;
+    };
+} // namespace LibFluid
@@ -18,5 +18,12 @@ namespace LibFluid {
 
         bool single_layer_boundary = false;
         float single_layer_boundary_gamma_1 = 1.1f;
+
+        // start the pressure solve with the pressure of the previous step multiplied by the factor instead of zero
+        bool warm_start_pressure = false;
+        float warm_start_pressure_factor = 0.5f;
+
+        // evaluate the densities with the vector instructions of the cpu, only used with the CubicSplineKernel3D
+        bool vectorized_density_computation = true;
     };
 } // namespace LibFluid
\ No newline at end of file
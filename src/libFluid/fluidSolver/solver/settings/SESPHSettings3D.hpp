@@ -10,5 +10,11 @@ namespace LibFluid {
         bool single_layer_boundary = false;
         float single_layer_boundary_gamma_1 = 1.1f;
         float single_layer_boundary_gamma_2 = 1.1f;
+
+        // visit each pair of neighbors only once during the force computation
+        bool pairwise_force_computation = false;
+
+        // evaluate the densities with the vector instructions of the cpu, only used with the CubicSplineKernel3D
+        bool vectorized_density_computation = true;
     };
 } // namespace LibFluid
\ No newline at end of file
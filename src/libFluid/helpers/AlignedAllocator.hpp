@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace LibFluid {
+
+    /**
+     * @brief Allocator that places the first element of each allocation on an Alignment byte boundary.
+     *
+     * Used for the component arrays of the ParticleCollection, such that arrays of scalars can be processed with
+     * aligned vector loads.
+     */
+    template<typename T, size_t Alignment = 64>
+    class AlignedAllocator {
+        static_assert(Alignment >= alignof(T), "The alignment has to satisfy the alignment of the type.");
+
+      public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {
+        }
+
+        T* allocate(size_t n) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* p, size_t) noexcept {
+            ::operator delete(p, std::align_val_t(Alignment));
+        }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+            return true;
+        }
+
+        template<typename U>
+        bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept {
+            return false;
+        }
+    };
+
+} // namespace LibFluid
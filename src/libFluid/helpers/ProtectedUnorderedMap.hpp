@@ -29,9 +29,10 @@ namespace LibFluid::Helper
             }
             else
             {
-                if (data.find(_key) != data.end())
+                auto it = data.find(_key);
+                if (it != data.end())
                 {
-                    return data[_key];
+                    return it->second;
                 }
                 else
                 {
@@ -41,6 +42,22 @@ namespace LibFluid::Helper
             }
         }
 
+        /**
+         * @brief Returns the value stored for the key or nullptr if there is none.
+         *
+         * In contrast to operator[] the map is never modified, hence lookup can be called concurrently from
+         * multiple threads as long as no other thread modifies the map at the same time.
+         */
+        const _Value* lookup(const _Key& _key) const
+        {
+            auto it = data.find(_key);
+            if (it == data.end())
+            {
+                return nullptr;
+            }
+            return &it->second;
+        }
+
         void clear()
         {
             data.clear();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
 
 namespace LibFluid {
@@ -14,9 +15,50 @@ namespace LibFluid {
 		 * @param to
 		 * @param fn
 		 */
-        static void loop_for(size_t from, size_t to, const std::function<void(size_t i)>& fn);
+        template<typename Fn>
+        static void loop_for(size_t from, size_t to, Fn&& fn) {
+            for (size_t i = from; i < to; i++) {
+                fn(i);
+            }
+        }
 
-        static void loop_for(size_t from, size_t to, size_t step, const std::function<void(size_t i)>& fn);
+        template<typename Fn>
+        static void loop_for(size_t from, size_t to, size_t step, Fn&& fn) {
+            for (size_t i = from; i < to; i += step) {
+                fn(i);
+            }
+        }
+
+        /**
+         * @brief Executes fn(from, to) once, since the whole range is handled by the calling thread
+         */
+        template<typename Fn>
+        static void loop_for_range(size_t from, size_t to, Fn&& fn) {
+            if (to <= from)
+                return;
+            fn(from, to);
+        }
+
+        /**
+         * @brief Executes fn(from, to) once, the grain is ignored since there is only the calling thread
+         */
+        template<typename Fn>
+        static void loop_for_range(size_t from, size_t to, size_t, Fn&& fn) {
+            loop_for_range(from, to, fn);
+        }
+
+        /**
+         * @brief Reduces the values map(i) for all indices from (inclusive) to to (exclusive) into a single value,
+         * starting with identity and combining the values in index order.
+         */
+        template<typename T, typename Map, typename Combine>
+        static T reduce(size_t from, size_t to, const T& identity, Map&& map, Combine&& combine) {
+            T result = identity;
+            for (size_t i = from; i < to; i++) {
+                result = combine(result, map(i));
+            }
+            return result;
+        }
 
         static float loop_for_max(size_t from, size_t to, const std::function<float(size_t i)>& fn);
     };
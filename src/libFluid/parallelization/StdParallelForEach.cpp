@@ -2,13 +2,13 @@
 
 #include <algorithm>
 #include <execution>
+#include <limits>
+#include <thread>
 
 #ifdef __clang__
     #include <tbb/tbb.h>
 #endif
 
-#include "parallelization/AtomicFloat.hpp"
-
 class SizeTIterator {
   private:
     size_t index;
@@ -61,68 +61,36 @@ class SizeTIterator {
 };
 
 
-void LibFluid::StdParallelForEach::loop_for(size_t from, size_t to, const std::function<void(size_t i)>& fn) {
-    size_t chunked_to = from + (to - from) / chunk_size;
-    if ((to - from) % chunk_size != 0)
-        chunked_to++;
+size_t LibFluid::StdParallelForEach::grain_size(size_t count) {
+    static const size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
 
-#ifndef __clang__
-    std::for_each(std::execution::par, SizeTIterator(from), SizeTIterator(chunked_to), [&fn, to](size_t i) {
-        size_t base = i * chunk_size;
-        for (uint8_t j = 0; j < chunk_size && base + j < to; j++) {
-            fn(base + j);
-        }
-    });
-#else
-    tbb::parallel_for(size_t(from), chunked_to, [&fn, to](size_t i) {
-        size_t base = i * chunk_size;
-        for (uint8_t j = 0; j < chunk_size && base + j < to; j++) {
-            fn(base + j);
-        }
-    });
-#endif
+    size_t grain = count / (thread_count * ranges_per_thread);
+    return std::max(grain, minimum_grain_size);
 }
 
-void LibFluid::StdParallelForEach::loop_for(size_t from, size_t to, size_t step,
-        const std::function<void(size_t i)>& fn) {
-    size_t steps = ((to - 1) - from) / step + 1;
-#ifndef __clang__
-    std::for_each(std::execution::par, SizeTIterator(0), SizeTIterator(steps),
-            [&fn, from, step](size_t i) { fn(from + i * step); });
-#else
-    tbb::parallel_for(size_t(0), steps, [&fn, from, step](size_t i) { fn(from + i * step); });
-#endif
-}
-float LibFluid::StdParallelForEach::loop_for_max(size_t from, size_t to, const std::function<float(size_t)>& fn) {
-    size_t chunked_to = from + (to - from) / chunk_size;
-    if ((to - from) % chunk_size != 0)
-        chunked_to++;
+void LibFluid::StdParallelForEach::execute_ranges(size_t from, size_t to, size_t grain, void* context, range_function_t fn) {
+    size_t range_count = (to - from + grain - 1) / grain;
+    if (range_count <= 1) {
+        // not worth the overhead of dispatching the work to other threads
+        fn(context, from, to);
+        return;
+    }
 
-    Parallelization::AtomicFloat atomic_result(std::numeric_limits<float>::lowest());
+    auto execute_range = [from, to, grain, context, fn](size_t range_index) {
+        size_t begin = from + range_index * grain;
+        size_t end = std::min(begin + grain, to);
+        fn(context, begin, end);
+    };
 
 #ifndef __clang__
-    std::for_each(std::execution::par, SizeTIterator(from), SizeTIterator(chunked_to), [&fn, to, &atomic_result](size_t i) {
-        float result = std::numeric_limits<float>::lowest();
-
-        size_t base = i * chunk_size;
-        for (uint8_t j = 0; j < chunk_size && base + j < to; j++) {
-            result = std::max(result, fn(base + j));
-        }
-
-        atomic_result.max(result);
-    });
+    std::for_each(std::execution::par, SizeTIterator(0), SizeTIterator(range_count), execute_range);
 #else
-    tbb::parallel_for(size_t(from), chunked_to, [&fn, to, &atomic_result](size_t i) {
-        float result = std::numeric_limits<float>::lowest();
-
-        size_t base = i * chunk_size;
-        for (uint8_t j = 0; j < chunk_size && base + j < to; j++) {
-            result = std::max(result, fn(base + j));
-        }
-
-        atomic_result.max(result);
-    });
+    tbb::parallel_for(size_t(0), range_count, execute_range);
 #endif
+}
 
-    return atomic_result.get();
+float LibFluid::StdParallelForEach::loop_for_max(size_t from, size_t to, const std::function<float(size_t)>& fn) {
+    return reduce(
+            from, to, std::numeric_limits<float>::lowest(), [&fn](size_t i) { return fn(i); },
+            [](float a, float b) { return std::max(a, b); });
 }
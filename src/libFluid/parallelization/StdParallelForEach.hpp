@@ -1,18 +1,140 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace LibFluid {
     class StdParallelForEach {
 
       public:
-        static constexpr size_t chunk_size = 16;
+        // lower bound of indices that are handed to a worker at once, smaller ranges do not outweigh the scheduling overhead
+        static constexpr size_t minimum_grain_size = 64;
 
-        static void loop_for(size_t from, size_t to, const std::function<void(size_t i)>& fn);
+        // amount of ranges per hardware thread, more than one range per thread allows for load balancing
+        static constexpr size_t ranges_per_thread = 8;
+
+        /**
+         * @brief Loops from (inclusive) to to (exclusive) and executes for each index i the function fn.
+         *
+         * The indices are split into contiguous ranges that are processed in parallel. Since fn is a template
+         * argument, it can be inlined into the loop over each range.
+         */
+        template<typename Fn>
+        static void loop_for(size_t from, size_t to, Fn&& fn) {
+            loop_for_range(from, to, [&fn](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    fn(i);
+                }
+            });
+        }
+
+        template<typename Fn>
+        static void loop_for(size_t from, size_t to, size_t step, Fn&& fn) {
+            if (to <= from)
+                return;
+
+            size_t steps = ((to - 1) - from) / step + 1;
+            loop_for_range(0, steps, [&fn, from, step](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    fn(from + i * step);
+                }
+            });
+        }
+
+        /**
+         * @brief Splits the indices from (inclusive) to to (exclusive) into contiguous ranges and executes
+         * fn(begin, end) for each of them in parallel.
+         *
+         * The size of the ranges is determined by grain_size.
+         */
+        template<typename Fn>
+        static void loop_for_range(size_t from, size_t to, Fn&& fn) {
+            if (to <= from)
+                return;
+
+            execute_ranges(from, to, grain_size(to - from), fn);
+        }
+
+        /**
+         * @brief Like loop_for_range, but the ranges contain at most grain indices instead of grain_size(to - from).
+         *
+         * Use this if a single index already stands for a lot of work, like a chunk of particles. grain_size never
+         * splits less than minimum_grain_size indices, hence such loops would run on the calling thread only.
+         */
+        template<typename Fn>
+        static void loop_for_range(size_t from, size_t to, size_t grain, Fn&& fn) {
+            if (to <= from)
+                return;
+
+            execute_ranges(from, to, std::max(grain, size_t(1)), fn);
+        }
+
+        /**
+         * @brief Reduces the values map(i) for all indices from (inclusive) to to (exclusive) into a single value.
+         *
+         * Each range is reduced into its own partial result without any synchronization, the partial results are
+         * combined afterwards in order of their ranges. Hence combine has to be associative and identity has to be
+         * its neutral element.
+         *
+         * @param identity Neutral element of combine, this is returned for an empty index range
+         * @param map Function T(size_t i) that yields the value of index i
+         * @param combine Function T(const T&, const T&) that combines two values
+         */
+        template<typename T, typename Map, typename Combine>
+        static T reduce(size_t from, size_t to, const T& identity, Map&& map, Combine&& combine) {
+            if (to <= from)
+                return identity;
+
+            // wrapped, such that partial results of different ranges never share storage (like std::vector<bool> does)
+            struct PartialResult {
+                T value;
+            };
+
+            size_t grain = grain_size(to - from);
+            std::vector<PartialResult> partial_results((to - from + grain - 1) / grain, PartialResult{identity});
+
+            auto reduce_range = [&](size_t begin, size_t end) {
+                T result = identity;
+                for (size_t i = begin; i < end; i++) {
+                    result = combine(result, map(i));
+                }
+                partial_results[(begin - from) / grain].value = result;
+            };
+            execute_ranges(from, to, grain, reduce_range);
+
+            T result = identity;
+            for (const auto& partial_result : partial_results) {
+                result = combine(result, partial_result.value);
+            }
+            return result;
+        }
 
         static float loop_for_max(size_t from, size_t to, const std::function<float(size_t i)>& fn);
 
-        static void loop_for(size_t from, size_t to, size_t step, const std::function<void(size_t i)>& fn);
+        /**
+         * @brief Returns the amount of indices per range for a loop over count indices, which depends on count and
+         * the amount of available hardware threads.
+         */
+        static size_t grain_size(size_t count);
+
+      private:
+        using range_function_t = void (*)(void* context, size_t begin, size_t end);
+
+        static void execute_ranges(size_t from, size_t to, size_t grain, void* context, range_function_t fn);
+
+        template<typename Fn>
+        static void execute_ranges(size_t from, size_t to, size_t grain, Fn& fn) {
+            using function_t = std::remove_reference_t<Fn>;
+            void* context = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+
+            execute_ranges(from, to, grain, context, [](void* context, size_t begin, size_t end) {
+                (*static_cast<function_t*>(context))(begin, end);
+            });
+        }
     };
 
 
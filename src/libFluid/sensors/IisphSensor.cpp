@@ -1,8 +1,12 @@
 #include "IisphSensor.hpp"
 
 #include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
+#include "fluidSolver/kernel/Kernel.hpp"
+#include "fluidSolver/kernel/TabulatedCubicSplineKernel3D.hpp"
 #include "fluidSolver/neighborhoodSearch/CompressedNeighbors.hpp"
+#include "fluidSolver/neighborhoodSearch/CsrNeighborhoodSearch3D.hpp"
 #include "fluidSolver/neighborhoodSearch/HashedNeighborhoodSearch3D.hpp"
+#include "fluidSolver/neighborhoodSearch/VerletNeighborhoodSearch.hpp"
 #include "fluidSolver/neighborhoodSearch/QuadraticNeighborhoodSearch3D.hpp"
 #include "fluidSolver/solver/IISPHFluidSolver3D.hpp"
 
@@ -69,6 +73,21 @@ namespace LibFluid::Sensors {
             if (try_fetch_data_from_iisph_solver_helper<IISPHFluidSolver3D<CubicSplineKernel3D, CompressedNeighborhoodSearch>>(solver, last_iteration_count, last_average_predicted_density_error)) {
                 return true;
             }
+            if (try_fetch_data_from_iisph_solver_helper<IISPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(solver, last_iteration_count, last_average_predicted_density_error)) {
+                return true;
+            }
+            if (try_fetch_data_from_iisph_solver_helper<IISPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(solver, last_iteration_count, last_average_predicted_density_error)) {
+                return true;
+            }
+            if (try_fetch_data_from_iisph_solver_helper<IISPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(solver, last_iteration_count, last_average_predicted_density_error)) {
+                return true;
+            }
+            if (try_fetch_data_from_iisph_solver_helper<IISPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(solver, last_iteration_count, last_average_predicted_density_error)) {
+                return true;
+            }
+            if (try_fetch_data_from_iisph_solver_helper<IISPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(solver, last_iteration_count, last_average_predicted_density_error)) {
+                return true;
+            }
         }
 
         {
@@ -1,11 +1,50 @@
 #include "ParticleStatistics.hpp"
 
 #include "Simulator.hpp"
+#include "parallelization/StdParallelForEach.hpp"
 
 #include <algorithm>
 
 namespace LibFluid::Sensors {
 
+    namespace {
+        struct MaxMinSumCount {
+            MaxMinAvgSensorData data; // average holds the sum of all values
+            size_t counter = 0;
+        };
+
+        template<typename Fn>
+        MaxMinAvgSensorData calculate_for_normal_particles(const std::shared_ptr<ParticleCollection>& collection, Fn value_of) {
+            MaxMinSumCount result = StdParallelForEach::reduce(
+                    0, collection->size(), MaxMinSumCount(),
+                    [&](size_t i) {
+                        MaxMinSumCount r;
+                        if (collection->get<ParticleInfo>(i).type == ParticleType::ParticleTypeNormal) {
+                            float value = value_of(i);
+                            r.data.average = value;
+                            r.data.minimum = value;
+                            r.data.maximum = value;
+                            r.counter = 1;
+                        }
+                        return r;
+                    },
+                    [](const MaxMinSumCount& a, const MaxMinSumCount& b) {
+                        MaxMinSumCount r;
+                        r.data.average = a.data.average + b.data.average;
+                        r.data.minimum = std::min(a.data.minimum, b.data.minimum);
+                        r.data.maximum = std::max(a.data.maximum, b.data.maximum);
+                        r.counter = a.counter + b.counter;
+                        return r;
+                    });
+
+            if (result.counter > 0) {
+                result.data.average = result.data.average / result.counter;
+            }
+
+            return result.data;
+        }
+    } // namespace
+
     std::vector<SensorDataFieldDefinition> GlobalDensitySensor::get_definitions() {
         return {
                 {"Maximum Density", SensorDataFieldDefinition::FieldType::Float, "", ""},
@@ -20,27 +59,7 @@ namespace LibFluid::Sensors {
         FLUID_ASSERT(collection->is_type_present<ParticleData>());
         FLUID_ASSERT(collection->is_type_present<ParticleInfo>());
 
-        // calculate data;
-        MaxMinAvgSensorData d;
-
-        size_t counter = 0;
-        for (size_t i = 0; i < collection->size(); i++) {
-            const ParticleData& pData = collection->get<ParticleData>(i);
-            const ParticleInfo& iData = collection->get<ParticleInfo>(i);
-
-            if (iData.type == ParticleType::ParticleTypeNormal) {
-                d.average += pData.density;
-                d.minimum = std::min(d.minimum, pData.density);
-                d.maximum = std::max(d.maximum, pData.density);
-                counter++;
-            }
-        }
-
-        if (counter > 0) {
-            d.average = d.average / counter;
-        }
-
-        return d;
+        return calculate_for_normal_particles(collection, [&collection](size_t i) { return collection->get<ParticleData>(i).density; });
     }
 
     void GlobalDensitySensor::add_data_fields_to_json_array(nlohmann::json& array, const MaxMinAvgSensorData& data) {
@@ -62,27 +81,7 @@ namespace LibFluid::Sensors {
         FLUID_ASSERT(collection->is_type_present<ParticleData>());
         FLUID_ASSERT(collection->is_type_present<ParticleInfo>());
 
-        // calculate data;
-        MaxMinAvgSensorData d;
-
-        size_t counter = 0;
-        for (size_t i = 0; i < collection->size(); i++) {
-            const ParticleData& pData = collection->get<ParticleData>(i);
-            const ParticleInfo& iData = collection->get<ParticleInfo>(i);
-
-            if (iData.type == ParticleType::ParticleTypeNormal) {
-                d.average += pData.pressure;
-                d.minimum = std::min(d.minimum, pData.pressure);
-                d.maximum = std::max(d.maximum, pData.pressure);
-                counter++;
-            }
-        }
-
-        if (counter > 0) {
-            d.average = d.average / counter;
-        }
-
-        return d;
+        return calculate_for_normal_particles(collection, [&collection](size_t i) { return collection->get<ParticleData>(i).pressure; });
     }
     void GlobalPressureSensor::add_data_fields_to_json_array(nlohmann::json& array, const MaxMinAvgSensorData& data) {
         array.push_back(data.maximum);
@@ -104,28 +103,7 @@ namespace LibFluid::Sensors {
         FLUID_ASSERT(collection->is_type_present<MovementData>());
         FLUID_ASSERT(collection->is_type_present<ParticleInfo>());
 
-        // calculate data;
-        MaxMinAvgSensorData d;
-
-        size_t counter = 0;
-        for (size_t i = 0; i < collection->size(); i++) {
-            const MovementData& mData = collection->get<MovementData>(i);
-            const ParticleInfo& iData = collection->get<ParticleInfo>(i);
-
-            if (iData.type == ParticleType::ParticleTypeNormal) {
-                float velocity = glm::length(mData.velocity);
-                d.average += velocity;
-                d.minimum = std::min(d.minimum, velocity);
-                d.maximum = std::max(d.maximum, velocity);
-                counter++;
-            }
-        }
-
-        if (counter > 0) {
-            d.average = d.average / counter;
-        }
-
-        return d;
+        return calculate_for_normal_particles(collection, [&collection](size_t i) { return glm::length(collection->get<MovementData>(i).velocity); });
     }
     void GlobalVelocitySensor::add_data_fields_to_json_array(nlohmann::json& array, const MaxMinAvgSensorData& data) {
         array.push_back(data.maximum);
@@ -148,23 +126,29 @@ namespace LibFluid::Sensors {
         FLUID_ASSERT(collection->is_type_present<ParticleData>());
 
         // calculate data;
-        EnergySensorData d;
-
-        for (size_t i = 0; i < collection->size(); i++) {
-            const MovementData& mData = collection->get<MovementData>(i);
-            const ParticleInfo& iData = collection->get<ParticleInfo>(i);
-            const ParticleData& pData = collection->get<ParticleData>(i);
-
-            if (iData.type == ParticleType::ParticleTypeNormal) {
-                float velocity = glm::length(mData.velocity);
-                float relative_height = mData.position.y - settings.relative_zero_height;
-
-                d.kinetic += 0.5f * pData.mass * velocity * velocity;
-                d.potential += simulator_parameters.gravity * pData.mass * relative_height;
-            }
-        }
-
-        return d;
+        return StdParallelForEach::reduce(
+                0, collection->size(), EnergySensorData(),
+                [&](size_t i) {
+                    EnergySensorData d;
+                    const MovementData& mData = collection->get<MovementData>(i);
+                    const ParticleInfo& iData = collection->get<ParticleInfo>(i);
+                    const ParticleData& pData = collection->get<ParticleData>(i);
+
+                    if (iData.type == ParticleType::ParticleTypeNormal) {
+                        float velocity = glm::length(mData.velocity);
+                        float relative_height = mData.position.y - settings.relative_zero_height;
+
+                        d.kinetic = 0.5f * pData.mass * velocity * velocity;
+                        d.potential = simulator_parameters.gravity * pData.mass * relative_height;
+                    }
+                    return d;
+                },
+                [](const EnergySensorData& a, const EnergySensorData& b) {
+                    EnergySensorData d;
+                    d.kinetic = a.kinetic + b.kinetic;
+                    d.potential = a.potential + b.potential;
+                    return d;
+                });
     }
     void GlobalEnergySensor::add_data_fields_to_json_array(nlohmann::json& array, const EnergySensorData& data) {
         array.push_back(data.kinetic);
@@ -2,7 +2,7 @@
 
 #include "OutputManager.hpp"
 #include "Simulator.hpp"
-#include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
+#include "fluidSolver/kernel/SelectableKernel3D.hpp"
 #include "helpers/Log.hpp"
 #include "parallelization/StdParallelForEach.hpp"
 #include "serialization/helpers/Base64.hpp"
@@ -92,7 +92,8 @@ namespace LibFluid::Sensors {
         float y_step = settings.height / settings.number_of_samples_y;
 
         // initialize kernel for sph equations
-        CubicSplineKernel3D kernel;
+        SelectableKernel3D kernel;
+        kernel.type = settings.kernel_type;
         kernel.kernel_support = simulator_data.neighborhood_interface->get_search_radius();
         kernel.initialize();
 
@@ -110,8 +111,7 @@ namespace LibFluid::Sensors {
 
                     glm::vec3 sample_position =
                             settings.origin + span_x * x_step * (x + sub_x) + span_y * y_step * (y + sub_y);
-                    auto neighbors = simulator_data.neighborhood_interface->get_neighbors(sample_position);
-                    for (auto neighbor : neighbors) {
+                    simulator_data.neighborhood_interface->for_each_neighbor(sample_position, [&](size_t neighbor) {
                         auto& mv = simulator_data.collection->get<MovementData3D>(neighbor);
                         auto& pd = simulator_data.collection->get<ParticleData>(neighbor);
 
@@ -128,7 +128,7 @@ namespace LibFluid::Sensors {
                                 value += glm::vec3(0.0f, 0.0f, pd.pressure) * kernel_value;
                                 break;
                         }
-                    }
+                    });
                 }
             }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "fluidSolver/kernel/Kernel.hpp"
 #include "sensors/SensorBase.hpp"
 #include "visualizer/Image.hpp"
 
@@ -34,6 +35,9 @@ namespace LibFluid::Sensors {
 
             size_t calculate_plane_every_nth_step = 1;
 
+            // kernel used to interpolate the particle quantities at the sample positions
+            KernelType kernel_type = KernelType::CubicSpline;
+
         } settings;
 
 
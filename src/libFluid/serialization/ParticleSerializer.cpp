@@ -38,6 +38,32 @@ namespace esbs {
 
 namespace LibFluid::Serialization {
 
+    namespace {
+        /**
+         * @brief Selects the components whose flag is set and adds the selected components to the collection with a
+         * single call of add_types, so that they are resized and swapped together.
+         */
+        template<typename... Selected>
+        struct ComponentGroup {
+            template<typename Component, typename... Remaining, typename... Flags>
+            static void add(ParticleCollection& collection, bool is_available, Flags... remaining_available) {
+                if constexpr (sizeof...(Remaining) == 0) {
+                    if (is_available) {
+                        collection.add_types<Selected..., Component>();
+                    } else if constexpr (sizeof...(Selected) > 0) {
+                        collection.add_types<Selected...>();
+                    }
+                } else {
+                    if (is_available) {
+                        ComponentGroup<Selected..., Component>::template add<Remaining...>(collection, remaining_available...);
+                    } else {
+                        ComponentGroup<Selected...>::template add<Remaining...>(collection, remaining_available...);
+                    }
+                }
+            }
+        };
+    } // namespace
+
     void ParticleSerializer::serialize(ParticleCollection& collection) {
         esbs::EndianSafeBinaryStream<Lz4CompressedStream> stream(std::move(Lz4CompressedStream::output(filepath)));
 
@@ -184,41 +210,11 @@ namespace LibFluid::Serialization {
     }
 
     void ParticleSerializer::add_components_if_required(const ParticleSerializer::AvailableComponents& available_components, ParticleCollection& collection) {
-        if (available_components.movement_data) {
-            if (!collection.is_type_present<MovementData>()) {
-                collection.add_type<MovementData>();
-            }
-        }
-
-        if (available_components.movement_data_3d) {
-            if (!collection.is_type_present<MovementData3D>()) {
-                collection.add_type<MovementData3D>();
-            }
-        }
-
-        if (available_components.particle_info) {
-            if (!collection.is_type_present<ParticleInfo>()) {
-                collection.add_type<ParticleInfo>();
-            }
-        }
-
-        if (available_components.particle_data) {
-            if (!collection.is_type_present<ParticleData>()) {
-                collection.add_type<ParticleData>();
-            }
-        }
-
-        if (available_components.external_forces) {
-            if (!collection.is_type_present<ExternalForces>()) {
-                collection.add_type<ExternalForces>();
-            }
-        }
-
-        if (available_components.external_forces_3d) {
-            if (!collection.is_type_present<ExternalForces3D>()) {
-                collection.add_type<ExternalForces3D>();
-            }
-        }
+        // register all available components as one group, components that are already present are skipped by add_types
+        ComponentGroup<>::add<MovementData, MovementData3D, ParticleInfo, ParticleData, ExternalForces, ExternalForces3D>(
+                collection, available_components.movement_data, available_components.movement_data_3d,
+                available_components.particle_info, available_components.particle_data,
+                available_components.external_forces, available_components.external_forces_3d);
     }
     ParticleSerializer::AvailableComponents ParticleSerializer::read_available_components(esbs::EndianSafeBinaryStream<Lz4CompressedStream>& stream) {
         AvailableComponents result;
@@ -44,4 +44,33 @@ namespace LibFluid {
         c.b = (uint8_t)j[2].get<int>();
         c.a = (uint8_t)j[3].get<int>();
     }
+    void to_json(nlohmann::json& j, const KernelType& t) {
+        switch (t) {
+            case KernelType::CubicSpline:
+                j = "cubic-spline";
+                break;
+            case KernelType::WendlandC2:
+                j = "wendland-c2";
+                break;
+            case KernelType::WendlandC4:
+                j = "wendland-c4";
+                break;
+            default:
+                FLUID_ASSERT(false, "Unknown kernel type!");
+                break;
+        }
+    }
+    void from_json(const nlohmann::json& j, KernelType& t) {
+        FLUID_ASSERT(j.is_string(), "Assumed a json string!");
+        auto name = j.get<std::string>();
+        if (name == "cubic-spline") {
+            t = KernelType::CubicSpline;
+        } else if (name == "wendland-c2") {
+            t = KernelType::WendlandC2;
+        } else if (name == "wendland-c4") {
+            t = KernelType::WendlandC4;
+        } else {
+            FLUID_ASSERT(false, "Unknown kernel type!");
+        }
+    }
 } // namespace LibFluid
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "fluidSolver/kernel/Kernel.hpp"
 #include "visualizer/Image.hpp"
 #include <glm/glm.hpp>
 #include <nlohmann/json.hpp>
@@ -26,5 +27,9 @@ namespace LibFluid {
     void to_json(nlohmann::json&, const LibFluid::Image::Color&);
     void from_json(const nlohmann::json&, LibFluid::Image::Color&);
 
+    // LibFluid::KernelType
+    void to_json(nlohmann::json&, const LibFluid::KernelType&);
+    void from_json(const nlohmann::json&, LibFluid::KernelType&);
+
 
 } // namespace LibFluid
\ No newline at end of file
@@ -85,6 +85,7 @@ namespace LibFluid::Serialization {
 
         nlohmann::json res;
         res["type"] = "boundary-preprocessor";
+        res["kernel"] = preprocessor->kernel.type;
 
         return res;
     }
@@ -146,6 +147,10 @@ namespace LibFluid::Serialization {
     std::shared_ptr<SimulationEntity> EntitySerializer::deserialize_particle_boundary_preprocessor(const nlohmann::json& node) {
         auto res = std::make_shared<BoundaryPreprocessor>();
 
+        if (node.contains("kernel")) {
+            res->kernel.type = node["kernel"].get<KernelType>();
+        }
+
         return res;
     }
 
@@ -140,6 +140,7 @@ namespace LibFluid::Serialization {
         }
 
         node["calculate-every-nth-step"] = sen->settings.calculate_plane_every_nth_step;
+        node["kernel"] = sen->settings.kernel_type;
 
         return node;
     }
@@ -267,6 +268,10 @@ namespace LibFluid::Serialization {
             res->settings.calculate_plane_every_nth_step = 1;
         }
 
+        if (node.contains("kernel")) {
+            res->settings.kernel_type = node["kernel"].get<KernelType>();
+        }
+
 
         return res;
     }
@@ -1,7 +1,13 @@
 #include "SolverSerializer.hpp"
 
+#include "fluidSolver/kernel/Kernel.hpp"
+#include "fluidSolver/kernel/TabulatedCubicSplineKernel3D.hpp"
+#include "fluidSolver/neighborhoodSearch/CompactGridNeighborhoodSearch.hpp"
 #include "fluidSolver/neighborhoodSearch/CompressedNeighbors.hpp"
+#include "fluidSolver/neighborhoodSearch/CsrNeighborhoodSearch3D.hpp"
 #include "fluidSolver/neighborhoodSearch/HashedNeighborhoodSearch3D.hpp"
+#include "fluidSolver/neighborhoodSearch/VerletNeighborhoodSearch.hpp"
+#include "fluidSolver/solver/DFSPHFluidSolver3D.hpp"
 #include "fluidSolver/solver/IISPHFluidSolver.hpp"
 #include "fluidSolver/solver/IISPHFluidSolver3D.hpp"
 #include "fluidSolver/solver/SESPHFluidSolver.hpp"
@@ -30,6 +36,13 @@ namespace LibFluid::Serialization {
 
             serialize_sesph_settings(node, casted->settings);
 
+        } else if (auto casted = std::dynamic_pointer_cast<SESPHFluidSolver<CubicSplineKernel, CompactGridNeighborhoodSearch>>(solver)) {
+            node["type"] = "sesph";
+            node["neighborhood-search"]["type"] = "compact-grid";
+            node["kernel"]["type"] = "cubic-spline-kernel";
+
+            serialize_sesph_settings(node, casted->settings);
+
         } else if (auto casted = std::dynamic_pointer_cast<IISPHFluidSolver<CubicSplineKernel, QuadraticNeighborhoodSearchDynamicAllocated>>(solver)) {
             node["type"] = "iisph";
             node["neighborhood-search"]["type"] = "quadratic-dynamic-allocated";
@@ -44,6 +57,13 @@ namespace LibFluid::Serialization {
 
             serialize_iisph_settings(node, casted->settings);
 
+        } else if (auto casted = std::dynamic_pointer_cast<IISPHFluidSolver<CubicSplineKernel, CompactGridNeighborhoodSearch>>(solver)) {
+            node["type"] = "iisph";
+            node["neighborhood-search"]["type"] = "compact-grid";
+            node["kernel"]["type"] = "cubic-spline-kernel";
+
+            serialize_iisph_settings(node, casted->settings);
+
         } else if (auto casted = std::dynamic_pointer_cast<SESPHFluidSolver3D<CubicSplineKernel3D, QuadraticNeighborhoodSearch3D>>(solver)) {
             node["type"] = "sesph-3d";
             node["neighborhood-search"]["type"] = "quadratic-dynamic-allocated-3d";
@@ -65,6 +85,21 @@ namespace LibFluid::Serialization {
 
             serialize_sesph_3d_settings(node, casted->settings);
 
+        } else if (auto casted = std::dynamic_pointer_cast<SESPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "sesph-3d";
+            node["neighborhood-search"]["type"] = "csr-3d";
+            node["kernel"]["type"] = "cubic-spline-kernel-3d";
+
+            serialize_sesph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<SESPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(solver)) {
+            node["type"] = "sesph-3d";
+            node["neighborhood-search"]["type"] = "verlet-hashed-3d";
+            node["neighborhood-search"]["skin-factor"] = casted->neighborhood_search.skin_factor;
+            node["kernel"]["type"] = "cubic-spline-kernel-3d";
+
+            serialize_sesph_3d_settings(node, casted->settings);
+
         } else if (auto casted = std::dynamic_pointer_cast<IISPHFluidSolver3D<CubicSplineKernel3D, QuadraticNeighborhoodSearch3D>>(solver)) {
             node["type"] = "iisph-3d";
             node["neighborhood-search"]["type"] = "quadratic-dynamic-allocated-3d";
@@ -86,6 +121,120 @@ namespace LibFluid::Serialization {
 
             serialize_iisph_3d_settings(node, casted->settings);
 
+        } else if (auto casted = std::dynamic_pointer_cast<IISPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "iisph-3d";
+            node["neighborhood-search"]["type"] = "csr-3d";
+            node["kernel"]["type"] = "cubic-spline-kernel-3d";
+
+            serialize_iisph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<IISPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(solver)) {
+            node["type"] = "iisph-3d";
+            node["neighborhood-search"]["type"] = "verlet-hashed-3d";
+            node["neighborhood-search"]["skin-factor"] = casted->neighborhood_search.skin_factor;
+            node["kernel"]["type"] = "cubic-spline-kernel-3d";
+
+            serialize_iisph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, QuadraticNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "dfsph-3d";
+            node["neighborhood-search"]["type"] = "quadratic-dynamic-allocated-3d";
+            node["kernel"]["type"] = "cubic-spline-kernel-3d";
+
+            serialize_dfsph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, HashedNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "dfsph-3d";
+            node["neighborhood-search"]["type"] = "hashed-3d";
+            node["kernel"]["type"] = "cubic-spline-kernel-3d";
+
+            serialize_dfsph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, CompressedNeighborhoodSearch>>(solver)) {
+            node["type"] = "dfsph-3d";
+            node["neighborhood-search"]["type"] = "compressed-3d";
+            node["kernel"]["type"] = "cubic-spline-kernel-3d";
+
+            serialize_dfsph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, CsrNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "dfsph-3d";
+            node["neighborhood-search"]["type"] = "csr-3d";
+            node["kernel"]["type"] = "cubic-spline-kernel-3d";
+
+            serialize_dfsph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<DFSPHFluidSolver3D<CubicSplineKernel3D, VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>>>(solver)) {
+            node["type"] = "dfsph-3d";
+            node["neighborhood-search"]["type"] = "verlet-hashed-3d";
+            node["neighborhood-search"]["skin-factor"] = casted->neighborhood_search.skin_factor;
+            node["kernel"]["type"] = "cubic-spline-kernel-3d";
+
+            serialize_dfsph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<SESPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "sesph-3d";
+            node["neighborhood-search"]["type"] = "hashed-3d";
+            node["kernel"]["type"] = "tabulated-cubic-spline-kernel-3d";
+
+            serialize_sesph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<IISPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "iisph-3d";
+            node["neighborhood-search"]["type"] = "hashed-3d";
+            node["kernel"]["type"] = "tabulated-cubic-spline-kernel-3d";
+
+            serialize_iisph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<DFSPHFluidSolver3D<TabulatedCubicSplineKernel3D, HashedNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "dfsph-3d";
+            node["neighborhood-search"]["type"] = "hashed-3d";
+            node["kernel"]["type"] = "tabulated-cubic-spline-kernel-3d";
+
+            serialize_dfsph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<SESPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "sesph-3d";
+            node["neighborhood-search"]["type"] = "hashed-3d";
+            node["kernel"]["type"] = "wendland-c2-kernel-3d";
+
+            serialize_sesph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<IISPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "iisph-3d";
+            node["neighborhood-search"]["type"] = "hashed-3d";
+            node["kernel"]["type"] = "wendland-c2-kernel-3d";
+
+            serialize_iisph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<DFSPHFluidSolver3D<WendlandC2Kernel3D, HashedNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "dfsph-3d";
+            node["neighborhood-search"]["type"] = "hashed-3d";
+            node["kernel"]["type"] = "wendland-c2-kernel-3d";
+
+            serialize_dfsph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<SESPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "sesph-3d";
+            node["neighborhood-search"]["type"] = "hashed-3d";
+            node["kernel"]["type"] = "wendland-c4-kernel-3d";
+
+            serialize_sesph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<IISPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "iisph-3d";
+            node["neighborhood-search"]["type"] = "hashed-3d";
+            node["kernel"]["type"] = "wendland-c4-kernel-3d";
+
+            serialize_iisph_3d_settings(node, casted->settings);
+
+        } else if (auto casted = std::dynamic_pointer_cast<DFSPHFluidSolver3D<WendlandC4Kernel3D, HashedNeighborhoodSearch3D>>(solver)) {
+            node["type"] = "dfsph-3d";
+            node["neighborhood-search"]["type"] = "hashed-3d";
+            node["kernel"]["type"] = "wendland-c4-kernel-3d";
+
+            serialize_dfsph_3d_settings(node, casted->settings);
+
         } else {
             context().add_issue("Encountered unhandled solver, neighborhood search, kernel combination!");
         }
@@ -108,6 +257,9 @@ namespace LibFluid::Serialization {
             node["single-layer-settings"]["gamma-1"] = settings.single_layer_boundary_gamma_1;
             node["single-layer-settings"]["gamma-2"] = settings.single_layer_boundary_gamma_2;
         }
+
+        node["pairwise-force-computation-enabled"] = settings.pairwise_force_computation;
+        node["vectorized-density-computation-enabled"] = settings.vectorized_density_computation;
     }
 
     void SolverSerializer::serialize_iisph_settings(nlohmann::json& node, const IISPHSettings& settings) {
@@ -132,6 +284,27 @@ namespace LibFluid::Serialization {
             node["single-layer-settings"]["gamma-1"] = settings.single_layer_boundary_gamma_1;
             // TODO: eventually gamma should be in here
         }
+
+        node["warm-start-pressure-enabled"] = settings.warm_start_pressure;
+        if (settings.warm_start_pressure) {
+            node["warm-start-settings"]["pressure-factor"] = settings.warm_start_pressure_factor;
+        }
+
+        node["vectorized-density-computation-enabled"] = settings.vectorized_density_computation;
+    }
+
+    void SolverSerializer::serialize_dfsph_3d_settings(nlohmann::json& node, const DFSPHSettings3D& settings) {
+        node["max-density-error"] = settings.max_density_error_allowed;
+        node["max-iterations"] = settings.max_number_of_iterations;
+        node["min-iterations"] = settings.min_number_of_iterations;
+        node["viscosity"] = settings.viscosity;
+
+        node["divergence-solve-enabled"] = settings.divergence_solve;
+        if (settings.divergence_solve) {
+            node["divergence-solve-settings"]["max-divergence-error"] = settings.max_divergence_error_allowed;
+            node["divergence-solve-settings"]["max-iterations"] = settings.max_number_of_divergence_iterations;
+            node["divergence-solve-settings"]["min-iterations"] = settings.min_number_of_divergence_iterations;
+        }
     }
 
     std::shared_ptr<IFluidSolverBase> SolverSerializer::deserialize(const nlohmann::json& node) {
@@ -159,6 +332,18 @@ namespace LibFluid::Serialization {
             } else if (neighborhood_search_type == "hashed") {
                 using Ns = HashedNeighborhoodSearch;
 
+                if (solver_type == "sesph") {
+                    auto res = std::make_shared<SESPHFluidSolver<Kn, Ns>>();
+                    deserialize_sesph_settings(res->settings, node);
+                    return res;
+                } else if (solver_type == "iisph") {
+                    auto res = std::make_shared<IISPHFluidSolver<Kn, Ns>>();
+                    deserialize_iisph_settings(res->settings, node);
+                    return res;
+                }
+            } else if (neighborhood_search_type == "compact-grid") {
+                using Ns = CompactGridNeighborhoodSearch;
+
                 if (solver_type == "sesph") {
                     auto res = std::make_shared<SESPHFluidSolver<Kn, Ns>>();
                     deserialize_sesph_settings(res->settings, node);
@@ -183,6 +368,10 @@ namespace LibFluid::Serialization {
                     auto res = std::make_shared<IISPHFluidSolver3D<Kn, Ns>>();
                     deserialize_iisph_3d_settings(res->settings, node);
                     return res;
+                } else if (solver_type == "dfsph-3d") {
+                    auto res = std::make_shared<DFSPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_dfsph_3d_settings(res->settings, node);
+                    return res;
                 }
 
             } else if (neighborhood_search_type == "hashed-3d") {
@@ -196,6 +385,10 @@ namespace LibFluid::Serialization {
                     auto res = std::make_shared<IISPHFluidSolver3D<Kn, Ns>>();
                     deserialize_iisph_3d_settings(res->settings, node);
                     return res;
+                } else if (solver_type == "dfsph-3d") {
+                    auto res = std::make_shared<DFSPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_dfsph_3d_settings(res->settings, node);
+                    return res;
                 }
 
             } else if (neighborhood_search_type == "compressed-3d") {
@@ -209,6 +402,105 @@ namespace LibFluid::Serialization {
                     auto res = std::make_shared<IISPHFluidSolver3D<Kn, Ns>>();
                     deserialize_iisph_3d_settings(res->settings, node);
                     return res;
+                } else if (solver_type == "dfsph-3d") {
+                    auto res = std::make_shared<DFSPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_dfsph_3d_settings(res->settings, node);
+                    return res;
+                }
+            } else if (neighborhood_search_type == "csr-3d") {
+                using Ns = CsrNeighborhoodSearch3D;
+
+                if (solver_type == "sesph-3d") {
+                    auto res = std::make_shared<SESPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_sesph_3d_settings(res->settings, node);
+                    return res;
+                } else if (solver_type == "iisph-3d") {
+                    auto res = std::make_shared<IISPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_iisph_3d_settings(res->settings, node);
+                    return res;
+                } else if (solver_type == "dfsph-3d") {
+                    auto res = std::make_shared<DFSPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_dfsph_3d_settings(res->settings, node);
+                    return res;
+                }
+            } else if (neighborhood_search_type == "verlet-hashed-3d") {
+                using Ns = VerletNeighborhoodSearch<HashedNeighborhoodSearch3D>;
+
+                if (solver_type == "sesph-3d") {
+                    auto res = std::make_shared<SESPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_sesph_3d_settings(res->settings, node);
+                    deserialize_verlet_skin_factor(res->neighborhood_search.skin_factor, node);
+                    return res;
+                } else if (solver_type == "iisph-3d") {
+                    auto res = std::make_shared<IISPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_iisph_3d_settings(res->settings, node);
+                    deserialize_verlet_skin_factor(res->neighborhood_search.skin_factor, node);
+                    return res;
+                } else if (solver_type == "dfsph-3d") {
+                    auto res = std::make_shared<DFSPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_dfsph_3d_settings(res->settings, node);
+                    deserialize_verlet_skin_factor(res->neighborhood_search.skin_factor, node);
+                    return res;
+                }
+            }
+        } else if (kernel_type == "tabulated-cubic-spline-kernel-3d") {
+            using Kn = TabulatedCubicSplineKernel3D;
+
+            if (neighborhood_search_type == "hashed-3d") {
+                using Ns = HashedNeighborhoodSearch3D;
+
+                if (solver_type == "sesph-3d") {
+                    auto res = std::make_shared<SESPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_sesph_3d_settings(res->settings, node);
+                    return res;
+                } else if (solver_type == "iisph-3d") {
+                    auto res = std::make_shared<IISPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_iisph_3d_settings(res->settings, node);
+                    return res;
+                } else if (solver_type == "dfsph-3d") {
+                    auto res = std::make_shared<DFSPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_dfsph_3d_settings(res->settings, node);
+                    return res;
+                }
+            }
+        } else if (kernel_type == "wendland-c2-kernel-3d") {
+            using Kn = WendlandC2Kernel3D;
+
+            if (neighborhood_search_type == "hashed-3d") {
+                using Ns = HashedNeighborhoodSearch3D;
+
+                if (solver_type == "sesph-3d") {
+                    auto res = std::make_shared<SESPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_sesph_3d_settings(res->settings, node);
+                    return res;
+                } else if (solver_type == "iisph-3d") {
+                    auto res = std::make_shared<IISPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_iisph_3d_settings(res->settings, node);
+                    return res;
+                } else if (solver_type == "dfsph-3d") {
+                    auto res = std::make_shared<DFSPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_dfsph_3d_settings(res->settings, node);
+                    return res;
+                }
+            }
+        } else if (kernel_type == "wendland-c4-kernel-3d") {
+            using Kn = WendlandC4Kernel3D;
+
+            if (neighborhood_search_type == "hashed-3d") {
+                using Ns = HashedNeighborhoodSearch3D;
+
+                if (solver_type == "sesph-3d") {
+                    auto res = std::make_shared<SESPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_sesph_3d_settings(res->settings, node);
+                    return res;
+                } else if (solver_type == "iisph-3d") {
+                    auto res = std::make_shared<IISPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_iisph_3d_settings(res->settings, node);
+                    return res;
+                } else if (solver_type == "dfsph-3d") {
+                    auto res = std::make_shared<DFSPHFluidSolver3D<Kn, Ns>>();
+                    deserialize_dfsph_3d_settings(res->settings, node);
+                    return res;
                 }
             }
         }
@@ -232,6 +524,14 @@ namespace LibFluid::Serialization {
             settings.single_layer_boundary_gamma_1 = node["single-layer-settings"]["gamma-1"].get<float>();
             settings.single_layer_boundary_gamma_2 = node["single-layer-settings"]["gamma-2"].get<float>();
         }
+
+        if (node.contains("pairwise-force-computation-enabled")) {
+            settings.pairwise_force_computation = node["pairwise-force-computation-enabled"].get<bool>();
+        }
+
+        if (node.contains("vectorized-density-computation-enabled")) {
+            settings.vectorized_density_computation = node["vectorized-density-computation-enabled"].get<bool>();
+        }
     }
 
     void SolverSerializer::deserialize_iisph_settings(IISPHSettings& settings, const nlohmann::json& node) {
@@ -256,6 +556,38 @@ namespace LibFluid::Serialization {
             settings.single_layer_boundary_gamma_1 = node["single-layer-settings"]["gamma-1"].get<float>();
             // TODO: eventually gamma should be in here
         }
+
+        if (node.contains("warm-start-pressure-enabled")) {
+            settings.warm_start_pressure = node["warm-start-pressure-enabled"].get<bool>();
+            if (settings.warm_start_pressure) {
+                settings.warm_start_pressure_factor = node["warm-start-settings"]["pressure-factor"].get<float>();
+            }
+        }
+
+        if (node.contains("vectorized-density-computation-enabled")) {
+            settings.vectorized_density_computation = node["vectorized-density-computation-enabled"].get<bool>();
+        }
+    }
+
+    void SolverSerializer::deserialize_verlet_skin_factor(float& skin_factor, const nlohmann::json& node) {
+        // older scenarios do not contain the skin factor and keep the default value
+        if (node["neighborhood-search"].contains("skin-factor")) {
+            skin_factor = node["neighborhood-search"]["skin-factor"].get<float>();
+        }
+    }
+
+    void SolverSerializer::deserialize_dfsph_3d_settings(DFSPHSettings3D& settings, const nlohmann::json& node) {
+        settings.max_density_error_allowed = node["max-density-error"].get<float>();
+        settings.max_number_of_iterations = node["max-iterations"].get<size_t>();
+        settings.min_number_of_iterations = node["min-iterations"].get<size_t>();
+        settings.viscosity = node["viscosity"].get<float>();
+
+        settings.divergence_solve = node["divergence-solve-enabled"].get<bool>();
+        if (settings.divergence_solve) {
+            settings.max_divergence_error_allowed = node["divergence-solve-settings"]["max-divergence-error"].get<float>();
+            settings.max_number_of_divergence_iterations = node["divergence-solve-settings"]["max-iterations"].get<size_t>();
+            settings.min_number_of_divergence_iterations = node["divergence-solve-settings"]["min-iterations"].get<size_t>();
+        }
     }
 
 } // namespace LibFluid::Serialization
\ No newline at end of file
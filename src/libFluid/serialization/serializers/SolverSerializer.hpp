@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fluidSolver/IFluidSolver.hpp"
+#include "fluidSolver/solver/settings/DFSPHSettings3D.hpp"
 #include "fluidSolver/solver/settings/IISPHSettings.hpp"
 #include "fluidSolver/solver/settings/IISPHSettings3D.hpp"
 #include "fluidSolver/solver/settings/SESPHSettings.hpp"
@@ -24,10 +25,14 @@ namespace LibFluid::Serialization {
         void serialize_sesph_3d_settings(nlohmann::json& node, const SESPHSettings3D& settings);
         void serialize_iisph_settings(nlohmann::json& node, const IISPHSettings& settings);
         void serialize_iisph_3d_settings(nlohmann::json& node, const IISPHSettings3D& settings);
+        void serialize_dfsph_3d_settings(nlohmann::json& node, const DFSPHSettings3D& settings);
 
         void deserialize_sesph_settings(SESPHSettings& settings, const nlohmann::json& node);
         void deserialize_sesph_3d_settings(SESPHSettings3D& settings, const nlohmann::json& node);
         void deserialize_iisph_settings(IISPHSettings& settings, const nlohmann::json& node);
         void deserialize_iisph_3d_settings(IISPHSettings3D& settings, const nlohmann::json& node);
+        void deserialize_dfsph_3d_settings(DFSPHSettings3D& settings, const nlohmann::json& node);
+
+        void deserialize_verlet_skin_factor(float& skin_factor, const nlohmann::json& node);
     };
 } // namespace LibFluid::Serialization
\ No newline at end of file
@@ -141,6 +141,7 @@ namespace LibFluid::Serialization {
         }
 
         node["settings"]["surface"]["fraction-of-rest-density"] = r->accelerator.surface_density_as_fraction_of_rest_density;
+        node["settings"]["surface"]["kernel"] = r->accelerator.kernel_type;
 
         if (r->skybox.skybox_image.width() == 0 || r->skybox.skybox_image.height() == 0) {
             // empty skybox -> create null object
@@ -192,6 +193,9 @@ namespace LibFluid::Serialization {
         }
 
         r->accelerator.surface_density_as_fraction_of_rest_density = node["settings"]["surface"]["fraction-of-rest-density"].get<float>();
+        if (node["settings"]["surface"].contains("kernel")) {
+            r->accelerator.kernel_type = node["settings"]["surface"]["kernel"].get<KernelType>();
+        }
 
         if (!node["settings"]["skybox"]["image"].is_null()) {
             // deserialize the base64 encoded hdr image file
@@ -243,6 +247,7 @@ namespace LibFluid::Serialization {
         }
 
         node["settings"]["surface"]["fraction-of-rest-density"] = r->accelerator.surface_density_as_fraction_of_rest_density;
+        node["settings"]["surface"]["kernel"] = r->accelerator.kernel_type;
 
         node["settings"]["fluid-color"] = r->settings.fluid_color;
         node["settings"]["boundary-color"] = r->settings.boundary_color;
@@ -294,6 +299,9 @@ namespace LibFluid::Serialization {
         }
 
         r->accelerator.surface_density_as_fraction_of_rest_density = node["settings"]["surface"]["fraction-of-rest-density"].get<float>();
+        if (node["settings"]["surface"].contains("kernel")) {
+            r->accelerator.kernel_type = node["settings"]["surface"]["kernel"].get<KernelType>();
+        }
 
         r->settings.fluid_color = node["settings"]["fluid-color"].get<glm::vec3>();
         r->settings.boundary_color = node["settings"]["boundary-color"].get<glm::vec3>();
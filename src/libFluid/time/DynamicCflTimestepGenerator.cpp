@@ -1,46 +1,42 @@
 #include "DynamicCflTimestepGenerator.hpp"
 
+#include "parallelization/StdParallelForEach.hpp"
+
 #include <algorithm>
+#include <cmath>
 
 namespace LibFluid {
+    namespace {
+        template<typename MovementDataType>
+        std::tuple<float, float> reduce_maximum_velocity_and_acceleration(ParticleCollection* collection) {
+            // x: squared velocity, y: squared acceleration
+            glm::vec2 maximum_squared = StdParallelForEach::reduce(
+                    0, collection->size(), glm::vec2(0.0f),
+                    [collection](size_t i) {
+                        auto type = collection->get<ParticleInfo>(i).type;
+                        if (type == ParticleTypeInactive)
+                            return glm::vec2(0.0f);
+
+                        const auto& movement_data = collection->get<MovementDataType>(i);
+                        return glm::vec2(glm::dot(movement_data.velocity, movement_data.velocity),
+                                glm::dot(movement_data.acceleration, movement_data.acceleration));
+                    },
+                    [](const glm::vec2& a, const glm::vec2& b) { return glm::vec2(std::max(a.x, b.x), std::max(a.y, b.y)); });
+
+            return {std::sqrt(maximum_squared.x), std::sqrt(maximum_squared.y)};
+        }
+    } // namespace
+
     std::tuple<float, float> DynamicCflTimestepGenerator::calculate_maximum_velocity_and_acceleration() {
         FLUID_ASSERT(parameters.particle_collection != nullptr);
         FLUID_ASSERT(parameters.particle_collection->is_type_present<MovementData>() || parameters.particle_collection->is_type_present<MovementData3D>());
         FLUID_ASSERT(parameters.particle_collection->is_type_present<ParticleInfo>());
 
-        float maximum_veloctiy = 0.0f;
-        float maximum_acceleration = 0.0f;
-
         if (parameters.particle_collection->is_type_present<MovementData3D>()) {
-            for (uint32_t i = 0; i < parameters.particle_collection->size(); i++) {
-                auto type = parameters.particle_collection->get<ParticleInfo>(i).type;
-                if (type == ParticleTypeInactive)
-                    continue;
-
-
-                const glm::vec3& velocity = parameters.particle_collection->get<MovementData3D>(i).velocity;
-                const glm::vec3& acceleration = parameters.particle_collection->get<MovementData3D>(i).acceleration;
-
-                maximum_veloctiy = std::max(maximum_veloctiy, (float)glm::length(velocity));
-                maximum_acceleration = std::max(maximum_acceleration, (float)glm::length(acceleration));
-            }
+            return reduce_maximum_velocity_and_acceleration<MovementData3D>(parameters.particle_collection.get());
         } else {
-            for (uint32_t i = 0; i < parameters.particle_collection->size(); i++) {
-                auto type = parameters.particle_collection->get<ParticleInfo>(i).type;
-                if (type == ParticleTypeInactive)
-                    continue;
-
-
-                const glm::vec2& velocity = parameters.particle_collection->get<MovementData>(i).velocity;
-                const glm::vec2& acceleration = parameters.particle_collection->get<MovementData>(i).acceleration;
-
-                maximum_veloctiy = std::max(maximum_veloctiy, (float)glm::length(velocity));
-                maximum_acceleration = std::max(maximum_acceleration, (float)glm::length(acceleration));
-            }
+            return reduce_maximum_velocity_and_acceleration<MovementData>(parameters.particle_collection.get());
         }
-
-
-        return {maximum_veloctiy, maximum_acceleration};
     }
 
     void DynamicCflTimestepGenerator::generate_next_timestep() {
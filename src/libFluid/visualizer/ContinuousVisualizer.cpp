@@ -123,12 +123,10 @@ namespace LibFluid {
         float boundaryDensity = 0.0f;
         float normalDensity = 0.0f;
 
-        auto neighbors = simulation_data.neighborhood_interface->get_neighbors(position);
-
-        for (size_t neighbor : neighbors) {
+        simulation_data.neighborhood_interface->for_each_neighbor(position, [&](size_t neighbor) {
             const auto& pi = simulation_data.collection->get<ParticleInfo>(neighbor);
             if (pi.type == ParticleTypeInactive) {
-                continue; // don*t calculate unnecessary values for inactive particles.
+                return; // don*t calculate unnecessary values for inactive particles.
             }
 
             const auto& pm = simulation_data.collection->get<MovementData>(neighbor);
@@ -141,7 +139,7 @@ namespace LibFluid {
             } else if (pi.type == ParticleTypeBoundary) {
                 boundaryDensity += densityContribution;
             }
-        }
+        });
 
         float density = normalDensity + boundaryDensity;
 
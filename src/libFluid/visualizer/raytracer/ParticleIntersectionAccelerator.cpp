@@ -9,6 +9,7 @@ namespace LibFluid::Raytracer {
         // calculate aabb
         calculate_aabb();
 
+        kernel.type = kernel_type;
         kernel.kernel_support = Math::kernel_support_factor * particle_size;
         kernel.initialize();
 
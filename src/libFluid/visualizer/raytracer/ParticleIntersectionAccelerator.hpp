@@ -1,7 +1,7 @@
 #pragma once
 
 #include "fluidSolver/ParticleCollection.hpp"
-#include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
+#include "fluidSolver/kernel/SelectableKernel3D.hpp"
 #include "fluidSolver/neighborhoodSearch/CompressedNeighbors.hpp"
 #include "visualizer/raytracer/AABB.hpp"
 #include "visualizer/raytracer/IntersectionResult.hpp"
@@ -19,6 +19,9 @@ namespace LibFluid::Raytracer {
         float rest_density = 1000.0f;
         float surface_density_as_fraction_of_rest_density = 0.8f;
 
+        // kernel used to reconstruct the fluid surface from the particles
+        KernelType kernel_type = KernelType::CubicSpline;
+
         Sampler* sampler = nullptr;
 
         void prepare();
@@ -32,7 +35,7 @@ namespace LibFluid::Raytracer {
         void calculate_aabb();
 
       private:
-        CubicSplineKernel3D kernel;
+        SelectableKernel3D kernel;
         CompressedNeighborhoodSearch neighborhood_search;
 
       private:
@@ -107,3 +107,60 @@ TEST(CompressedNeighborhoodSearch, NeighborhoodStorageCopy)
     ASSERT_EQ(22, storage.size());
     ASSERT_EQ(20, copied_by_assignment.size());
 }
+
+TEST(CompressedNeighborhoodSearch, NeighborhoodStorageStreamingDecode)
+{
+    using namespace LibFluid;
+
+    CompressedNeighborhoodSearch::NeighborStorage storage;
+    storage.clear();
+    storage.set_first_neighbor(7);
+
+    // covers the zero, one and four byte representations of the deltas, the last two deltas only fill a part of a
+    // control byte
+    std::vector<uint32_t> deltas = {1, 2, 3, 258, 259, 100000, 1, 2, 17, 70000, 1, 255, 2, 300};
+    std::vector<uint32_t> expected = {7};
+    for (uint32_t delta : deltas)
+    {
+        storage.set_next_neighbor(delta);
+        expected.push_back(expected.back() + delta);
+    }
+
+    size_t byte_offset = 0;
+    for (size_t i = 0; i < deltas.size(); i++)
+    {
+        ASSERT_EQ(deltas[i], storage.get_delta(i));
+        ASSERT_EQ(deltas[i], storage.decode_delta(i, byte_offset));
+    }
+    ASSERT_EQ(byte_offset, storage.get_used_delta_bytes());
+
+    std::vector<uint32_t> decoded(storage.size());
+    ASSERT_EQ(storage.size(), storage.decode_into(decoded.data()));
+    ASSERT_EQ(expected, decoded);
+
+    storage.clear();
+    ASSERT_EQ(0, storage.decode_into(decoded.data()));
+}
+
+TEST(CompressedNeighborhoodSearch, NeighborhoodStorageDecodeFullStorage)
+{
+    using namespace LibFluid;
+
+    CompressedNeighborhoodSearch::NeighborStorage storage;
+    storage.clear();
+    storage.set_first_neighbor(3);
+
+    // fills all delta bytes with four byte deltas and stores the remaining deltas without bytes
+    std::vector<uint32_t> expected = {3};
+    for (size_t i = 0; i < CompressedNeighborhoodSearch::NeighborStorage::MAX_DELTAS; i++)
+    {
+        uint32_t delta = i < CompressedNeighborhoodSearch::NeighborStorage::DELTAS_SIZE / 4 ? 1000 + i : 1 + i % 2;
+        storage.set_next_neighbor(delta);
+        expected.push_back(expected.back() + delta);
+    }
+    ASSERT_EQ(CompressedNeighborhoodSearch::NeighborStorage::DELTAS_SIZE, storage.get_used_delta_bytes());
+
+    std::vector<uint32_t> decoded(storage.size());
+    ASSERT_EQ(storage.size(), storage.decode_into(decoded.data()));
+    ASSERT_EQ(expected, decoded);
+}
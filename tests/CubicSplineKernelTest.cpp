@@ -1,7 +1,13 @@
+#include "fluidSolver/kernel/BatchedCubicSplineKernel3D.hpp"
 #include "fluidSolver/kernel/CubicSplineKernel.hpp"
+#include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
+#include "fluidSolver/kernel/TabulatedCubicSplineKernel3D.hpp"
 
 #include <gtest/gtest.h>
 
+#include <random>
+#include <vector>
+
 TEST(CubicSplineKernelTest, CompactKernelSupportTest)
 {
     auto kernel = LibFluid::CubicSplineKernel();
@@ -133,4 +139,134 @@ TEST(CubicSplineKernelDerivativeTest, PointSymmetricTest)
                             -kernel.GetKernelDerivativeValue(glm::vec2(-t, -0.8f * t)).y);
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(CubicSplineKernelTest, TabulatedKernel3DAccuracyTest)
+{
+    const glm::vec3 directions[] = {glm::vec3(1.0f, 0.0f, 0.0f), glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f)),
+                                    glm::normalize(glm::vec3(-0.3f, 0.5f, -0.8f))};
+
+    for (float kernel_support : {0.2f, 1.0f, 2.5f})
+    {
+        auto reference = LibFluid::CubicSplineKernel3D();
+        reference.kernel_support = kernel_support;
+        reference.initialize();
+
+        auto tabulated = LibFluid::TabulatedCubicSplineKernel3D();
+        tabulated.kernel_support = kernel_support;
+        tabulated.initialize();
+
+        // the errors are measured relative to the largest value and gradient of the kernel
+        float max_value = reference.GetKernelValue(glm::vec3(0.0f));
+        float max_gradient = 0.0f;
+        for (float t = 0.0f; t <= 1.0f; t += 0.001f)
+        {
+            max_gradient = std::max(
+                max_gradient, glm::length(reference.GetKernelDerivativeValue(glm::vec3(t * kernel_support, 0.0f, 0.0f))));
+        }
+
+        glm::vec3 neighbor_position = glm::vec3(0.3f, -0.2f, 0.1f) * kernel_support;
+        for (const auto& direction : directions)
+        {
+            for (float t = 0.0f; t <= 1.1f; t += 0.0005f)
+            {
+                glm::vec3 position = neighbor_position + t * kernel_support * direction;
+
+                EXPECT_NEAR(tabulated.GetKernelValue(neighbor_position, position),
+                            reference.GetKernelValue(neighbor_position, position), 1e-4f * max_value);
+
+                glm::vec3 gradient = tabulated.GetKernelDerivativeReversedValue(neighbor_position, position);
+                glm::vec3 reference_gradient = reference.GetKernelDerivativeReversedValue(neighbor_position, position);
+                EXPECT_LE(glm::length(gradient - reference_gradient), 2e-3f * max_gradient);
+
+                glm::vec3 derivative = tabulated.GetKernelDerivativeValue(neighbor_position, position);
+                glm::vec3 reference_derivative = reference.GetKernelDerivativeValue(neighbor_position, position);
+                EXPECT_LE(glm::length(derivative - reference_derivative), 2e-3f * max_gradient);
+
+                // the combined call yields exactly the values of the single calls
+                auto value_and_gradient = tabulated.value_and_gradient(neighbor_position, position);
+                EXPECT_FLOAT_EQ(value_and_gradient.value, tabulated.GetKernelValue(neighbor_position, position));
+                EXPECT_FLOAT_EQ(value_and_gradient.gradient.x, gradient.x);
+                EXPECT_FLOAT_EQ(value_and_gradient.gradient.y, gradient.y);
+                EXPECT_FLOAT_EQ(value_and_gradient.gradient.z, gradient.z);
+
+                if (t >= 1.0f)
+                {
+                    // compact support
+                    EXPECT_EQ(value_and_gradient.value, 0.0f);
+                    EXPECT_EQ(glm::length(value_and_gradient.gradient), 0.0f);
+                }
+            }
+        }
+    }
+}
+
+TEST(CubicSplineKernelTest, BatchedKernel3DMatchesKernelTest)
+{
+    const float kernel_support = 0.4f;
+
+    auto reference = LibFluid::CubicSplineKernel3D();
+    reference.kernel_support = kernel_support;
+    reference.initialize();
+
+    // positions are stored with a stride to cover structure of arrays and array of structures layouts
+    const size_t particle_count = 200;
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-kernel_support, kernel_support);
+
+    for (size_t stride : {(size_t)1, (size_t)9})
+    {
+        std::vector<float> coordinates(particle_count * stride * 3);
+        std::vector<float> weights(particle_count);
+        for (size_t i = 0; i < particle_count; i++)
+        {
+            for (size_t axis = 0; axis < 3; axis++)
+            {
+                coordinates[i * stride * 3 + axis] = distribution(generator);
+            }
+            weights[i] = 0.5f + (float)(i % 7);
+        }
+
+        LibFluid::BatchedCubicSplineKernel3D::Positions positions = {coordinates.data(), coordinates.data() + 1,
+                                                                     coordinates.data() + 2, stride * 3};
+
+        glm::vec3 position = glm::vec3(0.05f, -0.02f, 0.01f);
+
+        for (auto instruction_set : {LibFluid::BatchedCubicSplineKernel3D::InstructionSet::Scalar,
+                                     LibFluid::BatchedCubicSplineKernel3D::InstructionSet::Avx2,
+                                     LibFluid::BatchedCubicSplineKernel3D::InstructionSet::Avx512})
+        {
+            auto batched = LibFluid::BatchedCubicSplineKernel3D();
+            batched.kernel_support = kernel_support;
+            batched.maximum_instruction_set = instruction_set;
+            batched.initialize();
+            if (batched.get_instruction_set() != instruction_set)
+            {
+                continue; // not supported by this cpu
+            }
+
+            // the neighbors are visited in a scrambled order and their count covers partially filled vectors
+            std::vector<uint32_t> neighbors;
+            for (size_t count = 0; count <= particle_count; count++)
+            {
+                float expected = 0.0f;
+                for (uint32_t neighbor : neighbors)
+                {
+                    glm::vec3 neighbor_position =
+                        glm::vec3(coordinates[neighbor * stride * 3], coordinates[neighbor * stride * 3 + 1],
+                                  coordinates[neighbor * stride * 3 + 2]);
+                    expected += weights[neighbor] * reference.GetKernelValue(neighbor_position, position);
+                }
+
+                float tolerance = 1e-5f * std::max(expected, reference.GetKernelValue(glm::vec3(0.0f)));
+                EXPECT_NEAR(batched.sum_weighted_values(position, neighbors.data(), neighbors.size(), positions,
+                                                        weights.data()),
+                            expected, tolerance);
+                EXPECT_NEAR(batched.sum_weighted_values(position, neighbors, positions, weights.data()), expected,
+                            tolerance);
+
+                neighbors.push_back((uint32_t)((count * 37) % particle_count));
+            }
+        }
+    }
+}
@@ -0,0 +1,552 @@
+#include "LibFluidMath.hpp"
+#include "fluidSolver/MovementColumns3D.hpp"
+#include "fluidSolver/neighborhoodSearch/HashedNeighborhoodSearch3D.hpp"
+#include "fluidSolver/neighborhoodSearch/QuadraticNeighborhoodSearch3D.hpp"
+#include "fluidSolver/solver/DFSPHFluidSolver3D.hpp"
+#include "fluidSolver/solver/IISPHFluidSolver3D.hpp"
+#include "fluidSolver/solver/SESPHFluidSolver3D.hpp"
+#include "time/ConstantTimestepGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const float particle_size = 0.1f;
+    const float rest_density = 1000.0f;
+
+    void add_particle(LibFluid::ParticleCollection& collection, const glm::vec3& position, const glm::vec3& velocity,
+                      LibFluid::ParticleType type)
+    {
+        auto index = collection.add();
+        collection.get<LibFluid::MovementData3D>(index) = {position, velocity, glm::vec3(0.0f)};
+        collection.get<LibFluid::ParticleData>(index) = {rest_density * particle_size * particle_size * particle_size,
+                                                          0.0f, rest_density};
+        collection.get<LibFluid::ParticleInfo>(index) = {(uint32_t)index, (uint8_t)type};
+        collection.get<LibFluid::ExternalForces3D>(index).non_pressure_acceleration = glm::vec3(0.0f);
+    }
+
+    /**
+     * Creates a block of size^3 fluid particles with randomly displaced positions and random velocities, which rests
+     * on two layers of boundary particles. The particles are added in random order.
+     */
+    std::shared_ptr<LibFluid::ParticleCollection> create_random_block(int size, uint32_t seed)
+    {
+        auto collection = std::make_shared<LibFluid::ParticleCollection>();
+        collection->add_types<LibFluid::MovementData3D, LibFluid::ParticleData, LibFluid::ParticleInfo,
+                              LibFluid::ExternalForces3D>();
+
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> displacement(-0.2f * particle_size, 0.2f * particle_size);
+        std::uniform_real_distribution<float> velocity(-1.0f, 1.0f);
+
+        struct Particle
+        {
+            glm::vec3 position;
+            glm::vec3 velocity;
+            LibFluid::ParticleType type;
+        };
+        std::vector<Particle> particles;
+        for (int x = -1; x <= size; x++)
+            for (int z = -1; z <= size; z++)
+                for (int y = -2; y < 0; y++)
+                    particles.push_back({glm::vec3(x, y, z) * particle_size, glm::vec3(0.0f),
+                                         LibFluid::ParticleTypeBoundary});
+        for (int x = 0; x < size; x++)
+            for (int z = 0; z < size; z++)
+                for (int y = 0; y < size; y++)
+                    particles.push_back({glm::vec3(x, y, z) * particle_size +
+                                             glm::vec3(displacement(generator), displacement(generator),
+                                                       displacement(generator)),
+                                         glm::vec3(velocity(generator), velocity(generator), velocity(generator)),
+                                         LibFluid::ParticleTypeNormal});
+
+        std::shuffle(particles.begin(), particles.end(), generator);
+        for (const auto& particle : particles)
+            add_particle(*collection, particle.position, particle.velocity, particle.type);
+        return collection;
+    }
+
+    /**
+     * Creates a block of size^3 fluid particles at rest, sampled with the particle size, inside of a box of two layers
+     * of boundary particles, which is open at the top.
+     */
+    std::shared_ptr<LibFluid::ParticleCollection> create_hydrostatic_block(int size)
+    {
+        auto collection = std::make_shared<LibFluid::ParticleCollection>();
+        collection->add_types<LibFluid::MovementData3D, LibFluid::ParticleData, LibFluid::ParticleInfo,
+                              LibFluid::ExternalForces3D>();
+
+        for (int x = -2; x < size + 2; x++)
+            for (int z = -2; z < size + 2; z++)
+                for (int y = -2; y < size + 2; y++)
+                {
+                    bool inside = x >= 0 && x < size && z >= 0 && z < size && y >= 0;
+                    if (!inside)
+                        add_particle(*collection, glm::vec3(x, y, z) * particle_size, glm::vec3(0.0f),
+                                     LibFluid::ParticleTypeBoundary);
+                    else if (y < size)
+                        add_particle(*collection, glm::vec3(x, y, z) * particle_size, glm::vec3(0.0f),
+                                     LibFluid::ParticleTypeNormal);
+                }
+        return collection;
+    }
+
+    template <typename Solver>
+    std::shared_ptr<Solver> create_solver(const std::shared_ptr<LibFluid::ParticleCollection>& collection)
+    {
+        auto timestep_generator = std::make_shared<LibFluid::ConstantTimestepGenerator>();
+        timestep_generator->settings.timestep = 0.001f;
+        timestep_generator->parameters.particle_collection = collection;
+        timestep_generator->parameters.particle_size = particle_size;
+
+        auto solver = std::make_shared<Solver>();
+        solver->data.collection = collection;
+        solver->data.timestep_generator = timestep_generator;
+        solver->parameters.particle_size = particle_size;
+        solver->parameters.rest_density = rest_density;
+        return solver;
+    }
+
+    // executes a single simulation step and returns the accelerations of the particles ordered by their tag
+    template <typename Solver> std::vector<glm::vec3> compute_accelerations(Solver& solver)
+    {
+        LibFluid::Timepoint timepoint;
+        timepoint.desired_time_step = 0.001f;
+        solver.execute_neighborhood_search();
+        solver.execute_simulation_step(timepoint);
+
+        LibFluid::ParticleCollection& collection = *solver.data.collection;
+        std::vector<glm::vec3> accelerations(collection.size());
+        for (size_t i = 0; i < collection.size(); i++)
+            accelerations[collection.get<LibFluid::ParticleInfo>(i).tag] =
+                collection.get<LibFluid::MovementData3D>(i).acceleration;
+        return accelerations;
+    }
+
+    // executes a single simulation step and returns the velocity and density of the particles ordered by their tag
+    template <typename Solver> std::vector<glm::vec4> compute_velocities_and_densities(Solver& solver)
+    {
+        LibFluid::Timepoint timepoint;
+        timepoint.desired_time_step = 0.001f;
+        solver.execute_neighborhood_search();
+        solver.execute_simulation_step(timepoint);
+
+        LibFluid::ParticleCollection& collection = *solver.data.collection;
+        std::vector<glm::vec4> values(collection.size());
+        for (size_t i = 0; i < collection.size(); i++)
+            values[collection.get<LibFluid::ParticleInfo>(i).tag] =
+                glm::vec4(collection.get<LibFluid::MovementData3D>(i).velocity,
+                          collection.get<LibFluid::ParticleData>(i).density);
+        return values;
+    }
+
+    // executes a step with and without the structure of arrays movement columns, which has to yield the same
+    // velocities and densities
+    template <typename Solver, typename Configure> void expect_movement_columns_match_movement_data(Configure configure)
+    {
+        auto movement_data_solver = create_solver<Solver>(create_random_block(6, 5));
+        configure(*movement_data_solver);
+        auto expected = compute_velocities_and_densities(*movement_data_solver);
+
+        auto collection = create_random_block(6, 5);
+        ASSERT_FALSE(LibFluid::MovementColumns3D::are_columns_present(*collection));
+        LibFluid::MovementColumns3D::add_columns(*collection);
+        ASSERT_TRUE(LibFluid::MovementColumns3D::are_columns_present(*collection));
+        auto columns_solver = create_solver<Solver>(collection);
+        configure(*columns_solver);
+        auto actual = compute_velocities_and_densities(*columns_solver);
+
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t tag = 0; tag < expected.size(); tag++)
+        {
+            EXPECT_NEAR(actual[tag].x, expected[tag].x, 1e-5f) << "tag " << tag;
+            EXPECT_NEAR(actual[tag].y, expected[tag].y, 1e-5f) << "tag " << tag;
+            EXPECT_NEAR(actual[tag].z, expected[tag].z, 1e-5f) << "tag " << tag;
+            EXPECT_NEAR(actual[tag].w, expected[tag].w, 1e-3f) << "tag " << tag;
+        }
+    }
+
+    struct ParticleSnapshot
+    {
+        glm::vec3 position;
+        float mass;
+        float pressure;
+        LibFluid::ParticleType type;
+    };
+
+    std::vector<ParticleSnapshot> take_snapshot(LibFluid::ParticleCollection& collection)
+    {
+        std::vector<ParticleSnapshot> snapshot(collection.size());
+        for (size_t i = 0; i < collection.size(); i++)
+            snapshot[i] = {collection.get<LibFluid::MovementData3D>(i).position,
+                           collection.get<LibFluid::ParticleData>(i).mass,
+                           collection.get<LibFluid::ParticleData>(i).pressure,
+                           (LibFluid::ParticleType)collection.get<LibFluid::ParticleInfo>(i).type};
+        return snapshot;
+    }
+
+    struct IISPHReference
+    {
+        std::vector<float> source_term;
+        std::vector<float> diagonal_element;
+        std::vector<float> pressure;
+        std::vector<glm::vec3> acceleration;
+    };
+
+    /**
+     * Repeats the pressure solve of the last step of the solver without cached kernel gradients, with a brute force
+     * neighborhood search and the per neighbor sums of the diagonal element. The densities and predicted velocities
+     * are taken from the solver, before contains the particles as they were before the step.
+     */
+    template <typename Solver>
+    IISPHReference compute_iisph_reference(Solver& solver, const std::vector<ParticleSnapshot>& before, float timestep,
+                                           size_t iterations)
+    {
+        LibFluid::ParticleCollection& collection = *solver.data.collection;
+        const auto& settings = solver.settings;
+        const float rest_density_squared = rest_density * rest_density;
+
+        LibFluid::CubicSplineKernel3D kernel;
+        kernel.kernel_support = particle_size * LibFluid::Math::kernel_support_factor;
+        kernel.initialize();
+
+        auto gradient = [&](size_t neighbor, size_t i) {
+            return kernel.GetKernelDerivativeReversedValue(before[neighbor].position, before[i].position);
+        };
+
+        std::vector<std::vector<size_t>> neighbors(before.size());
+        for (size_t i = 0; i < before.size(); i++)
+            for (size_t j = 0; j < before.size(); j++)
+                if (glm::length(before[i].position - before[j].position) <= kernel.kernel_support)
+                    neighbors[i].push_back(j);
+
+        IISPHReference reference;
+        reference.source_term.assign(before.size(), 0.0f);
+        reference.diagonal_element.assign(before.size(), 0.0f);
+        reference.pressure.assign(before.size(), 0.0f);
+        reference.acceleration.assign(before.size(), glm::vec3(0.0f));
+
+        for (size_t i = 0; i < before.size(); i++)
+        {
+            if (before[i].type != LibFluid::ParticleTypeNormal)
+                continue;
+
+            const auto& predicted_velocity = collection.get<LibFluid::IISPHParticleData3D>(i).predicted_velocity;
+            float boundary_factor = settings.single_layer_boundary ? 2.0f * settings.gamma : 2.0f;
+
+            float neighbor_contribution = 0.0f;
+            glm::vec3 inner_part_of_sum(0.0f);
+            for (size_t j : neighbors[i])
+            {
+                if (before[j].type == LibFluid::ParticleTypeNormal)
+                {
+                    const auto& neighbor_velocity = collection.get<LibFluid::IISPHParticleData3D>(j).predicted_velocity;
+                    neighbor_contribution +=
+                        before[j].mass * glm::dot(predicted_velocity - neighbor_velocity, gradient(j, i));
+                    inner_part_of_sum -= before[j].mass / rest_density_squared * gradient(j, i);
+                }
+                else
+                {
+                    neighbor_contribution += before[j].mass * glm::dot(predicted_velocity, gradient(j, i));
+                    inner_part_of_sum -= boundary_factor * before[j].mass / rest_density_squared * gradient(j, i);
+                }
+            }
+
+            float diagonal_element = 0.0f;
+            for (size_t j : neighbors[i])
+            {
+                diagonal_element += before[j].mass * glm::dot(inner_part_of_sum, gradient(j, i));
+                if (before[j].type == LibFluid::ParticleTypeNormal)
+                    diagonal_element += before[j].mass * glm::dot(before[i].mass / rest_density_squared * gradient(i, j),
+                                                                  gradient(j, i));
+            }
+
+            reference.source_term[i] = rest_density - collection.get<LibFluid::ParticleData>(i).density -
+                                       timestep * neighbor_contribution;
+            reference.diagonal_element[i] = diagonal_element * timestep * timestep;
+            reference.pressure[i] =
+                settings.warm_start_pressure ? before[i].pressure * settings.warm_start_pressure_factor : 0.0f;
+        }
+
+        for (size_t iteration = 0; iteration < iterations; iteration++)
+        {
+            for (size_t i = 0; i < before.size(); i++)
+            {
+                if (before[i].type != LibFluid::ParticleTypeNormal)
+                    continue;
+
+                float boundary_factor = settings.single_layer_boundary ? settings.gamma : 1.0f;
+                glm::vec3 acceleration(0.0f);
+                for (size_t j : neighbors[i])
+                {
+                    if (before[j].type == LibFluid::ParticleTypeNormal)
+                        acceleration -= before[j].mass *
+                                        (reference.pressure[i] + reference.pressure[j]) / rest_density_squared *
+                                        gradient(j, i);
+                    else
+                        acceleration -= boundary_factor * before[j].mass * 2.0f * reference.pressure[i] /
+                                        rest_density_squared * gradient(j, i);
+                }
+                reference.acceleration[i] = acceleration;
+            }
+
+            for (size_t i = 0; i < before.size(); i++)
+            {
+                if (before[i].type != LibFluid::ParticleTypeNormal)
+                    continue;
+
+                float ap = 0.0f;
+                for (size_t j : neighbors[i])
+                {
+                    if (before[j].type == LibFluid::ParticleTypeNormal)
+                        ap += before[j].mass *
+                              glm::dot(reference.acceleration[i] - reference.acceleration[j], gradient(j, i));
+                    else
+                        ap += before[j].mass * glm::dot(reference.acceleration[i], gradient(j, i));
+                }
+                ap *= timestep * timestep;
+
+                float& pressure = reference.pressure[i];
+                float diagonal_element = reference.diagonal_element[i];
+                if (std::abs(diagonal_element) > std::numeric_limits<float>::epsilon())
+                    pressure = std::max(0.0f, pressure + settings.omega * (reference.source_term[i] - ap) /
+                                                             diagonal_element);
+                else
+                    pressure = 0.0f;
+            }
+        }
+        return reference;
+    }
+
+    // compares the values of the fluid particles relative to the largest absolute value
+    void expect_near_fluid_values(const std::vector<float>& actual, const std::vector<float>& expected,
+                                  const std::vector<ParticleSnapshot>& particles, const char* name)
+    {
+        float maximum = 0.0f;
+        for (float value : expected)
+            maximum = std::max(maximum, std::abs(value));
+        ASSERT_GT(maximum, 0.0f) << name;
+
+        for (size_t i = 0; i < particles.size(); i++)
+            if (particles[i].type == LibFluid::ParticleTypeNormal)
+                EXPECT_NEAR(actual[i], expected[i], 1e-3f * maximum) << name << " of particle " << i;
+    }
+
+    template <typename Solver>
+    void expect_iisph_matches_reference(Solver& solver, const std::vector<ParticleSnapshot>& before, float timestep,
+                                        size_t iterations)
+    {
+        auto reference = compute_iisph_reference(solver, before, timestep, iterations);
+
+        LibFluid::ParticleCollection& collection = *solver.data.collection;
+        std::vector<float> source_term(before.size()), diagonal_element(before.size()), pressure(before.size());
+        std::vector<float> acceleration_x(before.size()), acceleration_y(before.size()),
+            acceleration_z(before.size()), reference_x(before.size()), reference_y(before.size()),
+            reference_z(before.size());
+        for (size_t i = 0; i < before.size(); i++)
+        {
+            source_term[i] = collection.get<LibFluid::IISPHParticleData3D>(i).source_term;
+            diagonal_element[i] = collection.get<LibFluid::IISPHParticleData3D>(i).diagonal_element;
+            pressure[i] = collection.get<LibFluid::ParticleData>(i).pressure;
+            const auto& acceleration = collection.get<LibFluid::MovementData3D>(i).acceleration;
+            acceleration_x[i] = acceleration.x;
+            acceleration_y[i] = acceleration.y;
+            acceleration_z[i] = acceleration.z;
+            reference_x[i] = reference.acceleration[i].x;
+            reference_y[i] = reference.acceleration[i].y;
+            reference_z[i] = reference.acceleration[i].z;
+        }
+
+        expect_near_fluid_values(source_term, reference.source_term, before, "source term");
+        expect_near_fluid_values(diagonal_element, reference.diagonal_element, before, "diagonal element");
+        expect_near_fluid_values(pressure, reference.pressure, before, "pressure");
+        expect_near_fluid_values(acceleration_x, reference_x, before, "acceleration x");
+        expect_near_fluid_values(acceleration_y, reference_y, before, "acceleration y");
+        expect_near_fluid_values(acceleration_z, reference_z, before, "acceleration z");
+    }
+} // namespace
+
+TEST(SESPHFluidSolver3D, PairwiseForcesMatchPerParticleForces)
+{
+    using Solver = LibFluid::SESPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::QuadraticNeighborhoodSearch3D>;
+
+    auto per_particle_solver = create_solver<Solver>(create_random_block(8, 42));
+    auto expected = compute_accelerations(*per_particle_solver);
+
+    auto collection = create_random_block(8, 42);
+    auto pairwise_solver = create_solver<Solver>(collection);
+    pairwise_solver->settings.pairwise_force_computation = true;
+    auto actual = compute_accelerations(*pairwise_solver);
+
+    float maximum_acceleration = 0.0f;
+    for (const auto& acceleration : expected)
+        maximum_acceleration = std::max(maximum_acceleration, glm::length(acceleration));
+    ASSERT_GT(maximum_acceleration, 0.0f);
+
+    // the contributions are summed up in a different order, hence only the rounding errors may differ
+    const float tolerance = 1e-4f * maximum_acceleration;
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t tag = 0; tag < expected.size(); tag++)
+    {
+        EXPECT_NEAR(actual[tag].x, expected[tag].x, tolerance) << "tag " << tag;
+        EXPECT_NEAR(actual[tag].y, expected[tag].y, tolerance) << "tag " << tag;
+        EXPECT_NEAR(actual[tag].z, expected[tag].z, tolerance) << "tag " << tag;
+    }
+}
+
+TEST(SESPHFluidSolver3D, MovementColumnsMatchMovementData)
+{
+    using Solver = LibFluid::SESPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::QuadraticNeighborhoodSearch3D>;
+
+    for (bool vectorized : {false, true})
+        for (bool pairwise : {false, true})
+            expect_movement_columns_match_movement_data<Solver>([&](Solver& solver) {
+                solver.settings.vectorized_density_computation = vectorized;
+                solver.settings.pairwise_force_computation = pairwise;
+            });
+}
+
+TEST(IISPHFluidSolver3D, MovementColumnsMatchMovementData)
+{
+    using Solver = LibFluid::IISPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::QuadraticNeighborhoodSearch3D>;
+
+    for (bool vectorized : {false, true})
+        expect_movement_columns_match_movement_data<Solver>(
+            [&](Solver& solver) { solver.settings.vectorized_density_computation = vectorized; });
+}
+
+TEST(DFSPHFluidSolver3D, MovementColumnsMatchMovementData)
+{
+    using Solver = LibFluid::DFSPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::QuadraticNeighborhoodSearch3D>;
+
+    expect_movement_columns_match_movement_data<Solver>([](Solver&) {});
+}
+
+TEST(IISPHFluidSolver3D, CachedGradientsMatchUncachedPressureSolve)
+{
+    using Solver = LibFluid::IISPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::QuadraticNeighborhoodSearch3D>;
+
+    for (bool single_layer_boundary : {false, true})
+    {
+        // compress the block, such that the pressure solve produces positive pressures
+        auto collection = create_random_block(6, 7);
+        for (size_t i = 0; i < collection->size(); i++)
+            collection->get<LibFluid::MovementData3D>(i).position *= 0.85f;
+        auto solver = create_solver<Solver>(collection);
+        solver->settings.single_layer_boundary = single_layer_boundary;
+        // two iterations, such that the second one uses the pressure accelerations of the first pressures
+        solver->settings.min_number_of_iterations = 2;
+        solver->settings.max_number_of_iterations = 2;
+
+        // the diagonal elements scale with the squared timestep and have to stay above the epsilon of the solver
+        LibFluid::Timepoint timepoint;
+        timepoint.desired_time_step = 0.01f;
+        solver->execute_neighborhood_search();
+        auto before = take_snapshot(*collection);
+        solver->execute_simulation_step(timepoint);
+
+        ASSERT_EQ(solver->stat_last_iteration_count, 2);
+        expect_iisph_matches_reference(*solver, before, timepoint.desired_time_step, 2);
+    }
+}
+
+TEST(IISPHFluidSolver3D, WarmStartedPressureSolveStartsFromScaledPressures)
+{
+    using Solver = LibFluid::IISPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::QuadraticNeighborhoodSearch3D>;
+
+    auto collection = create_random_block(6, 11);
+    for (size_t i = 0; i < collection->size(); i++)
+        collection->get<LibFluid::MovementData3D>(i).position *= 0.85f;
+    auto solver = create_solver<Solver>(collection);
+    solver->settings.warm_start_pressure = true;
+    solver->settings.warm_start_pressure_factor = 0.3f;
+    solver->settings.min_number_of_iterations = 2;
+    solver->settings.max_number_of_iterations = 2;
+
+    // the first step produces the pressures the second step starts from
+    LibFluid::Timepoint timepoint;
+    timepoint.desired_time_step = 0.01f;
+    solver->execute_neighborhood_search();
+    solver->execute_simulation_step(timepoint);
+
+    timepoint.desired_time_step = 0.01f;
+    solver->execute_neighborhood_search();
+    auto before = take_snapshot(*collection);
+    ASSERT_TRUE(std::any_of(before.begin(), before.end(),
+                            [](const ParticleSnapshot& particle) { return particle.pressure > 0.0f; }));
+    solver->execute_simulation_step(timepoint);
+
+    expect_iisph_matches_reference(*solver, before, timepoint.desired_time_step, 2);
+}
+
+TEST(DFSPHFluidSolver3D, HydrostaticBlockStaysWithinErrorLimits)
+{
+    using Solver = LibFluid::DFSPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::HashedNeighborhoodSearch3D>;
+
+    const int size = 6;
+    auto collection = create_hydrostatic_block(size);
+    auto solver = create_solver<Solver>(collection);
+
+    for (size_t step = 0; step < 100; step++)
+    {
+        LibFluid::Timepoint timepoint;
+        timepoint.desired_time_step = 0.001f;
+        solver->execute_neighborhood_search();
+        solver->execute_simulation_step(timepoint);
+
+        // both solves have to converge before their maximum amount of iterations
+        ASSERT_LT(solver->stat_last_iteration_count, solver->settings.max_number_of_iterations) << "step " << step;
+        ASSERT_LE(solver->stat_last_average_predicted_density_error, solver->settings.max_density_error_allowed)
+            << "step " << step;
+        ASSERT_LT(solver->stat_last_divergence_iteration_count, solver->settings.max_number_of_divergence_iterations)
+            << "step " << step;
+        ASSERT_LE(solver->stat_last_average_divergence_error, solver->settings.max_divergence_error_allowed)
+            << "step " << step;
+    }
+
+    // the block rests inside of the box, the fluid particles stay in the box and are far slower than after falling
+    // down the height of the block
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        if (collection->get<LibFluid::ParticleInfo>(i).type != LibFluid::ParticleTypeNormal)
+            continue;
+        const auto& movement = collection->get<LibFluid::MovementData3D>(i);
+        EXPECT_LT(glm::length(movement.velocity), 1.0f);
+        EXPECT_GT(movement.position.x, -0.5f * particle_size);
+        EXPECT_LT(movement.position.x, (size - 0.5f) * particle_size);
+        EXPECT_GT(movement.position.y, -0.5f * particle_size);
+        EXPECT_GT(movement.position.z, -0.5f * particle_size);
+        EXPECT_LT(movement.position.z, (size - 0.5f) * particle_size);
+    }
+}
+
+template <typename T> class EmptyCollection3DTest : public ::testing::Test
+{
+};
+
+using VectorizedDensitySolvers =
+    ::testing::Types<LibFluid::SESPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::HashedNeighborhoodSearch3D>,
+                     LibFluid::IISPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::HashedNeighborhoodSearch3D>>;
+TYPED_TEST_SUITE(EmptyCollection3DTest, VectorizedDensitySolvers);
+
+TYPED_TEST(EmptyCollection3DTest, VectorizedDensitiesWithoutParticles)
+{
+    auto collection = std::make_shared<LibFluid::ParticleCollection>();
+    collection->add_types<LibFluid::MovementData3D, LibFluid::ParticleData, LibFluid::ParticleInfo,
+                          LibFluid::ExternalForces3D>();
+
+    auto solver = create_solver<TypeParam>(collection);
+    solver->settings.vectorized_density_computation = true;
+
+    LibFluid::Timepoint timepoint;
+    timepoint.desired_time_step = 0.001f;
+    solver->execute_neighborhood_search();
+    solver->execute_simulation_step(timepoint);
+    EXPECT_EQ(collection->size(), 0);
+}
@@ -0,0 +1,163 @@
+#include "fluidSolver/kernel/CubicSplineKernel.hpp"
+#include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
+#include "fluidSolver/kernel/Kernel.hpp"
+#include "fluidSolver/kernel/SelectableKernel3D.hpp"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    // integrates the kernel over its support with the midpoint rule
+    template <LibFluid::KernelType Type> float integrate_kernel_2d(float kernel_support)
+    {
+        auto kernel = LibFluid::Kernel<2, Type>();
+        kernel.kernel_support = kernel_support;
+        kernel.initialize();
+
+        const int steps = 400;
+        float step = 2.0f * kernel_support / (float)steps;
+        double sum = 0.0;
+        for (int x = 0; x < steps; x++)
+        {
+            for (int y = 0; y < steps; y++)
+            {
+                glm::vec2 position = glm::vec2(-kernel_support) + glm::vec2((float)x + 0.5f, (float)y + 0.5f) * step;
+                sum += kernel.GetKernelValue(position);
+            }
+        }
+        return (float)(sum * step * step);
+    }
+
+    template <LibFluid::KernelType Type> float integrate_kernel_3d(float kernel_support)
+    {
+        auto kernel = LibFluid::Kernel<3, Type>();
+        kernel.kernel_support = kernel_support;
+        kernel.initialize();
+
+        const int steps = 100;
+        float step = 2.0f * kernel_support / (float)steps;
+        double sum = 0.0;
+        for (int x = 0; x < steps; x++)
+        {
+            for (int y = 0; y < steps; y++)
+            {
+                for (int z = 0; z < steps; z++)
+                {
+                    glm::vec3 position = glm::vec3(-kernel_support) +
+                                         glm::vec3((float)x + 0.5f, (float)y + 0.5f, (float)z + 0.5f) * step;
+                    sum += kernel.GetKernelValue(position);
+                }
+            }
+        }
+        return (float)(sum * step * step * step);
+    }
+
+    template <LibFluid::KernelType Type> void check_compact_support_and_symmetry()
+    {
+        auto kernel = LibFluid::Kernel<3, Type>();
+        kernel.kernel_support = 1.5f;
+        kernel.initialize();
+
+        EXPECT_GT(kernel.GetKernelValue(glm::vec3(0.0f)), 0.0f);
+        EXPECT_FLOAT_EQ(kernel.GetKernelValue(glm::vec3(1.5f, 0.0f, 0.0f)), 0.0f);
+        EXPECT_FLOAT_EQ(kernel.GetKernelValue(glm::vec3(1.0f, 1.0f, 1.0f)), 0.0f);
+        EXPECT_EQ(kernel.GetKernelDerivativeValue(glm::vec3(0.0f, 2.0f, 0.0f)), glm::vec3(0.0f));
+        EXPECT_EQ(kernel.GetKernelDerivativeValue(glm::vec3(0.0f)), glm::vec3(0.0f));
+
+        for (float t = 0.0f; t <= 1.6f; t += 0.01f)
+        {
+            glm::vec3 position = glm::vec3(0.3f, -0.5f, 0.8f) * t;
+            EXPECT_GE(kernel.GetKernelValue(position), 0.0f);
+            EXPECT_FLOAT_EQ(kernel.GetKernelValue(position), kernel.GetKernelValue(-position));
+
+            glm::vec3 derivative = kernel.GetKernelDerivativeValue(position);
+            glm::vec3 reversed = kernel.GetKernelDerivativeValue(-position);
+            EXPECT_FLOAT_EQ(derivative.x, -reversed.x);
+            EXPECT_FLOAT_EQ(derivative.y, -reversed.y);
+            EXPECT_FLOAT_EQ(derivative.z, -reversed.z);
+        }
+    }
+} // namespace
+
+TEST(KernelTest, CubicSplineMatchesExistingKernels)
+{
+    for (float kernel_support : {0.2f, 1.0f, 2.5f})
+    {
+        auto reference_2d = LibFluid::CubicSplineKernel();
+        reference_2d.kernel_support = kernel_support;
+        reference_2d.initialize();
+
+        auto kernel_2d = LibFluid::Kernel<2, LibFluid::KernelType::CubicSpline>();
+        kernel_2d.kernel_support = kernel_support;
+        kernel_2d.initialize();
+
+        auto reference_3d = LibFluid::CubicSplineKernel3D();
+        reference_3d.kernel_support = kernel_support;
+        reference_3d.initialize();
+
+        auto kernel_3d = LibFluid::Kernel<3, LibFluid::KernelType::CubicSpline>();
+        kernel_3d.kernel_support = kernel_support;
+        kernel_3d.initialize();
+
+        float max_value_2d = reference_2d.GetKernelValue(glm::vec2(0.0f));
+        float max_value_3d = reference_3d.GetKernelValue(glm::vec3(0.0f));
+
+        for (float t = 0.001f; t <= 1.1f; t += 0.001f)
+        {
+            glm::vec2 position_2d = glm::vec2(0.6f, -0.8f) * t * kernel_support;
+            EXPECT_NEAR(kernel_2d.GetKernelValue(position_2d), reference_2d.GetKernelValue(position_2d),
+                        1e-5f * max_value_2d);
+            glm::vec2 difference_2d =
+                kernel_2d.GetKernelDerivativeValue(position_2d) - reference_2d.GetKernelDerivativeValue(position_2d);
+            EXPECT_LE(glm::length(difference_2d), 1e-4f * max_value_2d * kernel_support);
+
+            glm::vec3 position_3d = glm::vec3(0.48f, -0.64f, 0.6f) * t * kernel_support;
+            EXPECT_NEAR(kernel_3d.GetKernelValue(position_3d), reference_3d.GetKernelValue(position_3d),
+                        1e-5f * max_value_3d);
+            glm::vec3 difference_3d =
+                kernel_3d.GetKernelDerivativeValue(position_3d) - reference_3d.GetKernelDerivativeValue(position_3d);
+            EXPECT_LE(glm::length(difference_3d), 1e-4f * max_value_3d * kernel_support);
+        }
+    }
+}
+
+TEST(KernelTest, NormalizationTest)
+{
+    for (float kernel_support : {0.5f, 2.0f})
+    {
+        EXPECT_NEAR(integrate_kernel_2d<LibFluid::KernelType::CubicSpline>(kernel_support), 1.0f, 1e-3f);
+        EXPECT_NEAR(integrate_kernel_2d<LibFluid::KernelType::WendlandC2>(kernel_support), 1.0f, 1e-3f);
+        EXPECT_NEAR(integrate_kernel_2d<LibFluid::KernelType::WendlandC4>(kernel_support), 1.0f, 1e-3f);
+
+        EXPECT_NEAR(integrate_kernel_3d<LibFluid::KernelType::CubicSpline>(kernel_support), 1.0f, 5e-3f);
+        EXPECT_NEAR(integrate_kernel_3d<LibFluid::KernelType::WendlandC2>(kernel_support), 1.0f, 5e-3f);
+        EXPECT_NEAR(integrate_kernel_3d<LibFluid::KernelType::WendlandC4>(kernel_support), 1.0f, 5e-3f);
+    }
+}
+
+TEST(KernelTest, CompactSupportAndSymmetryTest)
+{
+    check_compact_support_and_symmetry<LibFluid::KernelType::CubicSpline>();
+    check_compact_support_and_symmetry<LibFluid::KernelType::WendlandC2>();
+    check_compact_support_and_symmetry<LibFluid::KernelType::WendlandC4>();
+}
+
+TEST(KernelTest, SelectableKernelMatchesSelectedType)
+{
+    auto selectable = LibFluid::SelectableKernel3D();
+    selectable.kernel_support = 1.0f;
+    selectable.initialize();
+
+    auto wendland = LibFluid::WendlandC4Kernel3D();
+    wendland.kernel_support = 1.0f;
+    wendland.initialize();
+
+    glm::vec3 position(0.2f, 0.1f, -0.3f);
+
+    selectable.type = LibFluid::KernelType::WendlandC4;
+    EXPECT_FLOAT_EQ(selectable.GetKernelValue(position), wendland.GetKernelValue(position));
+    EXPECT_EQ(selectable.GetKernelDerivativeValue(position), wendland.GetKernelDerivativeValue(position));
+
+    selectable.type = LibFluid::KernelType::CubicSpline;
+    EXPECT_NE(selectable.GetKernelValue(position), wendland.GetKernelValue(position));
+}
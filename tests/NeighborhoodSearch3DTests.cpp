@@ -0,0 +1,510 @@
+#include "fluidSolver/ParticleCollection.hpp"
+#include "fluidSolver/neighborhoodSearch/CompressedNeighbors.hpp"
+#include "fluidSolver/neighborhoodSearch/CsrNeighborhoodSearch3D.hpp"
+#include "fluidSolver/neighborhoodSearch/HashedNeighborhoodSearch3D.hpp"
+#include "fluidSolver/neighborhoodSearch/QuadraticNeighborhoodSearch3D.hpp"
+#include "fluidSolver/neighborhoodSearch/VerletNeighborhoodSearch.hpp"
+
+#include <algorithm>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using ::testing::UnorderedElementsAreArray;
+
+namespace
+{
+    std::shared_ptr<LibFluid::ParticleCollection> create_random_collection(size_t amount, float extent)
+    {
+        auto collection = std::make_shared<LibFluid::ParticleCollection>();
+        collection->add_types<LibFluid::MovementData3D, LibFluid::ParticleInfo>();
+
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> distribution(-extent, extent);
+
+        for (size_t i = 0; i < amount; i++)
+        {
+            auto index = collection->add();
+            collection->get<LibFluid::MovementData3D>(index).position =
+                glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+            collection->get<LibFluid::ParticleInfo>(index).tag = i;
+            collection->get<LibFluid::ParticleInfo>(index).type =
+                i % 10 == 0 ? LibFluid::ParticleTypeInactive : LibFluid::ParticleTypeNormal;
+        }
+        return collection;
+    }
+
+    template <typename Neighbors> std::vector<size_t> to_vector(const Neighbors& neighbors)
+    {
+        std::vector<size_t> result;
+        for (auto index : neighbors)
+        {
+            result.push_back(index);
+        }
+        return result;
+    }
+
+    // decodes the compressed neighbors at once, which has to yield the same indices in the same order as iterating
+    std::vector<size_t> decode_to_vector(const LibFluid::CompressedNeighborhoodSearch::Neighbors& neighbors)
+    {
+        uint32_t decoded[LibFluid::CompressedNeighborhoodSearch::Neighbors::max_size];
+        size_t count = neighbors.decode_into(decoded);
+        return std::vector<size_t>(decoded, decoded + count);
+    }
+
+    template <typename Neighbors>
+    std::vector<size_t> to_vector_within_radius(const Neighbors& neighbors, LibFluid::ParticleCollection& collection,
+                                                size_t particle, float radius)
+    {
+        std::vector<size_t> result;
+        const glm::vec3& position = collection.get<LibFluid::MovementData3D>(particle).position;
+        for (auto index : neighbors)
+        {
+            glm::vec3 difference = position - collection.get<LibFluid::MovementData3D>(index).position;
+            if (glm::dot(difference, difference) <= radius * radius)
+                result.push_back(index);
+        }
+        return result;
+    }
+} // namespace
+
+template <typename T> class NeighborhoodSearch3DTest : public ::testing::Test {
+};
+
+using NeighborhoodSearch3DTypes =
+    ::testing::Types<LibFluid::CsrNeighborhoodSearch3D, LibFluid::HashedNeighborhoodSearch3D>;
+TYPED_TEST_SUITE(NeighborhoodSearch3DTest, NeighborhoodSearch3DTypes);
+
+TYPED_TEST(NeighborhoodSearch3DTest, MatchesQuadraticNeighborhoodSearch)
+{
+    auto collection = create_random_collection(2000, 3.0f);
+
+    TypeParam search;
+    search.collection = collection;
+    search.search_radius = 0.7f;
+    search.initialize();
+    search.find_neighbors();
+
+    LibFluid::QuadraticNeighborhoodSearch3D quadratic;
+    quadratic.collection = collection;
+    quadratic.search_radius = 0.7f;
+    quadratic.initialize();
+    quadratic.find_neighbors();
+
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        auto search_neighbors = to_vector(search.get_neighbors(i));
+        if (collection->get<LibFluid::ParticleInfo>(i).type == LibFluid::ParticleTypeInactive)
+        {
+            EXPECT_TRUE(search_neighbors.empty());
+            continue;
+        }
+
+        EXPECT_THAT(search_neighbors, UnorderedElementsAreArray(to_vector(quadratic.get_neighbors(i))));
+    }
+
+    // position based queries, the quadratic search does not skip inactive particles for those
+    for (glm::vec3 position : {glm::vec3(0.0f), glm::vec3(-2.9f, 1.3f, 0.05f), glm::vec3(10.0f)})
+    {
+        std::vector<size_t> expected;
+        for (auto index : to_vector(quadratic.get_neighbors(position)))
+        {
+            if (collection->get<LibFluid::ParticleInfo>(index).type != LibFluid::ParticleTypeInactive)
+                expected.push_back(index);
+        }
+        EXPECT_THAT(to_vector(search.get_neighbors(position)), UnorderedElementsAreArray(expected));
+    }
+}
+
+TYPED_TEST(NeighborhoodSearch3DTest, MatchesQuadraticNeighborhoodSearchAfterMovement)
+{
+    auto collection = create_random_collection(500, 2.0f);
+
+    TypeParam search;
+    search.collection = collection;
+    search.search_radius = 0.5f;
+    search.initialize();
+    search.find_neighbors();
+
+    // move every particle and search again
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        collection->get<LibFluid::MovementData3D>(i).position *= 0.5f;
+    }
+    search.find_neighbors();
+
+    LibFluid::QuadraticNeighborhoodSearch3D quadratic;
+    quadratic.collection = collection;
+    quadratic.search_radius = 0.5f;
+    quadratic.initialize();
+    quadratic.find_neighbors();
+
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        if (collection->get<LibFluid::ParticleInfo>(i).type == LibFluid::ParticleTypeInactive)
+            continue;
+        EXPECT_THAT(to_vector(search.get_neighbors(i)), UnorderedElementsAreArray(to_vector(quadratic.get_neighbors(i))));
+    }
+}
+
+TYPED_TEST(NeighborhoodSearch3DTest, NeighborsFollowParticlesAfterReorder)
+{
+    auto collection = create_random_collection(500, 2.0f);
+
+    TypeParam search;
+    search.collection = collection;
+    search.search_radius = 0.5f;
+    search.initialize();
+    search.find_neighbors();
+
+    // the neighbors of each particle by their tag, these do not depend on the order of the particles
+    auto neighbor_tags = [&]() {
+        std::vector<std::vector<size_t>> result(collection->size());
+        for (size_t i = 0; i < collection->size(); i++)
+        {
+            if (collection->get<LibFluid::ParticleInfo>(i).type == LibFluid::ParticleTypeInactive)
+                continue;
+            auto& tags = result[collection->get<LibFluid::ParticleInfo>(i).tag];
+            for (auto neighbor : search.get_neighbors(i))
+                tags.push_back(collection->get<LibFluid::ParticleInfo>(neighbor).tag);
+            std::sort(tags.begin(), tags.end());
+        }
+        return result;
+    };
+    auto expected = neighbor_tags();
+
+    // shuffle the particles and search again without moving them
+    std::vector<uint32_t> permutation(collection->size());
+    for (size_t i = 0; i < permutation.size(); i++)
+        permutation[i] = i;
+    std::shuffle(permutation.begin(), permutation.end(), std::mt19937(7));
+    collection->reorder(permutation);
+    search.find_neighbors();
+
+    EXPECT_EQ(neighbor_tags(), expected);
+
+    LibFluid::QuadraticNeighborhoodSearch3D quadratic;
+    quadratic.collection = collection;
+    quadratic.search_radius = 0.5f;
+    quadratic.initialize();
+    quadratic.find_neighbors();
+
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        if (collection->get<LibFluid::ParticleInfo>(i).type == LibFluid::ParticleTypeInactive)
+            continue;
+        EXPECT_THAT(to_vector(search.get_neighbors(i)), UnorderedElementsAreArray(to_vector(quadratic.get_neighbors(i))));
+    }
+}
+
+TYPED_TEST(NeighborhoodSearch3DTest, MatchesQuadraticNeighborhoodSearchWithStaticBoundary)
+{
+    auto collection = create_random_collection(1000, 2.0f);
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        if (i % 3 == 0)
+            collection->get<LibFluid::ParticleInfo>(i).type = LibFluid::ParticleTypeBoundary;
+    }
+
+    TypeParam search;
+    search.collection = collection;
+    search.search_radius = 0.5f;
+    search.initialize();
+
+    LibFluid::QuadraticNeighborhoodSearch3D quadratic;
+    quadratic.collection = collection;
+    quadratic.search_radius = 0.5f;
+    quadratic.initialize();
+
+    auto expect_matching_neighbors = [&]() {
+        search.find_neighbors();
+        quadratic.find_neighbors();
+        for (size_t i = 0; i < collection->size(); i++)
+        {
+            EXPECT_THAT(to_vector(search.get_neighbors(i)),
+                        UnorderedElementsAreArray(to_vector(quadratic.get_neighbors(i))));
+        }
+    };
+
+    expect_matching_neighbors();
+
+    // only the fluid particles move
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        if (collection->get<LibFluid::ParticleInfo>(i).type == LibFluid::ParticleTypeNormal)
+            collection->get<LibFluid::MovementData3D>(i).position *= 0.8f;
+    }
+    expect_matching_neighbors();
+
+    // a boundary particle moves and a fluid particle becomes a boundary particle
+    collection->get<LibFluid::MovementData3D>(3).position = glm::vec3(0.1f, 0.2f, 0.3f);
+    collection->get<LibFluid::ParticleInfo>(4).type = LibFluid::ParticleTypeBoundary;
+    expect_matching_neighbors();
+}
+
+TYPED_TEST(NeighborhoodSearch3DTest, InterfaceBatchQueriesMatchNeighbors)
+{
+    auto collection = create_random_collection(1000, 2.0f);
+
+    TypeParam search;
+    search.collection = collection;
+    search.search_radius = 0.6f;
+    search.initialize();
+    search.find_neighbors();
+
+    auto interface = search.create_interface();
+
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        std::vector<size_t> neighbors;
+        interface->for_each_neighbor(i, [&](size_t neighbor) { neighbors.push_back(neighbor); });
+        EXPECT_EQ(neighbors, to_vector(search.get_neighbors(i)));
+    }
+
+    std::vector<glm::vec3> positions = {glm::vec3(0.0f), glm::vec3(-1.9f, 1.3f, 0.05f), glm::vec3(10.0f),
+                                        glm::vec3(0.5f, -0.25f, 1.0f)};
+    std::vector<size_t> offsets = {42};
+    std::vector<size_t> indices = {42};
+    interface->gather_neighbors(positions.data(), positions.size(), offsets, indices);
+
+    ASSERT_EQ(offsets.size(), positions.size() + 1);
+    ASSERT_EQ(offsets.front(), 0);
+    ASSERT_EQ(offsets.back(), indices.size());
+    for (size_t p = 0; p < positions.size(); p++)
+    {
+        std::vector<size_t> neighbors;
+        interface->for_each_neighbor(positions[p], [&](size_t neighbor) { neighbors.push_back(neighbor); });
+        EXPECT_THAT(neighbors, UnorderedElementsAreArray(to_vector(search.get_neighbors(positions[p]))));
+
+        std::vector<size_t> gathered(indices.begin() + offsets[p], indices.begin() + offsets[p + 1]);
+        EXPECT_EQ(gathered, neighbors);
+    }
+}
+
+TYPED_TEST(NeighborhoodSearch3DTest, InterfaceStopsWhenCallbackReturnsFalse)
+{
+    auto collection = create_random_collection(1000, 2.0f);
+
+    TypeParam search;
+    search.collection = collection;
+    search.search_radius = 0.6f;
+    search.initialize();
+    search.find_neighbors();
+
+    auto interface = search.create_interface();
+
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        size_t calls = 0;
+        interface->for_each_neighbor(i, [&](size_t) {
+            calls++;
+            return calls < 2;
+        });
+        EXPECT_EQ(calls, std::min<size_t>(2, to_vector(search.get_neighbors(i)).size()));
+    }
+
+    glm::vec3 position(0.5f, -0.25f, 1.0f);
+    ASSERT_GT(to_vector(search.get_neighbors(position)).size(), 2);
+    size_t calls = 0;
+    interface->for_each_neighbor(position, [&](size_t) {
+        calls++;
+        return calls < 2;
+    });
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(VerletNeighborhoodSearch, ReusesListsUntilParticlesMovedHalfTheSkin)
+{
+    auto collection = create_random_collection(1000, 2.0f);
+    const float radius = 0.5f;
+
+    LibFluid::VerletNeighborhoodSearch<LibFluid::HashedNeighborhoodSearch3D> search;
+    search.collection = collection;
+    search.search_radius = radius;
+    search.skin_factor = 0.2f;
+    search.initialize();
+
+    LibFluid::QuadraticNeighborhoodSearch3D quadratic;
+    quadratic.collection = collection;
+    quadratic.search_radius = radius;
+    quadratic.initialize();
+
+    auto expect_same_neighbors_within_radius = [&]() {
+        quadratic.find_neighbors();
+        for (size_t i = 0; i < collection->size(); i++)
+        {
+            if (collection->get<LibFluid::ParticleInfo>(i).type == LibFluid::ParticleTypeInactive)
+                continue;
+            EXPECT_THAT(to_vector_within_radius(search.get_neighbors(i), *collection, i, radius),
+                        UnorderedElementsAreArray(to_vector(quadratic.get_neighbors(i))));
+        }
+    };
+
+    search.find_neighbors();
+    EXPECT_TRUE(search.were_lists_rebuilt_in_last_search());
+    expect_same_neighbors_within_radius();
+
+    // the lists are kept, as long as no particle moved more than half the skin
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        collection->get<LibFluid::MovementData3D>(i).position.x += i % 2 == 0 ? 0.04f : -0.04f;
+    }
+    search.find_neighbors();
+    EXPECT_FALSE(search.were_lists_rebuilt_in_last_search());
+    expect_same_neighbors_within_radius();
+
+    // moving a single particle further forces a rebuild
+    collection->get<LibFluid::MovementData3D>(1).position.y += 0.1f;
+    search.find_neighbors();
+    EXPECT_TRUE(search.were_lists_rebuilt_in_last_search());
+    expect_same_neighbors_within_radius();
+
+    // deactivating a particle forces a rebuild
+    collection->get<LibFluid::ParticleInfo>(1).type = LibFluid::ParticleTypeInactive;
+    search.find_neighbors();
+    EXPECT_TRUE(search.were_lists_rebuilt_in_last_search());
+}
+
+TEST(VerletNeighborhoodSearch, PositionAndInterfaceQueriesUseCurrentPositions)
+{
+    auto collection = create_random_collection(1000, 2.0f);
+    const float radius = 0.5f;
+
+    LibFluid::VerletNeighborhoodSearch<LibFluid::HashedNeighborhoodSearch3D> search;
+    search.collection = collection;
+    search.search_radius = radius;
+    search.skin_factor = 0.2f;
+    search.initialize();
+    search.find_neighbors();
+
+    // the particles move less than half the skin, hence the lists built at the old positions are kept
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        collection->get<LibFluid::MovementData3D>(i).position.x += i % 2 == 0 ? 0.04f : -0.04f;
+    }
+    search.find_neighbors();
+    ASSERT_FALSE(search.were_lists_rebuilt_in_last_search());
+
+    LibFluid::QuadraticNeighborhoodSearch3D quadratic;
+    quadratic.collection = collection;
+    quadratic.search_radius = radius;
+    quadratic.initialize();
+    quadratic.find_neighbors();
+
+    auto interface = search.create_interface();
+    EXPECT_FLOAT_EQ(interface->get_search_radius(), radius);
+
+    // the iterators of the interface are not const
+    auto interface_vector = [](LibFluid::NeighborhoodInterface::Neighbors neighbors) {
+        std::vector<size_t> result;
+        for (auto index : neighbors)
+            result.push_back(index);
+        return result;
+    };
+
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        if (collection->get<LibFluid::ParticleInfo>(i).type == LibFluid::ParticleTypeInactive)
+            continue;
+        auto expected = to_vector(quadratic.get_neighbors(i));
+
+        EXPECT_THAT(interface_vector(interface->get_neighbors(i)), UnorderedElementsAreArray(expected));
+
+        std::vector<size_t> visited;
+        interface->for_each_neighbor(i, [&](size_t neighbor) { visited.push_back(neighbor); });
+        EXPECT_THAT(visited, UnorderedElementsAreArray(expected));
+    }
+
+    std::vector<glm::vec3> positions = {glm::vec3(0.0f), glm::vec3(-1.9f, 1.3f, 0.05f), glm::vec3(0.7f, 0.2f, -1.1f)};
+    std::vector<size_t> offsets;
+    std::vector<size_t> indices;
+    interface->gather_neighbors(positions.data(), positions.size(), offsets, indices);
+    for (size_t p = 0; p < positions.size(); p++)
+    {
+        std::vector<size_t> expected;
+        for (auto index : to_vector(quadratic.get_neighbors(positions[p])))
+        {
+            if (collection->get<LibFluid::ParticleInfo>(index).type != LibFluid::ParticleTypeInactive)
+                expected.push_back(index);
+        }
+        ASSERT_FALSE(expected.empty());
+
+        EXPECT_THAT(search.get_neighbors(positions[p]), UnorderedElementsAreArray(expected));
+        EXPECT_THAT(interface_vector(interface->get_neighbors(positions[p])), UnorderedElementsAreArray(expected));
+
+        std::vector<size_t> visited;
+        interface->for_each_neighbor(positions[p], [&](size_t neighbor) { visited.push_back(neighbor); });
+        EXPECT_THAT(visited, UnorderedElementsAreArray(expected));
+
+        std::vector<size_t> gathered(indices.begin() + offsets[p], indices.begin() + offsets[p + 1]);
+        EXPECT_THAT(gathered, UnorderedElementsAreArray(expected));
+    }
+}
+
+TEST(CompressedNeighborhoodSearch, MatchesQuadraticNeighborhoodSearchWhenSortedIncrementally)
+{
+    auto collection = create_random_collection(1000, 2.0f);
+    const float radius = 0.5f;
+
+    LibFluid::CompressedNeighborhoodSearch search;
+    search.collection = collection;
+    search.search_radius = radius;
+    search.initialize();
+
+    LibFluid::QuadraticNeighborhoodSearch3D quadratic;
+    quadratic.collection = collection;
+    quadratic.search_radius = radius;
+    quadratic.initialize();
+
+    // the compressed search reorders the particles, hence the quadratic search runs afterwards
+    auto expect_same_neighbors = [&]() {
+        search.find_neighbors();
+        quadratic.find_neighbors();
+        for (size_t i = 0; i < collection->size(); i++)
+        {
+            if (collection->get<LibFluid::ParticleInfo>(i).type == LibFluid::ParticleTypeInactive)
+                continue;
+            EXPECT_THAT(to_vector(search.get_neighbors(i)),
+                        UnorderedElementsAreArray(to_vector(quadratic.get_neighbors(i))));
+            EXPECT_EQ(decode_to_vector(search.get_neighbors(i)), to_vector(search.get_neighbors(i)));
+        }
+
+        for (glm::vec3 position : {glm::vec3(0.0f), glm::vec3(-1.9f, 1.3f, 0.05f), glm::vec3(10.0f)})
+        {
+            std::vector<size_t> expected;
+            for (auto index : to_vector(quadratic.get_neighbors(position)))
+            {
+                if (collection->get<LibFluid::ParticleInfo>(index).type != LibFluid::ParticleTypeInactive)
+                    expected.push_back(index);
+            }
+            EXPECT_THAT(to_vector(search.get_neighbors(position)), UnorderedElementsAreArray(expected));
+            EXPECT_EQ(decode_to_vector(search.get_neighbors(position)), to_vector(search.get_neighbors(position)));
+        }
+    };
+
+    expect_same_neighbors();
+
+    // no particle changes its cell
+    expect_same_neighbors();
+
+    // few particles change their cell, which is handled incrementally
+    for (size_t i = 0; i < collection->size(); i += 40)
+    {
+        collection->get<LibFluid::MovementData3D>(i).position += glm::vec3(0.6f, -0.3f, 0.0f);
+    }
+    collection->get<LibFluid::ParticleInfo>(5).type = LibFluid::ParticleTypeInactive;
+    expect_same_neighbors();
+
+    // another party reordering the particles without changing their cells
+    collection->swap(0, collection->size() / 2);
+    expect_same_neighbors();
+
+    // most particles change their cell
+    for (size_t i = 0; i < collection->size(); i++)
+    {
+        collection->get<LibFluid::MovementData3D>(i).position *= 0.8f;
+    }
+    expect_same_neighbors();
+}
@@ -1,4 +1,5 @@
 #include "fluidSolver/ParticleCollection.hpp"
+#include "fluidSolver/neighborhoodSearch/CompactGridNeighborhoodSearch.hpp"
 #include "fluidSolver/neighborhoodSearch/HashedNeighborhoodSearch.hpp"
 #include "fluidSolver/neighborhoodSearch/QuadraticNeighborhoodSearchDynamicAllocated.hpp"
 
@@ -6,6 +7,7 @@
 #include <glm/gtx/matrix_transform_2d.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <limits>
 #include <memory>
 
 using ::testing::UnorderedElementsAre;
@@ -361,6 +363,55 @@ REGISTER_TYPED_TEST_SUITE_P(NeighborhoodSearchTest, ShouldWorkForSingleParticle,
 
 // placeholder for test bodies
 typedef ::testing::Types<LibFluid::QuadraticNeighborhoodSearchDynamicAllocated,
-        LibFluid::HashedNeighborhoodSearch>
+        LibFluid::HashedNeighborhoodSearch, LibFluid::CompactGridNeighborhoodSearch>
     NeighborhoodSearchTypes;
-INSTANTIATE_TYPED_TEST_SUITE_P(NeighborhoodSearchTypesInstantiation, NeighborhoodSearchTest, NeighborhoodSearchTypes);
\ No newline at end of file
+INSTANTIATE_TYPED_TEST_SUITE_P(NeighborhoodSearchTypesInstantiation, NeighborhoodSearchTest, NeighborhoodSearchTypes);
+
+TEST(CompactGridNeighborhoodSearch, OutlierParticleEnlargesCells)
+{
+    auto particleCollection = std::make_shared<LibFluid::ParticleCollection>();
+    setup_collection(*particleCollection);
+    const float radius = 2.0f;
+
+    // the outlier spans a grid of millions of cells of the size of the search radius, hence the cells are enlarged
+    add_positions(*particleCollection, GetSampleGrid(-5, 1, 5));
+    add_positions(*particleCollection, {glm::vec2(1.0e7f, -3.0e7f)});
+    size_t outlier = particleCollection->size() - 1;
+
+    LibFluid::CompactGridNeighborhoodSearch search;
+    search.search_radius = radius;
+    search.collection = particleCollection;
+    search.initialize();
+
+    search.find_neighbors();
+
+    EXPECT_THAT(search.get_neighbors(0), UnorderedElementsAre(0, 1, 2, 11, 12, 22));
+    EXPECT_THAT(search.get_neighbors(38),
+                UnorderedElementsAre(16, 26, 27, 28, 36, 37, 38, 39, 40, 48, 49, 50, 60));
+    EXPECT_THAT(search.get_neighbors(outlier), UnorderedElementsAre(outlier));
+    EXPECT_THAT(search.get_neighbors(glm::vec2(-5.0f, -5.0f)), UnorderedElementsAre(0, 1, 2, 11, 12, 22));
+}
+
+TEST(CompactGridNeighborhoodSearch, NonFiniteParticlesAreIgnored)
+{
+    auto particleCollection = std::make_shared<LibFluid::ParticleCollection>();
+    setup_collection(*particleCollection);
+    const float radius = 2.0f;
+
+    add_positions(*particleCollection, GetSampleGrid(-5, 1, 5));
+    add_positions(*particleCollection, {glm::vec2(std::numeric_limits<float>::quiet_NaN(), 0.0f),
+                                        glm::vec2(0.0f, std::numeric_limits<float>::infinity()),
+                                        glm::vec2(-std::numeric_limits<float>::infinity())});
+
+    LibFluid::CompactGridNeighborhoodSearch search;
+    search.search_radius = radius;
+    search.collection = particleCollection;
+    search.initialize();
+
+    // the grid still spans the finite particles only, which find their neighbors as usual
+    search.find_neighbors();
+
+    EXPECT_THAT(search.get_neighbors(0), UnorderedElementsAre(0, 1, 2, 11, 12, 22));
+    EXPECT_THAT(search.get_neighbors(38),
+                UnorderedElementsAre(16, 26, 27, 28, 36, 37, 38, 39, 40, 48, 49, 50, 60));
+}
@@ -0,0 +1,124 @@
+#include "parallelization/NoParallelization.hpp"
+#include "parallelization/StdParallelForEach.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+using namespace LibFluid;
+
+template<typename T>
+class ParallelizationTests : public ::testing::Test {
+};
+
+using ParallelizationTypes = ::testing::Types<NoParallelization, StdParallelForEach>;
+TYPED_TEST_SUITE(ParallelizationTests, ParallelizationTypes);
+
+
+TYPED_TEST(ParallelizationTests, LoopForVisitsEachIndexOnce) {
+    const size_t from = 13;
+    const size_t to = 100003;
+
+    std::vector<std::atomic<int>> visits(to);
+    TypeParam::loop_for(from, to, [&](size_t i) { visits[i]++; });
+
+    for (size_t i = 0; i < to; i++) {
+        ASSERT_EQ(visits[i].load(), i < from ? 0 : 1) << "at index " << i;
+    }
+}
+
+TYPED_TEST(ParallelizationTests, LoopForWithStep) {
+    std::vector<std::atomic<int>> visits(1000);
+    TypeParam::loop_for(3, 1000, 7, [&](size_t i) { visits[i]++; });
+
+    for (size_t i = 0; i < visits.size(); i++) {
+        ASSERT_EQ(visits[i].load(), i >= 3 && (i - 3) % 7 == 0 ? 1 : 0) << "at index " << i;
+    }
+}
+
+TYPED_TEST(ParallelizationTests, LoopForRangeWithGrainCoversEachIndexOnce) {
+    const size_t grain = 3;
+    std::vector<std::atomic<int>> visits(20);
+    std::atomic<size_t> range_count(0);
+    TypeParam::loop_for_range(2, 20, grain, [&](size_t begin, size_t end) {
+        range_count++;
+        for (size_t i = begin; i < end; i++) {
+            visits[i]++;
+        }
+    });
+
+    for (size_t i = 0; i < visits.size(); i++) {
+        ASSERT_EQ(visits[i].load(), i < 2 ? 0 : 1) << "at index " << i;
+    }
+    if (std::is_same<TypeParam, StdParallelForEach>::value) {
+        // the explicit grain splits the indices although there are less than minimum_grain_size of them
+        EXPECT_EQ(range_count.load(), 6);
+    }
+}
+
+TYPED_TEST(ParallelizationTests, ReduceSum) {
+    size_t sum = TypeParam::reduce(
+            1, 100001, size_t(0), [](size_t i) { return i; }, [](size_t a, size_t b) { return a + b; });
+    ASSERT_EQ(sum, size_t(100000) * 100001 / 2);
+}
+
+TYPED_TEST(ParallelizationTests, ReduceEmptyRangeReturnsIdentity) {
+    int result = TypeParam::reduce(
+            10, 10, 42, [](size_t) { return 0; }, [](int a, int b) { return a + b; });
+    ASSERT_EQ(result, 42);
+}
+
+TYPED_TEST(ParallelizationTests, ReduceBool) {
+    // the partial results of neighboring ranges must not share storage like the bits of std::vector<bool>
+    std::vector<uint8_t> flags(100000, 0);
+    flags[99999] = 1;
+
+    bool any = TypeParam::reduce(
+            0, flags.size(), false, [&](size_t i) { return flags[i] != 0; }, [](bool a, bool b) { return a || b; });
+    bool none = TypeParam::reduce(
+            0, flags.size(), true, [&](size_t i) { return flags[i] == 0; }, [](bool a, bool b) { return a && b; });
+    ASSERT_TRUE(any);
+    ASSERT_FALSE(none);
+}
+
+TYPED_TEST(ParallelizationTests, ReduceMinMax) {
+    std::vector<float> values(50000);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = (float)((i * 7919) % 50021) - 1000.0f;
+    }
+
+    float maximum = TypeParam::reduce(
+            0, values.size(), std::numeric_limits<float>::lowest(), [&](size_t i) { return values[i]; },
+            [](float a, float b) { return std::max(a, b); });
+    float minimum = TypeParam::reduce(
+            0, values.size(), std::numeric_limits<float>::max(), [&](size_t i) { return values[i]; },
+            [](float a, float b) { return std::min(a, b); });
+
+    ASSERT_EQ(maximum, *std::max_element(values.begin(), values.end()));
+    ASSERT_EQ(minimum, *std::min_element(values.begin(), values.end()));
+    ASSERT_EQ(TypeParam::loop_for_max(0, values.size(), [&](size_t i) { return values[i]; }), maximum);
+}
+
+TYPED_TEST(ParallelizationTests, ReduceArgmax) {
+    struct IndexedValue {
+        float value = std::numeric_limits<float>::lowest();
+        size_t index = 0;
+    };
+
+    std::vector<float> values(20000, 1.0f);
+    values[12345] = 5.0f;
+    values[17000] = 5.0f;
+
+    IndexedValue result = TypeParam::reduce(
+            0, values.size(), IndexedValue(), [&](size_t i) { return IndexedValue{values[i], i}; },
+            [](const IndexedValue& a, const IndexedValue& b) { return b.value > a.value ? b : a; });
+
+    // the first index of the maximum is reported, since ranges are combined in order
+    ASSERT_EQ(result.index, 12345);
+    ASSERT_EQ(result.value, 5.0f);
+}
@@ -0,0 +1,171 @@
+#include "fluidSolver/BoundaryChangeDetector.hpp"
+#include "fluidSolver/MovementColumns3D.hpp"
+#include "fluidSolver/ParticleTypeIndices.hpp"
+#include "parallelization/NoParallelization.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+
+TEST(ParticleCollection, ColumnsAreAligned)
+{
+    using namespace LibFluid;
+
+    ParticleCollection coll;
+    coll.add_type<ParticleInfo>();
+    MovementColumns3D::add_columns(coll);
+
+    for (size_t size : {1, 17, 1000, 4321})
+    {
+        coll.resize(size);
+        ASSERT_EQ((uintptr_t)coll.column<ParticleInfo>() % ParticleCollection::column_alignment, 0);
+        ASSERT_EQ((uintptr_t)coll.column<PositionColumn3D<0>>() % ParticleCollection::column_alignment, 0);
+        ASSERT_EQ((uintptr_t)coll.column<VelocityColumn3D<2>>() % ParticleCollection::column_alignment, 0);
+    }
+}
+
+TEST(ParticleCollection, ColumnsFollowSwapAndCopy)
+{
+    using namespace LibFluid;
+
+    ParticleCollection coll;
+    coll.add_type<MovementData3D>();
+    ASSERT_FALSE(MovementColumns3D::are_columns_present(coll));
+    MovementColumns3D::add_columns(coll);
+    ASSERT_TRUE(MovementColumns3D::are_columns_present(coll));
+
+    coll.resize(100);
+    for (size_t i = 0; i < coll.size(); i++)
+    {
+        coll.get<MovementData3D>(i).position = glm::vec3(i, 2.0f * i, 3.0f * i);
+        coll.get<MovementData3D>(i).velocity = glm::vec3(-1.0f * i, -2.0f * i, -3.0f * i);
+    }
+
+    auto columns = MovementColumns3D::update<NoParallelization>(coll);
+    for (size_t i = 0; i < coll.size(); i++)
+    {
+        ASSERT_EQ(columns.position(i), coll.get<MovementData3D>(i).position);
+        ASSERT_EQ(columns.velocity(i), coll.get<MovementData3D>(i).velocity);
+    }
+
+    coll.swap(3, 42);
+    ASSERT_EQ(coll.column<PositionColumn3D<1>>()[3].value, 84.0f);
+    ASSERT_EQ(coll.column<PositionColumn3D<1>>()[42].value, 6.0f);
+
+    ParticleCollection copy(coll);
+    MovementColumns3D copied_columns(copy);
+    ASSERT_NE(copied_columns.position_x, columns.position_x);
+    for (size_t i = 0; i < copy.size(); i++)
+    {
+        ASSERT_EQ(copied_columns.position(i), columns.position(i));
+        ASSERT_EQ(copied_columns.velocity(i), columns.velocity(i));
+    }
+}
+
+TEST(ParticleCollection, ComponentGroupsSwapAndCopy)
+{
+    using namespace LibFluid;
+
+    ParticleCollection coll;
+    coll.add_type<ParticleInfo>();
+    // ParticleInfo is already present, hence the remaining components are added on their own
+    coll.add_types<ParticleInfo, ParticleData, MovementData3D>();
+    coll.add_types<ExternalForces3D, PositionColumn3D<0>>();
+    ASSERT_TRUE(coll.is_type_present<ParticleData>());
+    ASSERT_TRUE(coll.is_type_present<MovementData3D>());
+    ASSERT_TRUE(coll.is_type_present<ExternalForces3D>());
+    ASSERT_TRUE(coll.is_type_present<PositionColumn3D<0>>());
+
+    coll.resize(10);
+    for (size_t i = 0; i < coll.size(); i++)
+    {
+        coll.get<ParticleInfo>(i).tag = i;
+        coll.get<ParticleData>(i).mass = i;
+        coll.get<MovementData3D>(i).position = glm::vec3(i);
+        coll.get<ExternalForces3D>(i).non_pressure_acceleration = glm::vec3(i);
+        coll.get<PositionColumn3D<0>>(i).value = i;
+    }
+
+    ParticleCollection copy(coll);
+    copy.swap(2, 7);
+
+    auto check = [](ParticleCollection& c, size_t i, float expected) {
+        ASSERT_EQ(c.get<ParticleInfo>(i).tag, (uint32_t)expected);
+        ASSERT_EQ(c.get<ParticleData>(i).mass, expected);
+        ASSERT_EQ(c.get<MovementData3D>(i).position, glm::vec3(expected));
+        ASSERT_EQ(c.get<ExternalForces3D>(i).non_pressure_acceleration, glm::vec3(expected));
+        ASSERT_EQ(c.get<PositionColumn3D<0>>(i).value, expected);
+    };
+
+    check(copy, 2, 7.0f);
+    check(copy, 7, 2.0f);
+    check(coll, 2, 2.0f);
+    check(coll, 7, 7.0f);
+
+    copy.add();
+    ASSERT_EQ(copy.size(), 11);
+    check(copy, 9, 9.0f);
+}
+
+TEST(ParticleCollection, TypeIndicesFollowSwap)
+{
+    using namespace LibFluid;
+
+    ParticleCollection coll;
+    coll.add_type<ParticleInfo>();
+    coll.resize(9);
+    for (size_t i = 0; i < coll.size(); i++)
+    {
+        coll.get<ParticleInfo>(i).type = i % 3 == 0 ? ParticleTypeBoundary : ParticleTypeNormal;
+    }
+    coll.get<ParticleInfo>(4).type = ParticleTypeInactive;
+
+    ParticleTypeIndices indices;
+    indices.update(coll);
+    ASSERT_EQ(indices.fluid(), std::vector<uint32_t>({1, 2, 5, 7, 8}));
+    ASSERT_EQ(indices.boundary(), std::vector<uint32_t>({0, 3, 6}));
+    ASSERT_EQ(indices.inactive(), std::vector<uint32_t>({4}));
+
+    coll.swap(0, 8);
+    indices.update(coll);
+    ASSERT_EQ(indices.fluid(), std::vector<uint32_t>({0, 1, 2, 5, 7}));
+    ASSERT_EQ(indices.boundary(), std::vector<uint32_t>({3, 6, 8}));
+}
+
+TEST(ParticleCollection, BoundaryChangeDetectorReportsBoundaryChanges)
+{
+    using namespace LibFluid;
+
+    ParticleCollection coll;
+    coll.add_types<ParticleInfo, MovementData3D>();
+    coll.resize(10);
+    for (size_t i = 0; i < coll.size(); i++)
+    {
+        coll.get<ParticleInfo>(i).type = i < 5 ? ParticleTypeBoundary : ParticleTypeNormal;
+        coll.get<MovementData3D>(i).position = glm::vec3(i, 0.0f, 0.0f);
+    }
+
+    BoundaryChangeDetector detector;
+    ASSERT_TRUE(detector.update(coll));
+    ASSERT_FALSE(detector.update(coll));
+
+    // fluid particles do not affect the boundary
+    coll.get<MovementData3D>(7).position = glm::vec3(1.0f, 2.0f, 3.0f);
+    ASSERT_FALSE(detector.update(coll));
+
+    coll.get<MovementData3D>(2).position = glm::vec3(1.0f, 2.0f, 3.0f);
+    ASSERT_TRUE(detector.update(coll));
+    ASSERT_FALSE(detector.update(coll));
+
+    coll.swap(0, 1);
+    ASSERT_TRUE(detector.update(coll));
+
+    coll.get<ParticleInfo>(8).type = ParticleTypeBoundary;
+    ASSERT_TRUE(detector.update(coll));
+
+    coll.resize(11);
+    ASSERT_TRUE(detector.update(coll));
+
+    detector.invalidate();
+    ASSERT_TRUE(detector.update(coll));
+    ASSERT_FALSE(detector.update(coll));
+}
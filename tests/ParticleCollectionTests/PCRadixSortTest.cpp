@@ -0,0 +1,175 @@
+#include "fluidSolver/ParticleCollectionAlgorithm.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+TEST(ParticleCollectionAlgorithm, RadixSort1)
+{
+    using namespace LibFluid;
+
+    std::shared_ptr<ParticleCollection> coll = std::make_shared<ParticleCollection>();
+    coll->add_types<ParticleInfo, ParticleData>();
+
+    coll->resize(160000);
+    std::vector<int> tmp(coll->size());
+    std::iota(tmp.begin(), tmp.end(), 0);
+
+    std::mt19937 g(1);
+    std::shuffle(tmp.begin(), tmp.end(), g);
+
+    for (size_t i = 0; i < coll->size(); i++)
+    {
+        coll->get<ParticleInfo>(i).tag = tmp[i];
+        coll->get<ParticleData>(i).mass = tmp[i];
+    }
+
+    ParticleCollectionAlgorithm::Sort sorter;
+    sorter.radix_sort(coll, [](const std::shared_ptr<ParticleCollection>& c, const size_t i) -> uint64_t {
+        // use all bytes of the key
+        return ((uint64_t)c->get<ParticleInfo>(i).tag << 32) | c->get<ParticleInfo>(i).tag;
+    });
+
+    // check if sorted and if all components were moved
+    for (size_t i = 0; i < coll->size(); i++)
+    {
+        ASSERT_EQ(i, coll->get<ParticleInfo>(i).tag);
+        ASSERT_EQ((float)i, coll->get<ParticleData>(i).mass);
+    }
+}
+
+TEST(ParticleCollectionAlgorithm, RadixSortIsStable)
+{
+    using namespace LibFluid;
+
+    std::shared_ptr<ParticleCollection> coll = std::make_shared<ParticleCollection>();
+    coll->add_type<ParticleInfo>();
+
+    coll->resize(100000);
+    std::mt19937 g(2);
+    std::uniform_int_distribution<uint32_t> dist(0, 99);
+    for (size_t i = 0; i < coll->size(); i++)
+    {
+        coll->get<ParticleInfo>(i).tag = i;
+        coll->get<ParticleInfo>(i).type = dist(g);
+    }
+
+    ParticleCollectionAlgorithm::Sort sorter;
+    sorter.radix_sort(coll, [](const std::shared_ptr<ParticleCollection>& c, const size_t i) -> uint64_t {
+        return c->get<ParticleInfo>(i).type;
+    });
+
+    for (size_t i = 1; i < coll->size(); i++)
+    {
+        const auto& previous = coll->get<ParticleInfo>(i - 1);
+        const auto& current = coll->get<ParticleInfo>(i);
+        ASSERT_LE(previous.type, current.type);
+        if (previous.type == current.type)
+        {
+            ASSERT_LT(previous.tag, current.tag);
+        }
+    }
+}
+
+TEST(ParticleCollectionAlgorithm, RadixSortPermutation)
+{
+    using namespace LibFluid;
+
+    std::mt19937_64 g(3);
+    std::vector<uint64_t> keys(50000);
+    for (auto& key : keys)
+    {
+        key = g();
+    }
+
+    auto permutation = ParticleCollectionAlgorithm::Sort::radix_sort_permutation(keys);
+
+    std::vector<uint64_t> expected(keys);
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(permutation.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        ASSERT_EQ(keys[permutation[i]], expected[i]);
+    }
+
+    ASSERT_TRUE(ParticleCollectionAlgorithm::Sort::radix_sort_permutation({}).empty());
+    ASSERT_EQ(ParticleCollectionAlgorithm::Sort::radix_sort_permutation({42}), std::vector<uint32_t>({0}));
+}
+
+TEST(ParticleCollection, Reorder)
+{
+    using namespace LibFluid;
+
+    ParticleCollection coll;
+    coll.add_types<ParticleInfo, MovementData3D>();
+    coll.add_type<ExternalForces3D>();
+    coll.resize(1000);
+    for (size_t i = 0; i < coll.size(); i++)
+    {
+        coll.get<ParticleInfo>(i).tag = i;
+        coll.get<MovementData3D>(i).position = glm::vec3(i);
+        coll.get<ExternalForces3D>(i).non_pressure_acceleration = glm::vec3(i);
+    }
+
+    // reverse the collection
+    std::vector<uint32_t> permutation(coll.size());
+    for (size_t i = 0; i < permutation.size(); i++)
+    {
+        permutation[i] = permutation.size() - 1 - i;
+    }
+    coll.reorder(permutation);
+
+    for (size_t i = 0; i < coll.size(); i++)
+    {
+        float expected = coll.size() - 1 - i;
+        ASSERT_EQ(coll.get<ParticleInfo>(i).tag, (uint32_t)expected);
+        ASSERT_EQ(coll.get<MovementData3D>(i).position, glm::vec3(expected));
+        ASSERT_EQ(coll.get<ExternalForces3D>(i).non_pressure_acceleration, glm::vec3(expected));
+    }
+}
+
+TEST(ParticleCollectionAlgorithm, RadixSortPermutationNearlySorted)
+{
+    using namespace LibFluid;
+
+    // morton like keys with constant upper bytes, that are sorted except for a few local exchanges
+    std::vector<uint64_t> keys(200000);
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        keys[i] = 0x0123000000000000ull + i / 3;
+    }
+    for (size_t i = 0; i + 5 < keys.size(); i += 1000)
+    {
+        std::swap(keys[i], keys[i + 5]);
+    }
+
+    auto permutation = ParticleCollectionAlgorithm::Sort::radix_sort_permutation(keys);
+    for (size_t i = 1; i < keys.size(); i++)
+    {
+        ASSERT_LE(keys[permutation[i - 1]], keys[permutation[i]]);
+        if (keys[permutation[i - 1]] == keys[permutation[i]])
+        {
+            ASSERT_LT(permutation[i - 1], permutation[i]);
+        }
+    }
+
+    // a single key that is far away from its sorted position
+    std::sort(keys.begin(), keys.end());
+    std::rotate(keys.begin(), keys.begin() + 1, keys.end());
+    permutation = ParticleCollectionAlgorithm::Sort::radix_sort_permutation(keys);
+    // the smallest key occurs three times, the moved one is the last of them since the sort is stable
+    ASSERT_EQ(permutation[2], keys.size() - 1);
+    for (size_t i = 1; i < keys.size(); i++)
+    {
+        ASSERT_LE(keys[permutation[i - 1]], keys[permutation[i]]);
+    }
+
+    // sorted keys yield the identity
+    std::sort(keys.begin(), keys.end());
+    permutation = ParticleCollectionAlgorithm::Sort::radix_sort_permutation(keys);
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        ASSERT_EQ(permutation[i], i);
+    }
+}
@@ -0,0 +1,37 @@
+#include "sensors/IisphSensor.hpp"
+
+#include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
+#include "fluidSolver/kernel/Kernel.hpp"
+#include "fluidSolver/kernel/TabulatedCubicSplineKernel3D.hpp"
+#include "fluidSolver/neighborhoodSearch/HashedNeighborhoodSearch3D.hpp"
+#include "fluidSolver/solver/IISPHFluidSolver3D.hpp"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+template<typename T>
+class IisphSensorTests : public ::testing::Test {
+};
+
+using IisphSolverTypes = ::testing::Types<
+        LibFluid::IISPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::HashedNeighborhoodSearch3D>,
+        LibFluid::IISPHFluidSolver3D<LibFluid::TabulatedCubicSplineKernel3D, LibFluid::HashedNeighborhoodSearch3D>,
+        LibFluid::IISPHFluidSolver3D<LibFluid::WendlandC2Kernel3D, LibFluid::HashedNeighborhoodSearch3D>,
+        LibFluid::IISPHFluidSolver3D<LibFluid::WendlandC4Kernel3D, LibFluid::HashedNeighborhoodSearch3D>>;
+TYPED_TEST_SUITE(IisphSensorTests, IisphSolverTypes);
+
+TYPED_TEST(IisphSensorTests, SolverIsCompatible) {
+    auto solver = std::make_shared<TypeParam>();
+    solver->stat_last_iteration_count = 7;
+
+    LibFluid::Sensors::IISPHSensor sensor;
+    sensor.simulator_data.fluid_solver = solver;
+
+    LibFluid::CompatibilityReport report;
+    sensor.create_compatibility_report(report);
+    EXPECT_FALSE(report.has_issues());
+
+    LibFluid::Timepoint timepoint;
+    EXPECT_EQ(sensor.calculate_for_timepoint(timepoint).stat_last_iteration_count, 7);
+}
@@ -0,0 +1,72 @@
+#include "serialization/ParticleSerializer.hpp"
+
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+using namespace LibFluid;
+
+TEST(ParticleSerializerTests, DeserializedComponentsStayTogether) {
+    const char* filename = "ParticleSerializerTests.DeserializedComponentsStayTogether.bin";
+    const size_t particle_count = 5;
+
+    // write a 3d collection
+    {
+        ParticleCollection collection;
+        collection.add_types<MovementData3D, ParticleData, ParticleInfo, ExternalForces3D>();
+        for (size_t i = 0; i < particle_count; i++) {
+            size_t index = collection.add();
+            float value = (float)i;
+            collection.get<MovementData3D>(index) = {glm::vec3(value, 0.0f, 0.0f), glm::vec3(0.0f, value, 0.0f),
+                                                     glm::vec3(0.0f, 0.0f, value)};
+            collection.get<ParticleData>(index) = {value, 2.0f * value, 3.0f * value};
+            collection.get<ParticleInfo>(index) = {(uint32_t)i, (uint8_t)(i % 2)};
+            collection.get<ExternalForces3D>(index).non_pressure_acceleration = glm::vec3(value);
+        }
+
+        Serialization::ParticleSerializer serializer(filename);
+        serializer.serialize(collection);
+    }
+
+    // read it into an empty collection, which has to add all components
+    ParticleCollection collection;
+    {
+        Serialization::ParticleSerializer serializer(filename);
+        serializer.deserialize(collection);
+    }
+
+    // delete temporary file
+    try {
+        std::filesystem::remove(filename);
+    } catch (const std::exception& e) {
+        EXPECT_TRUE(false) << "Could not cleanup temporary files: " << e.what();
+    }
+
+    ASSERT_EQ(collection.size(), particle_count);
+    ASSERT_TRUE(collection.is_type_present<MovementData3D>());
+    ASSERT_TRUE(collection.is_type_present<ParticleData>());
+    ASSERT_TRUE(collection.is_type_present<ParticleInfo>());
+    ASSERT_TRUE(collection.is_type_present<ExternalForces3D>());
+    EXPECT_FALSE(collection.is_type_present<MovementData>());
+    EXPECT_FALSE(collection.is_type_present<ExternalForces>());
+
+    // swapping and adding has to move all components of the particles
+    collection.swap(0, particle_count - 1);
+    size_t added = collection.add();
+    EXPECT_EQ(collection.size(), particle_count + 1);
+    collection.get<ParticleInfo>(added).tag = (uint32_t)particle_count;
+
+    for (size_t i = 0; i < particle_count; i++) {
+        uint32_t tag = collection.get<ParticleInfo>(i).tag;
+        float value = (float)tag;
+        EXPECT_EQ(collection.get<ParticleInfo>(i).type, tag % 2);
+        EXPECT_FLOAT_EQ(collection.get<MovementData3D>(i).position.x, value);
+        EXPECT_FLOAT_EQ(collection.get<MovementData3D>(i).velocity.y, value);
+        EXPECT_FLOAT_EQ(collection.get<MovementData3D>(i).acceleration.z, value);
+        EXPECT_FLOAT_EQ(collection.get<ParticleData>(i).mass, value);
+        EXPECT_FLOAT_EQ(collection.get<ParticleData>(i).pressure, 2.0f * value);
+        EXPECT_FLOAT_EQ(collection.get<ParticleData>(i).density, 3.0f * value);
+        EXPECT_FLOAT_EQ(collection.get<ExternalForces3D>(i).non_pressure_acceleration.z, value);
+    }
+    EXPECT_EQ(collection.get<ParticleInfo>(0).tag, particle_count - 1);
+}
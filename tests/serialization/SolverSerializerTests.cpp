@@ -0,0 +1,123 @@
+#include "serialization/serializers/SolverSerializer.hpp"
+
+#include "fluidSolver/kernel/CubicSplineKernel3D.hpp"
+#include "fluidSolver/neighborhoodSearch/HashedNeighborhoodSearch3D.hpp"
+#include "fluidSolver/neighborhoodSearch/VerletNeighborhoodSearch.hpp"
+#include "fluidSolver/solver/DFSPHFluidSolver3D.hpp"
+#include "fluidSolver/solver/IISPHFluidSolver3D.hpp"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+using DFSPHSolver = LibFluid::DFSPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::HashedNeighborhoodSearch3D>;
+
+static std::shared_ptr<DFSPHSolver> serialize_and_deserialize(const std::shared_ptr<DFSPHSolver>& solver) {
+    LibFluid::Serialization::SerializationContext context;
+    LibFluid::Serialization::SerializerExtensions extensions;
+    LibFluid::Serialization::SolverSerializer serializer(context, extensions);
+
+    auto node = serializer.serialize(solver);
+    EXPECT_EQ(node["type"].get<std::string>(), "dfsph-3d");
+
+    auto result = std::dynamic_pointer_cast<DFSPHSolver>(serializer.deserialize(node));
+    EXPECT_TRUE(context.issues.empty());
+    return result;
+}
+
+TEST(SolverSerializerTests, DFSPHSettingsRoundTrip) {
+    auto solver = std::make_shared<DFSPHSolver>();
+    solver->settings.max_density_error_allowed = 0.0025f;
+    solver->settings.min_number_of_iterations = 3;
+    solver->settings.max_number_of_iterations = 42;
+    solver->settings.divergence_solve = true;
+    solver->settings.max_divergence_error_allowed = 0.05f;
+    solver->settings.min_number_of_divergence_iterations = 2;
+    solver->settings.max_number_of_divergence_iterations = 17;
+    solver->settings.viscosity = 3.5f;
+
+    auto result = serialize_and_deserialize(solver);
+    ASSERT_NE(result, nullptr);
+
+    EXPECT_FLOAT_EQ(result->settings.max_density_error_allowed, 0.0025f);
+    EXPECT_EQ(result->settings.min_number_of_iterations, 3);
+    EXPECT_EQ(result->settings.max_number_of_iterations, 42);
+    EXPECT_TRUE(result->settings.divergence_solve);
+    EXPECT_FLOAT_EQ(result->settings.max_divergence_error_allowed, 0.05f);
+    EXPECT_EQ(result->settings.min_number_of_divergence_iterations, 2);
+    EXPECT_EQ(result->settings.max_number_of_divergence_iterations, 17);
+    EXPECT_FLOAT_EQ(result->settings.viscosity, 3.5f);
+}
+
+TEST(SolverSerializerTests, DFSPHSettingsWithoutDivergenceSolveRoundTrip) {
+    auto solver = std::make_shared<DFSPHSolver>();
+    solver->settings.divergence_solve = false;
+    solver->settings.max_density_error_allowed = 0.004f;
+
+    auto result = serialize_and_deserialize(solver);
+    ASSERT_NE(result, nullptr);
+
+    EXPECT_FALSE(result->settings.divergence_solve);
+    EXPECT_FLOAT_EQ(result->settings.max_density_error_allowed, 0.004f);
+}
+
+TEST(SolverSerializerTests, VerletSkinFactorRoundTrip) {
+    using VerletSolver = LibFluid::IISPHFluidSolver3D<LibFluid::CubicSplineKernel3D,
+            LibFluid::VerletNeighborhoodSearch<LibFluid::HashedNeighborhoodSearch3D>>;
+
+    auto solver = std::make_shared<VerletSolver>();
+    solver->neighborhood_search.skin_factor = 0.35f;
+
+    LibFluid::Serialization::SerializationContext context;
+    LibFluid::Serialization::SerializerExtensions extensions;
+    LibFluid::Serialization::SolverSerializer serializer(context, extensions);
+
+    auto node = serializer.serialize(solver);
+    EXPECT_EQ(node["neighborhood-search"]["type"].get<std::string>(), "verlet-hashed-3d");
+
+    auto result = std::dynamic_pointer_cast<VerletSolver>(serializer.deserialize(node));
+    ASSERT_NE(result, nullptr);
+    EXPECT_TRUE(context.issues.empty());
+    EXPECT_FLOAT_EQ(result->neighborhood_search.skin_factor, 0.35f);
+
+    // scenarios saved without the skin factor keep the default value
+    node["neighborhood-search"].erase("skin-factor");
+    result = std::dynamic_pointer_cast<VerletSolver>(serializer.deserialize(node));
+    ASSERT_NE(result, nullptr);
+    EXPECT_FLOAT_EQ(result->neighborhood_search.skin_factor, VerletSolver().neighborhood_search.skin_factor);
+}
+
+TEST(SolverSerializerTests, IISPHWarmStartSettingsRoundTrip) {
+    using IISPHSolver = LibFluid::IISPHFluidSolver3D<LibFluid::CubicSplineKernel3D, LibFluid::HashedNeighborhoodSearch3D>;
+
+    auto solver = std::make_shared<IISPHSolver>();
+    solver->settings.warm_start_pressure = true;
+    solver->settings.warm_start_pressure_factor = 0.3f;
+
+    LibFluid::Serialization::SerializationContext context;
+    LibFluid::Serialization::SerializerExtensions extensions;
+    LibFluid::Serialization::SolverSerializer serializer(context, extensions);
+
+    auto node = serializer.serialize(solver);
+    EXPECT_EQ(node["type"].get<std::string>(), "iisph-3d");
+
+    auto result = std::dynamic_pointer_cast<IISPHSolver>(serializer.deserialize(node));
+    ASSERT_NE(result, nullptr);
+    EXPECT_TRUE(context.issues.empty());
+    EXPECT_TRUE(result->settings.warm_start_pressure);
+    EXPECT_FLOAT_EQ(result->settings.warm_start_pressure_factor, 0.3f);
+
+    // a disabled warm start does not store the factor, which keeps its default value
+    solver->settings.warm_start_pressure = false;
+    node = serializer.serialize(solver);
+    result = std::dynamic_pointer_cast<IISPHSolver>(serializer.deserialize(node));
+    ASSERT_NE(result, nullptr);
+    EXPECT_FALSE(result->settings.warm_start_pressure);
+    EXPECT_FLOAT_EQ(result->settings.warm_start_pressure_factor, IISPHSolver().settings.warm_start_pressure_factor);
+
+    // scenarios saved before the warm start was added keep it disabled
+    node.erase("warm-start-pressure-enabled");
+    result = std::dynamic_pointer_cast<IISPHSolver>(serializer.deserialize(node));
+    ASSERT_NE(result, nullptr);
+    EXPECT_FALSE(result->settings.warm_start_pressure);
+}